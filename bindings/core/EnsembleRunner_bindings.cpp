@@ -0,0 +1,43 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <core/EnsembleRunner.hpp>
+
+namespace py = pybind11;
+
+void init_EnsembleRunner(py::module &m) {
+    py::class_<RunSummary>(m, "RunSummary")
+        .def_readonly("organisms", &RunSummary::organisms)
+        .def_readonly("foods", &RunSummary::foods)
+        .def_readonly("dead_organisms", &RunSummary::deadOrganisms)
+        .def_readonly("food_consumption", &RunSummary::foodConsumption)
+        .def_readonly("species", &RunSummary::species)
+        .def_readonly("mean_life_span", &RunSummary::meanLifeSpan)
+        .def_readonly("mean_speed", &RunSummary::meanSpeed)
+        .def_readonly("mean_size", &RunSummary::meanSize)
+        .def_readonly("mean_awareness", &RunSummary::meanAwareness)
+        .def_readonly("elapsed_ms", &RunSummary::elapsedMs)
+        .def("__repr__", [](const RunSummary &summary) {
+            return "<RunSummary organisms=" + std::to_string(summary.organisms) +
+                   " foods=" + std::to_string(summary.foods) +
+                   " food_consumption=" + std::to_string(summary.foodConsumption) + ">";
+        });
+
+    py::class_<EnsembleRunner>(m, "EnsembleRunner")
+        .def(py::init<int>(), py::arg("threads") = 0,
+             "Advance many independent environments in parallel. threads=0 uses all cores. "
+             "Build the environments with threads=1 to avoid oversubscription.")
+        .def("add", &EnsembleRunner::add, py::arg("environment"),
+             "Add an environment; returns its index in run() results.")
+        .def("get", &EnsembleRunner::get, py::arg("index"))
+        .def("__len__", &EnsembleRunner::size)
+        .def("get_num_threads", &EnsembleRunner::getNumThreads)
+        .def("clear", &EnsembleRunner::clear)
+        // Python strategies, if any, take the GIL themselves from the worker threads
+        .def("run", &EnsembleRunner::run, py::arg("iterations"),
+             py::call_guard<py::gil_scoped_release>(),
+             "Simulate every environment for the given iterations with the GIL released. "
+             "Returns one RunSummary per environment, in insertion order.")
+        .def_static("summarise", &EnsembleRunner::summarise, py::arg("environment"),
+                    "Summarise the current state of one environment.");
+}
@@ -15,10 +15,16 @@ public:
 };
 
 void init_EnvironmentObject(py::module &m) {
+    py::enum_<ObjectKind>(m, "ObjectKind")
+        .value("ORGANISM", ObjectKind::ORGANISM)
+        .value("FOOD", ObjectKind::FOOD)
+        .value("CUSTOM", ObjectKind::CUSTOM);
+
     py::class_<EnvironmentObject, PyEnvironmentObject, std::shared_ptr<EnvironmentObject>>(m, "EnvironmentObject")
         .def(py::init<float, float>())
         .def("get_position", &EnvironmentObject::getPosition)
         .def("get_id", &EnvironmentObject::getId)
+        .def("get_kind", &EnvironmentObject::getKind)
         .def("set_position", &EnvironmentObject::setPosition)
         .def("post_iteration", &EnvironmentObject::postIteration);
 }
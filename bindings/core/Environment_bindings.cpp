@@ -1,18 +1,269 @@
 #include <pybind11/complex.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <algorithm>
 #include <core/Environment.hpp>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "ProfiledGil.hpp"
 
 namespace py = pybind11;
 
+template <typename T>
+using ContiguousArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+// View a 1-D (or flattened) NumPy buffer as a span without copying
+template <typename T>
+static std::span<const T> asSpan(const ContiguousArray<T>& array) {
+    return {array.data(), static_cast<std::size_t>(array.size())};
+}
+
+// Read-only NumPy view into a column of an immutable EnvironmentState. The
+// owner capsule holds a reference to the state, so the view outlives any
+// later mutation of the environment.
+template <typename T>
+static py::array stateView(const py::capsule& owner, const T* data,
+                           std::vector<py::ssize_t> shape, std::vector<py::ssize_t> strides) {
+    py::array_t<T> view(std::move(shape), std::move(strides), data, owner);
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+static py::dict stateToDict(std::shared_ptr<const EnvironmentState> state) {
+    const auto n = static_cast<py::ssize_t>(state->size());
+    const py::ssize_t f = sizeof(float);
+    const py::ssize_t traitStride = EnvironmentState::TRAIT_COUNT * f;
+    const float* traits = state->traits.data();
+    py::capsule owner(new std::shared_ptr<const EnvironmentState>(state), [](void* holder) {
+        delete static_cast<std::shared_ptr<const EnvironmentState>*>(holder);
+    });
+
+    py::dict views;
+    views["version"] = state->version;
+    views["organism_count"] = state->organismCount;
+    views["food_count"] = state->foodCount;
+    views["positions"] = stateView(owner, state->positions.data(), {n, 2}, {2 * f, f});
+    views["kind"] = stateView(owner, state->kinds.data(), {n}, {1});
+    views["alive"] = stateView(owner, state->alive.data(), {n}, {1});
+    views["life_span"] = stateView(owner, state->lifeSpans.data(), {n}, {f});
+    views["energy"] = stateView(owner, state->energies.data(), {n}, {f});
+    views["species"] =
+        stateView(owner, state->species.data(), {n}, {sizeof(std::uint16_t)});
+    views["traits"] = stateView(owner, traits, {n, EnvironmentState::TRAIT_COUNT}, {traitStride, f});
+    // Strided columns of traits, still without copying
+    views["speed"] = stateView(owner, traits, {n}, {traitStride});
+    views["size"] = stateView(owner, traits ? traits + 1 : traits, {n}, {traitStride});
+    views["awareness"] = stateView(owner, traits ? traits + 2 : traits, {n}, {traitStride});
+    return views;
+}
+
+static py::dict statsToDict(const PopulationStats& stats) {
+    const char* names[PopulationStats::TRAIT_COUNT] = {"speed", "size", "awareness"};
+    py::array_t<std::uint32_t> histograms(std::vector<py::ssize_t>{
+        PopulationStats::TRAIT_COUNT, PopulationStats::HISTOGRAM_BINS});
+    auto bins = histograms.mutable_unchecked<2>();
+    py::dict means, variances;
+    for (int t = 0; t < PopulationStats::TRAIT_COUNT; t++) {
+        auto trait = static_cast<PopulationStats::Trait>(t);
+        means[names[t]] = stats.getMean(trait);
+        variances[names[t]] = stats.getVariance(trait);
+        const auto& histogram = stats.getHistogram(trait);
+        for (int b = 0; b < PopulationStats::HISTOGRAM_BINS; b++) bins(t, b) = histogram[b];
+    }
+    py::array_t<float> edges(PopulationStats::HISTOGRAM_BINS + 1);
+    auto edge = edges.mutable_unchecked<1>();
+    for (int b = 0; b <= PopulationStats::HISTOGRAM_BINS; b++) {
+        edge(b) = PopulationStats::TRAIT_MAX * b / PopulationStats::HISTOGRAM_BINS;
+    }
+
+    py::dict result;
+    result["organisms"] = stats.getOrganismCount();
+    result["foods"] = stats.getFoodCount();
+    result["mean"] = means;
+    result["variance"] = variances;
+    result["histograms"] = histograms;
+    result["bin_edges"] = edges;
+    return result;
+}
+
+static py::dict profileToDict(const SimulationProfile& profile) {
+    py::dict zones;
+    for (const auto& zone : profile.zones) {
+        py::dict entry;
+        entry["count"] = zone.count;
+        entry["total_ms"] = zone.totalMs;
+        entry["mean_ms"] = zone.meanMs;
+        entry["p50_ms"] = zone.p50Ms;
+        entry["p95_ms"] = zone.p95Ms;
+        entry["p99_ms"] = zone.p99Ms;
+        entry["max_ms"] = zone.maxMs;
+        if (!zone.counters.empty()) {
+            py::dict counters;
+            for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+                const auto event = static_cast<PerfEvent>(e);
+                if (zone.counters.has(event)) counters[perfEventName(event)] = zone.counters[event];
+            }
+            entry["counters"] = counters;
+        }
+        zones[py::str(zone.name)] = entry;
+    }
+    py::list strategies;
+    for (const auto& strategy : profile.strategies) {
+        py::dict entry;
+        entry["policy"] = strategy.policy;
+        entry["species"] = strategy.hasSpecies ? py::object(py::int_(strategy.species)) : py::none();
+        entry["call"] = strategyCallName(strategy.call);
+        entry["implementation"] = strategyImplementationName(strategy.implementation);
+        entry["calls"] = strategy.calls;
+        entry["neighbours"] = strategy.neighbours;
+        entry["total_ms"] = strategy.totalMs;
+        entry["mean_us"] = strategy.meanUs;
+        entry["gil_wait_ms"] = strategy.gilWaitMs;
+        strategies.append(entry);
+    }
+    py::array_t<std::uint64_t> perQuery(QueryTally::BUCKETS);
+    std::copy(profile.neighboursPerQuery.begin(), profile.neighboursPerQuery.end(),
+              perQuery.mutable_data());
+
+    py::dict result;
+    result["ticks"] = profile.ticks;
+    result["zones"] = zones;
+    result["queries"] = profile.queries;
+    result["neighbours"] = profile.neighbours;
+    result["neighbours_per_query"] = perQuery;
+    result["organisms_interacted"] = profile.organismsInteracted;
+    result["organisms_reacted"] = profile.organismsReacted;
+    result["index_updates"] = profile.indexUpdates;
+    result["objects_removed"] = profile.objectsRemoved;
+    result["strategies"] = strategies;
+    return result;
+}
+
+static py::dict historyToDict(const std::vector<PopulationStats::TickSample>& samples) {
+    const auto n = static_cast<py::ssize_t>(samples.size());
+    py::array_t<std::uint64_t> tick(n);
+    py::array_t<std::uint32_t> organisms(n), foods(n);
+    py::array_t<float> lifeSpan(n), speed(n), size(n), awareness(n);
+    for (py::ssize_t i = 0; i < n; i++) {
+        const auto& sample = samples[i];
+        tick.mutable_at(i) = sample.tick;
+        organisms.mutable_at(i) = sample.organisms;
+        foods.mutable_at(i) = sample.foods;
+        lifeSpan.mutable_at(i) = sample.meanLifeSpan;
+        speed.mutable_at(i) = sample.meanSpeed;
+        size.mutable_at(i) = sample.meanSize;
+        awareness.mutable_at(i) = sample.meanAwareness;
+    }
+    py::dict result;
+    result["tick"] = tick;
+    result["organisms"] = organisms;
+    result["foods"] = foods;
+    result["mean_life_span"] = lifeSpan;
+    result["mean_speed"] = speed;
+    result["mean_size"] = size;
+    result["mean_awareness"] = awareness;
+    return result;
+}
+
+// Policies by saved species id, for Environment::loadSnapshot/decodeSnapshot
+using PolicyList = std::vector<std::shared_ptr<Organism::Policy>>;
+
+static std::vector<std::shared_ptr<const Organism::Policy>> toPolicyTable(const PolicyList& list) {
+    return {list.begin(), list.end()};
+}
+
+// Run a simulation call with the GIL released when no Python code can run
+// inside it; callbacks passed in re-acquire the GIL themselves
+template <typename F>
+static void runWithoutGil(const Environment& env, F&& run) {
+    if (env.requiresGil()) {
+        run();
+        return;
+    }
+    py::gil_scoped_release release;
+    run();
+}
+
+// Hand a Raster to NumPy, either as float planes or composited RGBA pixels
+static py::array rasterToArray(Raster raster, bool rgba) {
+    const py::ssize_t h = raster.height, w = raster.width;
+    if (rgba) {
+        auto pixels = raster.toRGBA();
+        py::array_t<std::uint8_t> image({h, w, py::ssize_t{4}});
+        std::copy(pixels.begin(), pixels.end(), image.mutable_data());
+        return image;
+    }
+    auto* data = new std::vector<float>(std::move(raster.data));
+    py::capsule owner(data, [](void* holder) { delete static_cast<std::vector<float>*>(holder); });
+    const py::ssize_t f = sizeof(float);
+    return py::array_t<float>({static_cast<py::ssize_t>(raster.layers.size()), h, w},
+                              {h * w * f, w * f, f}, data->data(), owner);
+}
+
 void init_Environment(py::module& m) {
+    py::enum_<RenderLayer>(m, "RenderLayer")
+        .value("ORGANISMS", RenderLayer::ORGANISMS)
+        .value("FOOD", RenderLayer::FOOD)
+        .value("SIZE", RenderLayer::SIZE)
+        .value("AWARENESS", RenderLayer::AWARENESS);
+
+    py::class_<FoodRegion>(m, "FoodRegion")
+        .def(py::init([](float x0, float y0, float x1, float y1, std::size_t count) {
+                 return FoodRegion{x0, y0, x1, y1, count};
+             }),
+             py::arg("x0"), py::arg("y0"), py::arg("x1"), py::arg("y1"), py::arg("count"),
+             "Rectangle [x0, x1) x [y0, y1) receiving count foods per generation.")
+        .def_readwrite("x0", &FoodRegion::x0)
+        .def_readwrite("y0", &FoodRegion::y0)
+        .def_readwrite("x1", &FoodRegion::x1)
+        .def_readwrite("y1", &FoodRegion::y1)
+        .def_readwrite("count", &FoodRegion::count);
+
+    py::class_<GenerationPolicy>(m, "GenerationPolicy")
+        .def(py::init([](std::vector<FoodRegion> foodRegions, int foodEnergy, bool reproduce,
+                         float reproductionThreshold, std::size_t maxPopulation,
+                         bool resetFood) {
+                 return GenerationPolicy{std::move(foodRegions), foodEnergy, reproduce,
+                                         reproductionThreshold, maxPopulation, resetFood};
+             }),
+             py::arg("food_regions") = std::vector<FoodRegion>{}, py::arg("food_energy") = 500,
+             py::arg("reproduce") = true, py::arg("reproduction_threshold") = 1000.0f,
+             py::arg("max_population") = 0, py::arg("reset_food") = true)
+        .def_readwrite("food_regions", &GenerationPolicy::foodRegions)
+        .def_readwrite("food_energy", &GenerationPolicy::foodEnergy)
+        .def_readwrite("reproduce", &GenerationPolicy::reproduce)
+        .def_readwrite("reproduction_threshold", &GenerationPolicy::reproductionThreshold)
+        .def_readwrite("max_population", &GenerationPolicy::maxPopulation)
+        .def_readwrite("reset_food", &GenerationPolicy::resetFood);
+
     py::class_<Environment, std::shared_ptr<Environment>>(m, "Environment")
         .def(py::init<int, int, std::string, int>(), py::arg("width"), py::arg("height"),
             py::arg("type") = "default", py::arg("threads") = 1,
              "Constructor for Environment class taking width, height, and an optional type.")
+        .def(py::pickle(
+            [](const Environment& self) {
+                // Unpickling has no way to get policies back; fail instead of dropping them
+                if (!self.isSnapshotSelfContained()) {
+                    throw py::type_error(
+                        "cannot pickle an Environment whose organisms have custom policies or "
+                        "mutation functions; use save_snapshot() and "
+                        "load_snapshot(path, policies=...) instead");
+                }
+                return py::bytes(self.encodeSnapshot());
+            },
+            [](const py::bytes& state) {
+                auto env = std::make_shared<Environment>(1, 1);
+                std::string_view bytes = state;
+                env->decodeSnapshot(bytes);
+                return env;
+            }))
         .def("get_width", &Environment::getWidth, "Get the width of the environment.")
         .def("get_height", &Environment::getHeight, "Get the height of the environment.")
         .def("add_organism",
@@ -40,15 +291,196 @@ void init_Environment(py::module& m) {
              static_cast<void (Environment::*)(const std::shared_ptr<EnvironmentObject>&)>(
                  &Environment::remove),
              py::arg("object"), "Remove a custom EnvironmentObject from the environment.")
+        .def(
+            "add_foods",
+            [](Environment& self, ContiguousArray<float> xs, ContiguousArray<float> ys,
+               std::optional<ContiguousArray<int>> energies) {
+                std::span<const int> energySpan;
+                if (energies) energySpan = asSpan(*energies);
+                self.addFoods(asSpan(xs), asSpan(ys), energySpan);
+            },
+            py::arg("xs"), py::arg("ys"), py::arg("energies") = py::none(),
+            "Add len(xs) foods in one call from NumPy arrays (or sequences). energies "
+            "defaults to 500 each. Nothing is added if any position is out of bounds.")
+        .def(
+            "add_organisms",
+            [](Environment& self, ContiguousArray<std::uint8_t> dna, ContiguousArray<float> xs,
+               ContiguousArray<float> ys, std::shared_ptr<Organism::Policy> policy) {
+                if (dna.ndim() != 2 || dna.shape(1) != 4) {
+                    throw std::invalid_argument("dna must be an (N, 4) uint8 array.");
+                }
+                self.addOrganisms(asSpan(dna), asSpan(xs), asSpan(ys), std::move(policy));
+            },
+            py::arg("dna"), py::arg("xs"), py::arg("ys"), py::arg("policy") = nullptr,
+            "Add N organisms in one call. dna is an (N, 4) uint8 array, one DNA row per "
+            "organism; all share policy (default behaviour if None).")
+        .def("remove_all_foods", &Environment::removeAllFoods,
+             "Remove every food item, rebuilding the spatial index once.")
+        .def(
+            "remove_where",
+            [](Environment& self, std::optional<ObjectKind> kind, py::object predicate) {
+                if (predicate.is_none()) {
+                    if (!kind) throw std::invalid_argument("remove_where needs a kind or a predicate.");
+                    return self.removeKind(*kind);
+                }
+                // Hand Python the shared object so subclasses keep their type
+                return self.removeWhere([&](const EnvironmentObject& object) {
+                    if (kind && object.getKind() != *kind) return false;
+                    return predicate(py::cast(&object, py::return_value_policy::reference))
+                        .cast<bool>();
+                });
+            },
+            py::arg("kind") = py::none(), py::arg("predicate") = py::none(),
+            "Remove every object of the given kind and/or for which predicate(obj) is true, "
+            "rebuilding the spatial index once. Returns the number removed. Removed organisms "
+            "are not recorded as dead.")
+        .def(
+            "state", [](const Environment& self) { return stateToDict(self.getState()); },
+            "Column-oriented snapshot of every object as read-only, zero-copy NumPy arrays: "
+            "positions (N, 2), kind, alive, life_span, energy, species, traits (N, 3) and the "
+            "speed / size / awareness columns. Organisms occupy rows [0, organism_count), "
+            "food the next food_count rows. The snapshot is shared until the environment "
+            "next changes and stays valid afterwards.")
+        .def(
+            "clone",
+            [](const Environment& self) { return std::shared_ptr<Environment>(self.clone()); },
+            "Fork an independent copy (same object ids, copied spatial index, shared "
+            "policies). Faster than pickling or rebuilding; use it to branch experiments.")
+        .def(
+            "__deepcopy__",
+            [](const Environment& self, py::dict) {
+                return std::shared_ptr<Environment>(self.clone());
+            },
+            py::arg("memo"))
+        .def("set_recorder", &Environment::setRecorder, py::arg("recorder"),
+             "Attach a TrajectoryRecorder fed after every tick, or None to detach.")
+        .def("get_recorder", &Environment::getRecorder, "The attached TrajectoryRecorder or None.")
+        .def("set_live_feed", &Environment::setLiveFeed, py::arg("feed"),
+             "Attach a LiveFeed published after every tick, or None to detach.")
+        .def("get_live_feed", &Environment::getLiveFeed, "The attached LiveFeed or None.")
+        .def("set_tracing", &Environment::setTracing, py::arg("capacity") = 65536,
+             "Record a timeline of the following runs: spans for every tick, phase, reaction "
+             "worker, index rebuild, callback and GIL wait, keeping the newest capacity spans. "
+             "capacity=0 stops tracing.")
+        .def(
+            "is_tracing", [](const Environment& self) { return self.getTrace() != nullptr; },
+            "Whether a timeline is being recorded.")
+        .def("dump_trace", &Environment::dumpTrace, py::arg("path"),
+             "Write the recorded timeline as Chrome trace-event JSON, viewable in "
+             "chrome://tracing or ui.perfetto.dev. Raises RuntimeError if tracing is off.")
+        .def(
+            "get_profile", [](const Environment& self) { return profileToDict(self.getProfile()); },
+            "Cumulative profile since construction or reset_profile(): ticks, per-zone "
+            "timings (zones: name -> count, total_ms, mean_ms, p50_ms, p95_ms, p99_ms, max_ms), "
+            "neighbour queries with neighbours_per_query bucketed by powers of two (bucket 0 "
+            "counts empty results, bucket b counts [2**(b-1), 2**b)), objects processed, and "
+            "strategies: one dict per policy and call (reaction, batchReaction, interaction) "
+            "with its implementation, calls, neighbours, total_ms, mean_us and gil_wait_ms. "
+            "policy is a serial that stays fixed until reset_profile(); species is the current "
+            "Organism.get_species_id() of the policy, or None once no organism uses it.")
+        .def("reset_profile", &Environment::resetProfile, "Zero every counter of get_profile().")
+        .def("set_hardware_counters", &Environment::setHardwareCounters, py::arg("enabled") = true,
+             "Count cycles, instructions, L1d/LLC misses and branch misses around each phase "
+             "of the following runs, reported as zones[name]['counters'] in get_profile(). "
+             "Returns False when the system provides no counters (then runs are unaffected).")
+        .def("save_snapshot", &Environment::saveSnapshot, py::arg("path"),
+             "Write the full simulation state (objects, dead organisms, counters, RNG) to a "
+             "versioned binary file. Policies are code and are not saved.")
+        .def(
+            "load_snapshot",
+            [](Environment& self, const std::string& path, const PolicyList& policies) {
+                self.loadSnapshot(path, toPolicyTable(policies));
+            },
+            py::arg("path"), py::arg("policies") = PolicyList{},
+            "Replace this environment with a snapshot file (memory-mapped). policies[i] is "
+            "re-attached to organisms saved with species id i; others get the default policy.")
+        .def("get_version", &Environment::getVersion,
+             "Counter bumped whenever the environment changes.")
+        .def(
+            "stats", [](const Environment& self) { return statsToDict(self.getStats()); },
+            "Population statistics maintained incrementally as objects come and go: counts, "
+            "per-trait mean and variance (dicts keyed by speed / size / awareness), "
+            "histograms (3, 32) over bin_edges. Costs O(1) regardless of population size.")
+        .def(
+            "history",
+            [](const Environment& self) { return historyToDict(self.getStats().getHistory()); },
+            "Per-tick samples (tick, organisms, foods, mean_life_span, mean_speed, mean_size, "
+            "mean_awareness) as NumPy arrays, oldest first, bounded by the history capacity.")
+        .def("set_history_capacity", &Environment::setStatsHistoryCapacity, py::arg("capacity"),
+             "Resize the per-tick history ring buffer, dropping recorded samples.")
+        .def("get_tick_count", &Environment::getTickCount,
+             "Number of ticks simulated since construction.")
+        .def(
+            "render",
+            [](const Environment& self, int width, int height, std::vector<RenderLayer> layers,
+               int threads, bool rgba) {
+                Raster raster;
+                runWithoutGil(self, [&]() { raster = self.render(width, height, layers, threads); });
+                return rasterToArray(std::move(raster), rgba);
+            },
+            py::arg("width"), py::arg("height"),
+            py::arg("layers") = std::vector<RenderLayer>{RenderLayer::ORGANISMS, RenderLayer::FOOD},
+            py::arg("threads") = 1, py::arg("rgba") = false,
+            "Rasterise the environment into a float32 (layers, height, width) array of "
+            "per-pixel counts, row 0 at y = 0; with rgba=True, a uint8 (height, width, 4) image "
+            "instead. threads=0 uses all cores. The GIL is released while drawing.")
         .def("reset", &Environment::reset, "Reset the environment.")
         .def("get_all_objects", &Environment::getAllObjects, "Get all objects in the environment.")
         .def("get_all_organisms", &Environment::getAllOrganisms,
              "Get all organisms in the environment.")
         .def("get_all_foods", &Environment::getAllFoods, "Get all food in the environment.")
-        .def("simulate_iteration", &Environment::simulateIteration, py::arg("iterations"),
-             py::arg("on_each_iteration") = nullptr)
+        .def(
+            "simulate_iteration",
+            [](Environment& self, int iterations, py::object onEachIteration) {
+                std::function<void(const Environment&)> callback;
+                if (!onEachIteration.is_none()) {
+                    callback = [&onEachIteration](const Environment& env) {
+                        ProfiledGilAcquire gil;
+                        onEachIteration(py::cast(&env, py::return_value_policy::reference));
+                    };
+                }
+                runWithoutGil(self, [&]() { self.simulateIteration(iterations, callback); });
+            },
+            py::arg("iterations"), py::arg("on_each_iteration") = py::none(),
+            "Run the simulation. The GIL is released for the whole run unless an organism "
+            "uses a Python strategy or a Python EnvironmentObject subclass is present; "
+            "on_each_iteration(env) is called with the GIL held.")
+        .def(
+            "simulate_generations",
+            [](Environment& self, int generations, int iterationsPerGeneration,
+               const GenerationPolicy& policy, py::object onEachGeneration) {
+                std::function<void(const Environment&, int)> callback;
+                if (!onEachGeneration.is_none()) {
+                    callback = [&onEachGeneration](const Environment& env, int generation) {
+                        ProfiledGilAcquire gil;
+                        onEachGeneration(py::cast(&env, py::return_value_policy::reference),
+                                         generation);
+                    };
+                }
+                runWithoutGil(self, [&]() {
+                    self.simulateGenerations(generations, iterationsPerGeneration, policy,
+                                             callback);
+                });
+            },
+            py::arg("generations"), py::arg("iterations_per_generation"), py::arg("policy"),
+            py::arg("on_each_generation") = py::none(),
+            "Run whole generations in C++: spawn food per policy.food_regions, simulate, call "
+            "on_each_generation(env, generation), reproduce organisms above the threshold and "
+            "remove uneaten food. Releases the GIL like simulate_iteration.")
+        .def("distribute_food", &Environment::distributeFood, py::arg("region"),
+             py::arg("energy") = 500, "Spawn region.count foods uniformly inside a FoodRegion.")
+        .def("reproduce_organisms", &Environment::reproduceOrganisms,
+             py::arg("threshold") = 1000.0f, py::arg("max_population") = 0,
+             "Reproduce every organism whose life-span exceeds threshold; returns offspring count.")
+        .def("set_seed", &Environment::setSeed, py::arg("seed"),
+             "Seed the generator used for food placement.")
+        .def("requires_gil", &Environment::requiresGil,
+             "True if simulate_iteration has to hold the GIL (Python strategies or custom "
+             "objects present).")
         .def("get_dead_organisms", &Environment::getDeadOrganisms)
         .def("get_food_consumption_in_iteration", &Environment::getFoodConsumptionInIteration)
+        .def("get_species_count", &Environment::getSpeciesCount,
+             "Number of distinct organism policies in the environment, including the default.")
         .def("set_verbose", &Environment::setVerbose, py::arg("verbose"),
              "Enable or disable profiler output after simulate_iteration. Default is off.");
 
@@ -0,0 +1,23 @@
+#include <pybind11/pybind11.h>
+
+#include <core/LiveFeed.hpp>
+#include <memory>
+
+namespace py = pybind11;
+
+void init_LiveFeed(py::module &m) {
+    py::class_<LiveFeed, std::shared_ptr<LiveFeed>>(m, "LiveFeed")
+        .def(py::init<const std::string &, std::uint32_t, std::uint32_t, std::uint32_t>(),
+             py::arg("name"), py::arg("organism_capacity"), py::arg("food_capacity"),
+             py::arg("interval") = 1,
+             "Create the POSIX shared-memory segment name and publish every interval-th tick "
+             "of the environment it is attached to (see Environment.set_live_feed) into it: "
+             "up to organism_capacity organisms and food_capacity food items. Observer "
+             "processes read it with examples/utils/live_feed.py. The segment is unlinked "
+             "when the feed is destroyed.")
+        .def("get_name", &LiveFeed::getName, "Segment name, with the leading '/'.")
+        .def("get_size", &LiveFeed::getSize, "Size of the segment in bytes.")
+        .def("get_published_count", &LiveFeed::getPublishedCount,
+             "Number of publications so far.")
+        .def("get_interval", &LiveFeed::getInterval, "Ticks between publications.");
+}
@@ -1,15 +1,120 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 
 #include <core/Organism.hpp>
+#include <stdexcept>
+
+#include "ProfiledGil.hpp"
 
 namespace py = pybind11;
 
+// Copy a flat C++ buffer into a new NumPy array of the given shape
+template <typename T>
+static py::array_t<T> toArray(const std::vector<T> &data, std::vector<py::ssize_t> shape) {
+    return py::array_t<T>(shape, data.data());
+}
+
+// Wrap a Python callable as a BatchReactionStrategy. The callable receives the
+// batch as a dict of NumPy arrays and returns an (N, 2) array of directions.
+static Organism::BatchReactionStrategy wrapBatchReaction(py::function callable) {
+    // The callable outlives this call; release it under the GIL wherever the
+    // last policy copy happens to be destroyed
+    auto handle = std::shared_ptr<py::function>(new py::function(std::move(callable)),
+                                                [](py::function *f) {
+                                                    py::gil_scoped_acquire gil;
+                                                    delete f;
+                                                });
+
+    return [handle](const ReactionBatch &batch, std::vector<Vec2> &movements) {
+        ProfiledGilAcquire gil;
+        auto n = static_cast<py::ssize_t>(batch.size());
+        auto m = static_cast<py::ssize_t>(batch.neighbourCount());
+        auto nnz = static_cast<py::ssize_t>(batch.neighbourIndices.size());
+
+        py::dict arrays;
+        arrays["positions"] = toArray(batch.positions, {n, 2});
+        arrays["traits"] = toArray(batch.traits, {n, ReactionBatch::TRAIT_COUNT});
+        arrays["neighbour_offsets"] = toArray(batch.neighbourOffsets, {n + 1});
+        arrays["neighbour_indices"] = toArray(batch.neighbourIndices, {nnz});
+        arrays["neighbour_positions"] = toArray(batch.neighbourPositions, {m, 2});
+        arrays["neighbour_sizes"] = toArray(batch.neighbourSizes, {m});
+        arrays["neighbour_kinds"] = toArray(batch.neighbourKinds, {m});
+        arrays["neighbour_active"] = toArray(batch.neighbourActive, {m});
+
+        auto directions = py::array_t<float, py::array::c_style | py::array::forcecast>::ensure(
+            (*handle)(arrays));
+        if (!directions || directions.ndim() != 2 || directions.shape(0) != n ||
+            directions.shape(1) != 2) {
+            throw std::runtime_error("Batch reaction strategy must return an (N, 2) array.");
+        }
+
+        auto view = directions.unchecked<2>();
+        for (py::ssize_t i = 0; i < n; i++) {
+            movements[i] = Vec2(view(i, 0), view(i, 1));
+        }
+    };
+}
+
 void init_Organism(py::module &m) {
+    // Policies are immutable once created: fields are exposed read-only
+    py::class_<Organism::Policy, std::shared_ptr<Organism::Policy>>(m, "Policy")
+        .def(py::init([](Organism::LifeConsumptionCalculator lifeConsumption,
+                         Organism::ReactionStrategy reaction,
+                         Organism::InteractionStrategy interaction, py::object batchReaction,
+                         std::uintptr_t nativeReaction, std::uintptr_t nativeInteraction,
+                         std::shared_ptr<RuleBasedStrategy> rules) {
+                 Organism::BatchReactionStrategy batch;
+                 if (!batchReaction.is_none()) {
+                     batch = wrapBatchReaction(batchReaction.cast<py::function>());
+                 }
+                 return std::make_shared<Organism::Policy>(Organism::Policy{
+                     lifeConsumption, reaction, interaction, batch,
+                     reinterpret_cast<NativeStrategy::ReactionFn>(nativeReaction),
+                     reinterpret_cast<NativeStrategy::InteractionFn>(nativeInteraction),
+                     std::move(rules)});
+             }),
+             py::arg("life_consumption") = nullptr, py::arg("reaction") = nullptr,
+             py::arg("interaction") = nullptr, py::arg("batch_reaction") = py::none(),
+             py::arg("native_reaction") = 0, py::arg("native_interaction") = 0,
+             py::arg("rules") = nullptr,
+             "Bundle of behaviour callables shared by every organism (and descendant) that "
+             "uses it. Unset callables fall back to the built-in defaults. batch_reaction is "
+             "called once per tick for all organisms of the policy with a dict of NumPy arrays "
+             "(positions, traits, neighbour_offsets, neighbour_indices, neighbour_positions, "
+             "neighbour_sizes, neighbour_kinds, neighbour_active) and must return an (N, 2) "
+             "array of movement directions; it takes precedence over reaction. "
+             "native_reaction / native_interaction take C function addresses (e.g. a Numba "
+             "cfunc's .address) and are used when the matching callable is unset. rules is a "
+             "RuleBasedStrategy used when neither a callable nor a native strategy is set.")
+        .def_readonly("life_consumption", &Organism::Policy::lifeConsumptionCalculator)
+        .def_readonly("reaction", &Organism::Policy::reactionStrategy)
+        .def_readonly("interaction", &Organism::Policy::interactionStrategy)
+        .def_property_readonly(
+            "rules",
+            [](const Organism::Policy &policy) {
+                return std::const_pointer_cast<RuleBasedStrategy>(policy.rules);
+            })
+        .def_property_readonly("has_batch_reaction", [](const Organism::Policy &policy) {
+            return static_cast<bool>(policy.batchReactionStrategy);
+        });
+
     py::class_<Organism, EnvironmentObject, std::shared_ptr<Organism>>(m, "Organism")
         .def(py::init<const Genes &>())
-        .def(py::init<const Genes &, Organism::LifeConsumptionCalculator>())
+        .def(py::init([](const Genes &genes, py::function lifeConsumption) {
+                 // Organisms built from one Python callable share one policy (species);
+                 // the calculator keeps the callable, and so its identity, alive
+                 auto policy = Organism::lifeConsumptionPolicy(
+                     lifeConsumption.cast<Organism::LifeConsumptionCalculator>(),
+                     lifeConsumption.ptr());
+                 return std::make_shared<Organism>(genes, std::move(policy));
+             }),
+             py::arg("genes"), py::arg("life_consumption"))
+        .def(py::init([](const Genes &genes, std::shared_ptr<Organism::Policy> policy) {
+                 return std::make_shared<Organism>(genes, std::move(policy));
+             }),
+             py::arg("genes"), py::arg("policy"))
         .def("get_speed", &Organism::getSpeed)
         .def("get_size", &Organism::getSize)
         .def("get_awareness", &Organism::getAwareness)
@@ -24,10 +129,74 @@ void init_Organism(py::module &m) {
         .def("interact", &Organism::interact)
         .def("react", &Organism::react)
         .def("post_iteration", &Organism::postIteration)
-        .def("set_reaction_strategy", &Organism::setReactionStrategy, py::arg("strategy"),
-             "Set a custom reaction strategy. The callable receives (organism, nearby_objects) "
-             "and should return a (dx, dy) tuple for movement direction, or (0, 0) for no reaction.")
-        .def("set_interaction_strategy", &Organism::setInteractionStrategy, py::arg("strategy"),
-             "Set a custom interaction strategy. The callable receives (organism, nearby_objects) "
-             "and should perform interactions (e.g., eat food, kill organisms).");
+        .def(
+            "set_reaction_strategy",
+            [](Organism &self, py::function strategy) {
+                // One callable shared by many organisms stays one policy (species)
+                self.setReactionStrategy(strategy.cast<Organism::ReactionStrategy>(),
+                                         strategy.ptr());
+            },
+            py::arg("strategy"),
+            "Set a custom reaction strategy. The callable receives (organism, nearby_objects) "
+            "and should return a (dx, dy) tuple for movement direction, or (0, 0) for no reaction.")
+        .def(
+            "set_reaction_strategy",
+            [](Organism &self, py::none) { self.setReactionStrategy(nullptr); },
+            py::arg("strategy"), "Revert to the built-in reaction strategy.")
+        .def(
+            "set_reaction_strategy",
+            [](Organism &self, std::uintptr_t address) {
+                self.setNativeReactionStrategy(
+                    reinterpret_cast<NativeStrategy::ReactionFn>(address));
+            },
+            py::arg("address"),
+            "Set a native reaction strategy from a C function address with signature "
+            "void(const float* self, const float* neighbours, int32 count, float* direction). "
+            "self holds (x, y, speed, size, awareness, life_span); each neighbour holds "
+            "(x, y, kind, size, active, value). Runs without the GIL.")
+        .def(
+            "set_interaction_strategy",
+            [](Organism &self, py::function strategy) {
+                self.setInteractionStrategy(strategy.cast<Organism::InteractionStrategy>(),
+                                            strategy.ptr());
+            },
+            py::arg("strategy"),
+            "Set a custom interaction strategy. The callable receives (organism, nearby_objects) "
+            "and should perform interactions (e.g., eat food, kill organisms).")
+        .def(
+            "set_interaction_strategy",
+            [](Organism &self, py::none) { self.setInteractionStrategy(nullptr); },
+            py::arg("strategy"), "Revert to the built-in interaction strategy.")
+        .def(
+            "set_interaction_strategy",
+            [](Organism &self, std::uintptr_t address) {
+                self.setNativeInteractionStrategy(
+                    reinterpret_cast<NativeStrategy::InteractionFn>(address));
+            },
+            py::arg("address"),
+            "Set a native interaction strategy from a C function address with signature "
+            "void(const float* self, const float* neighbours, int32 count, uint8* consume). "
+            "Set consume[i] to eat food i or kill organism i. Runs without the GIL.")
+        .def(
+            "set_rule_based_strategy",
+            [](Organism &self, std::shared_ptr<RuleBasedStrategy> strategy) {
+                self.setRuleBasedStrategy(std::move(strategy));
+            },
+            py::arg("strategy"),
+            "Replace both reaction and interaction with a RuleBasedStrategy, clearing any "
+            "callable or native strategy. Runs natively and in parallel, without the GIL.")
+        .def(
+            "set_policy",
+            [](Organism &self, std::shared_ptr<Organism::Policy> policy) {
+                self.setPolicy(std::move(policy));
+            },
+            py::arg("policy"),
+            "Share a Policy with this organism. Prefer this over per-organism "
+            "set_*_strategy calls when many organisms behave the same way.")
+        .def("get_species_id", &Organism::getSpeciesId,
+             "Species id assigned by the Environment the organism was added to.")
+        .def("has_custom_strategy", &Organism::hasCustomStrategy)
+        .def("requires_gil", &Organism::requiresGil,
+             "True if any strategy or the life consumption calculator is a Python/std::function "
+             "callback. Built-in and native strategies do not need the GIL.");
 }
@@ -0,0 +1,36 @@
+#ifndef PROFILED_GIL_HPP
+#define PROFILED_GIL_HPP
+
+#include <pybind11/pybind11.h>
+
+#include <core/SimulationProfile.hpp>
+#include <cstdint>
+#include <utils/profiler.hpp>
+
+/**
+ * @brief py::gil_scoped_acquire that records the wait as a GIL_WAIT zone.
+ *
+ * Use it wherever C++ running without the GIL calls back into Python, so
+ * traces show GIL contention apart from the callback's own time. Inside a
+ * strategy call the wait is also charged to that species' StrategyCost.
+ */
+class ProfiledGilAcquire {
+public:
+    ProfiledGilAcquire() {
+#ifndef SIMEVO_DISABLE_PROFILING
+        const std::uint64_t end = Profiler::now();
+        ProfileScope::emit(ProfileZone::GIL_WAIT, start, end);
+        StrategyTally::addGilWait(end - start);
+#endif
+    }
+
+    ProfiledGilAcquire(const ProfiledGilAcquire &) = delete;
+    ProfiledGilAcquire &operator=(const ProfiledGilAcquire &) = delete;
+
+private:
+    // Declaration order matters: the timestamp is taken before blocking on the GIL
+    std::uint64_t start = Profiler::now();
+    pybind11::gil_scoped_acquire gil;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <core/RuleBasedStrategy.hpp>
+#include <limits>
+
+namespace py = pybind11;
+
+void init_RuleBasedStrategy(py::module &m) {
+    using Rule = RuleBasedStrategy::Rule;
+    const float unbounded = std::numeric_limits<float>::infinity();
+
+    py::class_<Rule>(m, "Rule")
+        .def(py::init([](ObjectKind target, float minSizeRatio, float maxSizeRatio, float range,
+                         float weight, bool consume) {
+                 return Rule{target, minSizeRatio, maxSizeRatio, range, weight, consume};
+             }),
+             py::arg("target") = ObjectKind::FOOD, py::arg("min_size_ratio") = 0.0f,
+             py::arg("max_size_ratio") = unbounded, py::arg("range") = unbounded,
+             py::arg("weight") = 1.0f, py::arg("consume") = false,
+             "One rule of a RuleBasedStrategy. Matches live organisms / edible food / custom "
+             "objects of kind target; for organisms, neighbour size / own size must lie in "
+             "[min_size_ratio, max_size_ratio). The nearest match within range pulls the "
+             "organism with strength weight (negative repels). consume eats or kills matches "
+             "on contact.")
+        .def_readwrite("target", &Rule::target)
+        .def_readwrite("min_size_ratio", &Rule::minSizeRatio)
+        .def_readwrite("max_size_ratio", &Rule::maxSizeRatio)
+        .def_readwrite("range", &Rule::range)
+        .def_readwrite("weight", &Rule::weight)
+        .def_readwrite("consume", &Rule::consume);
+
+    py::class_<RuleBasedStrategy, std::shared_ptr<RuleBasedStrategy>>(m, "RuleBasedStrategy")
+        .def(py::init<std::vector<Rule>>(), py::arg("rules"),
+             "Declarative reaction and interaction evaluated in C++ without the GIL. "
+             "Rules are in priority order: the first matching rule decides interactions.")
+        .def("get_rules", &RuleBasedStrategy::getRules);
+}
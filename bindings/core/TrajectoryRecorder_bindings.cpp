@@ -0,0 +1,31 @@
+#include <pybind11/pybind11.h>
+
+#include <core/TrajectoryRecorder.hpp>
+#include <memory>
+
+namespace py = pybind11;
+
+void init_TrajectoryRecorder(py::module &m) {
+    py::class_<TrajectoryRecorder, std::shared_ptr<TrajectoryRecorder>>(m, "TrajectoryRecorder")
+        .def(py::init<const std::string &, float, float, std::uint32_t, std::uint32_t,
+                      std::size_t>(),
+             py::arg("path"), py::arg("width"), py::arg("height"), py::arg("interval") = 1,
+             py::arg("chunk_frames") = 64, py::arg("max_pending_frames") = 256,
+             "Stream every interval-th tick of the environment it is attached to (see "
+             "Environment.set_recorder) into a chunked columnar file, written by a background "
+             "thread. At most max_pending_frames frames are buffered. Read it back with "
+             "examples/utils/trajectory.py.")
+        .def("close", &TrajectoryRecorder::close, py::call_guard<py::gil_scoped_release>(),
+             "Write pending frames and finish the file. Raises RuntimeError if writing failed.")
+        .def("get_frame_count", &TrajectoryRecorder::getFrameCount,
+             "Number of frames captured so far.")
+        .def("get_interval", &TrajectoryRecorder::getInterval, "Ticks between recorded frames.")
+        .def("__enter__", [](std::shared_ptr<TrajectoryRecorder> self) { return self; })
+        .def(
+            "__exit__",
+            [](TrajectoryRecorder &self, py::object, py::object, py::object) {
+                py::gil_scoped_release release;
+                self.close();
+            },
+            py::arg("exc_type"), py::arg("exc_value"), py::arg("traceback"));
+}
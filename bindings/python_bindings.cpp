@@ -2,11 +2,15 @@
 
 namespace py = pybind11;
 
+void init_EnsembleRunner(py::module &);
 void init_EnvironmentObject(py::module &);
 void init_Environment(py::module &);
 void init_Food(py::module &);
 void init_Genes(py::module &);
+void init_LiveFeed(py::module &);
 void init_Organism(py::module &);
+void init_RuleBasedStrategy(py::module &);
+void init_TrajectoryRecorder(py::module &);
 
 PYBIND11_MODULE(simevopy, m) {
     m.doc() = "Simulation Evolution Python bindings";
@@ -14,9 +18,13 @@ PYBIND11_MODULE(simevopy, m) {
         "hello_world", []() { return "Hello, World!"; },
         "A function that returns a hello world to test the bindings. ");
     init_EnvironmentObject(m);
+    init_TrajectoryRecorder(m);
+    init_LiveFeed(m);
     init_Environment(m);
     init_Food(m);
     init_Genes(m);
+    init_RuleBasedStrategy(m);
     init_Organism(m);
+    init_EnsembleRunner(m);
 
 }
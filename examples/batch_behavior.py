@@ -0,0 +1,91 @@
+"""
+Example: Species-batched Python Behavior
+
+Same herbivores as custom_behavior.py, but the reaction strategy is called
+once per tick for the whole species with NumPy arrays instead of once per
+organism with a list of objects.
+"""
+
+import random
+
+import numpy as np
+from simevopy import Environment, Food, Genes, ObjectKind, Organism, Policy
+
+FOOD = int(ObjectKind.FOOD)
+ORGANISM = int(ObjectKind.ORGANISM)
+
+
+def nearest_per_row(rows, dist, mask):
+    """Return (rows, positions-in-mask) of the nearest masked neighbour of each row."""
+    candidates = np.flatnonzero(mask)
+    if candidates.size == 0:
+        return candidates, candidates
+    order = candidates[np.lexsort((dist[candidates], rows[candidates]))]
+    first = np.r_[True, rows[order][1:] != rows[order][:-1]]
+    return rows[order][first], order[first]
+
+
+def herbivore_batch_reaction(batch):
+    """Herbivores flee organisms closer than 20, otherwise move toward food."""
+    positions = batch["positions"]
+    offsets = batch["neighbour_offsets"]
+    indices = batch["neighbour_indices"]
+
+    # Expand the CSR neighbourhoods into one entry per (organism, neighbour) pair
+    rows = np.repeat(np.arange(len(positions)), np.diff(offsets))
+    delta = batch["neighbour_positions"][indices] - positions[rows]
+    dist = np.hypot(delta[:, 0], delta[:, 1])
+    kinds = batch["neighbour_kinds"][indices]
+    active = batch["neighbour_active"][indices].astype(bool)
+
+    movements = np.zeros((len(positions), 2), dtype=np.float32)
+
+    target_rows, target = nearest_per_row(rows, dist, active & (kinds == FOOD))
+    movements[target_rows] = delta[target]
+
+    threat_rows, threat = nearest_per_row(rows, dist, active & (kinds == ORGANISM) & (dist < 20))
+    movements[threat_rows] = -delta[threat]
+
+    return movements
+
+
+def herbivore_interaction(organism, nearby_objects):
+    """Herbivores only eat food, never attack other organisms."""
+    for obj in nearby_objects:
+        if hasattr(obj, "can_be_eaten") and obj.can_be_eaten():
+            organism.add_life_span(obj.get_energy())
+            obj.eaten()
+
+
+def no_life_cost(organism):
+    """Zero life consumption for demo purposes."""
+    return 0
+
+
+def main():
+    env = Environment(500, 500)
+
+    herbivore = Policy(
+        life_consumption=no_life_cost,
+        interaction=herbivore_interaction,
+        batch_reaction=herbivore_batch_reaction,
+    )
+
+    for _ in range(200):
+        dna = chr(60) + chr(15) + chr(80) + chr(0)  # fast, small, aware
+        env.add_organism(Organism(Genes(dna), herbivore),
+                         random.uniform(10, 490), random.uniform(10, 490))
+
+    for _ in range(300):
+        env.add_food(Food(), random.uniform(10, 490), random.uniform(10, 490))
+
+    env.simulate_iteration(200)
+
+    print(f"\nAfter 200 iterations:")
+    print(f"  Surviving organisms: {len(env.get_all_organisms())}")
+    print(f"  Remaining food: {len(env.get_all_foods())}")
+    print(f"  Food consumed: {env.get_food_consumption_in_iteration()}")
+
+
+if __name__ == "__main__":
+    main()
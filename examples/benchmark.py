@@ -1,18 +1,15 @@
 import numpy as np
-from simevopy import Environment
-from utils.common import (
-    distribute_food_randomly,
-    remove_all_foods,
-    reproduce_organisms,
-    setup_base_organism,
-)
+from simevopy import Environment, FoodRegion, GenerationPolicy
+from utils.common import setup_base_organism
+
 
-def distribute_food_like_oasis(env, food_count):
-    distribute_food_randomly(env, int(food_count / 4), (1600, 1600), (1800, 1800))
-    distribute_food_randomly(env, int(food_count / 4), (0, 0), (2000, 2000))
-    
-    distribute_food_randomly(env, int(food_count / 2), (100, 100), (500, 500))
-    distribute_food_randomly(env, int(food_count / 6), (1000, 1000), (1500, 1500))
+def oasis_food_regions(food_count):
+    return [
+        FoodRegion(1600, 1600, 1800, 1800, int(food_count / 4)),
+        FoodRegion(0, 0, 2000, 2000, int(food_count / 4)),
+        FoodRegion(100, 100, 500, 500, int(food_count / 2)),
+        FoodRegion(1000, 1000, 1500, 1500, int(food_count / 6)),
+    ]
 
 
 env = Environment(4000, 4000, threads=4)
@@ -24,32 +21,30 @@ average_sizes = []
 average_speeds = []
 average_awareness = []
 
-for i in range(10):
-    print("=========================================")
-    print(f"Gen {i} th")
-
-    distribute_food_like_oasis(env, 400)
 
-    env.simulate_iteration(
-        100,
-    )
+def record_generation(env, generation):
+    print("=========================================")
+    print(f"Gen {generation} th")
 
-    organisms = env.get_all_organisms()
-    organism_count = len(organisms)
+    # Zero-copy views of the engine state; organisms come first
+    state = env.state()
+    organism_count = state["organism_count"]
     organism_counts.append(organism_count)
 
     if organism_count > 0:
-        sizes = np.array([org.get_size() for org in organisms])
-        speeds = np.array([org.get_speed() for org in organisms])
-        awareness = np.array([org.get_awareness() for org in organisms])
-
-        average_sizes.append(np.mean(sizes))
-        average_speeds.append(np.mean(speeds))
-        average_awareness.append(np.mean(awareness))
+        average_sizes.append(np.mean(state["size"][:organism_count]))
+        average_speeds.append(np.mean(state["speed"][:organism_count]))
+        average_awareness.append(np.mean(state["awareness"][:organism_count]))
     else:
         average_sizes.append(0)
         average_speeds.append(0)
         average_awareness.append(0)
 
-    reproduce_organisms(env)
-    remove_all_foods(env)
+
+# Food spawning, reproduction and food reset all run inside C++
+env.simulate_generations(
+    10,
+    100,
+    GenerationPolicy(food_regions=oasis_food_regions(400)),
+    on_each_generation=record_generation,
+)
@@ -0,0 +1,37 @@
+"""
+Per-object vs bulk food churn from Python.
+
+Adds N foods then removes them all, once through add_food / remove_food
+(one pybind11 call, UUID and index operation per item) and once through
+add_foods / remove_all_foods (one call each).
+"""
+
+import time
+
+import numpy as np
+from simevopy import Environment, Food
+
+SIZE = 4000
+
+for index_type in ("default", "optimized"):
+    for count in (400, 4000):
+        rng = np.random.default_rng(7)
+        xs = rng.uniform(0, SIZE - 1, count).astype(np.float32)
+        ys = rng.uniform(0, SIZE - 1, count).astype(np.float32)
+
+        env = Environment(SIZE, SIZE, type=index_type)
+        start = time.perf_counter()
+        for x, y in zip(xs, ys):
+            env.add_food(Food(), float(x), float(y))
+        for food in env.get_all_foods():
+            env.remove_food(food)
+        per_object = (time.perf_counter() - start) * 1000
+
+        env = Environment(SIZE, SIZE, type=index_type)
+        start = time.perf_counter()
+        env.add_foods(xs, ys)
+        env.remove_all_foods()
+        bulk = (time.perf_counter() - start) * 1000
+
+        print(f"{index_type:9s} {count:5d} foods: per-object {per_object:8.2f} ms, "
+              f"bulk {bulk:8.2f} ms ({per_object / bulk:5.1f}x)")
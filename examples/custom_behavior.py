@@ -9,7 +9,7 @@ without modifying the C++ engine. Two species coexist:
 
 import random
 
-from simevopy import Environment, Food, Genes, Organism
+from simevopy import Environment, Food, Genes, Organism, Policy
 
 
 # --- Custom Reaction Strategies ---
@@ -110,20 +110,29 @@ def no_life_cost(organism):
 def main():
     env = Environment(500, 500)
 
+    # One shared policy per species: organisms (and their offspring) only
+    # hold a reference to it instead of their own copy of each callback.
+    herbivore = Policy(
+        life_consumption=no_life_cost,
+        reaction=herbivore_reaction,
+        interaction=herbivore_interaction,
+    )
+    predator = Policy(
+        life_consumption=no_life_cost,
+        reaction=predator_reaction,
+        interaction=predator_interaction,
+    )
+
     # Create herbivores (small, fast, high awareness)
     for _ in range(15):
         dna = chr(60) + chr(15) + chr(80) + chr(0)  # fast, small, aware
-        org = Organism(Genes(dna), no_life_cost)
-        org.set_reaction_strategy(herbivore_reaction)
-        org.set_interaction_strategy(herbivore_interaction)
+        org = Organism(Genes(dna), herbivore)
         env.add_organism(org, random.uniform(10, 490), random.uniform(10, 490))
 
     # Create predators (slower, bigger, less awareness)
     for _ in range(5):
         dna = chr(30) + chr(80) + chr(60) + chr(0)  # slow, big, moderate awareness
-        org = Organism(Genes(dna), no_life_cost)
-        org.set_reaction_strategy(predator_reaction)
-        org.set_interaction_strategy(predator_interaction)
+        org = Organism(Genes(dna), predator)
         env.add_organism(org, random.uniform(10, 490), random.uniform(10, 490))
 
     # Add food
@@ -140,6 +149,7 @@ def main():
     print(f"  Remaining food: {len(env.get_all_foods())}")
     print(f"  Food consumed: {env.get_food_consumption_in_iteration()}")
     print(f"  Dead organisms: {len(env.get_dead_organisms())}")
+    print(f"  Species: {env.get_species_count()}")
 
 
 if __name__ == "__main__":
@@ -0,0 +1,44 @@
+"""
+Watch a running simulation from a separate process through a LiveFeed.
+
+Run without arguments to start a simulation publishing to "simevo_live";
+run again with --watch in another terminal to plot it while it runs. The
+simulation never waits for the viewer.
+"""
+
+import sys
+
+import matplotlib.pyplot as plt
+from simevopy import Environment, FoodRegion, GenerationPolicy, LiveFeed
+from utils.common import setup_base_organism
+from utils.live_feed import LiveFeedReader
+
+NAME = "simevo_live"
+
+if "--watch" not in sys.argv:
+    env = Environment(1000, 1000)
+    setup_base_organism(env, 50)
+    feed = LiveFeed(NAME, organism_capacity=100_000, food_capacity=100_000, interval=10)
+    env.set_live_feed(feed)
+    policy = GenerationPolicy(food_regions=[FoodRegion(0, 0, 1000, 1000, 300)])
+    env.simulate_generations(1000, 100, policy)
+    sys.exit()
+
+with LiveFeedReader(NAME) as reader:
+    seen = -1
+    while plt.get_fignums() or seen < 0:
+        if reader.published == seen:
+            plt.pause(0.05)
+            continue
+        seen = reader.published
+        sample = reader.sample()
+        plt.clf()
+        plt.scatter(sample["food_x"], sample["food_y"], s=1, color="green", label="Food")
+        plt.scatter(sample["x"], sample["y"], s=sample["size"] ** 2, color="blue", alpha=0.5,
+                    label="Organisms")
+        plt.xlim(0, sample["width"])
+        plt.ylim(0, sample["height"])
+        plt.title(f"Tick {sample['tick']}: {sample['organisms']} organisms, "
+                  f"{sample['foods']} food")
+        plt.legend()
+        plt.pause(0.05)
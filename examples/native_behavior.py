@@ -0,0 +1,92 @@
+"""
+Example: Native Behavior Strategies with Numba
+
+Compiles the herbivore strategies from custom_behavior.py to C function
+pointers with numba.cfunc. The engine calls them directly: no Python, no
+GIL, and the reaction phase can use every worker thread.
+
+Requires: pip install numba
+"""
+
+import random
+
+from numba import carray, cfunc, types
+from simevopy import Environment, Food, Genes, ObjectKind, Organism, Policy
+
+SELF_STRIDE = 6       # x, y, speed, size, awareness, life_span
+NEIGHBOUR_STRIDE = 6  # x, y, kind, size, active, value
+FOOD = float(int(ObjectKind.FOOD))
+ORGANISM = float(int(ObjectKind.ORGANISM))
+
+reaction_sig = types.void(types.CPointer(types.float32), types.CPointer(types.float32),
+                          types.int32, types.CPointer(types.float32))
+interaction_sig = types.void(types.CPointer(types.float32), types.CPointer(types.float32),
+                             types.int32, types.CPointer(types.uint8))
+
+
+@cfunc(reaction_sig, nopython=True)
+def herbivore_reaction(self_ptr, neighbours_ptr, count, direction_ptr):
+    """Flee organisms closer than 20, otherwise move toward the nearest food."""
+    me = carray(self_ptr, SELF_STRIDE)
+    neighbours = carray(neighbours_ptr, count * NEIGHBOUR_STRIDE)
+    direction = carray(direction_ptr, 2)
+
+    food_dist, food_dx, food_dy = 1e30, 0.0, 0.0
+    threat_dist, threat_dx, threat_dy = 1e30, 0.0, 0.0
+    for i in range(count):
+        base = i * NEIGHBOUR_STRIDE
+        if neighbours[base + 4] == 0.0:
+            continue
+        dx = neighbours[base] - me[0]
+        dy = neighbours[base + 1] - me[1]
+        dist = (dx * dx + dy * dy) ** 0.5
+        if neighbours[base + 2] == FOOD and dist < food_dist:
+            food_dist, food_dx, food_dy = dist, dx, dy
+        elif neighbours[base + 2] == ORGANISM and dist < threat_dist:
+            threat_dist, threat_dx, threat_dy = dist, dx, dy
+
+    if threat_dist < 20.0:
+        direction[0] = -threat_dx
+        direction[1] = -threat_dy
+    elif food_dist < 1e30:
+        direction[0] = food_dx
+        direction[1] = food_dy
+
+
+@cfunc(interaction_sig, nopython=True)
+def herbivore_interaction(self_ptr, neighbours_ptr, count, consume_ptr):
+    """Eat every edible food in reach, never attack."""
+    neighbours = carray(neighbours_ptr, count * NEIGHBOUR_STRIDE)
+    consume = carray(consume_ptr, count)
+    for i in range(count):
+        base = i * NEIGHBOUR_STRIDE
+        if neighbours[base + 2] == FOOD and neighbours[base + 4] != 0.0:
+            consume[i] = 1
+
+
+def main():
+    env = Environment(2000, 2000, type="optimized", threads=4)
+
+    herbivore = Policy(
+        native_reaction=herbivore_reaction.address,
+        native_interaction=herbivore_interaction.address,
+    )
+
+    for _ in range(2000):
+        dna = chr(60) + chr(15) + chr(80) + chr(0)  # fast, small, aware
+        org = Organism(Genes(dna), herbivore)
+        env.add_organism(org, random.uniform(10, 1990), random.uniform(10, 1990))
+
+    for _ in range(2000):
+        env.add_food(Food(), random.uniform(10, 1990), random.uniform(10, 1990))
+
+    assert not env.get_all_organisms()[0].requires_gil()
+    env.simulate_iteration(200)
+
+    print(f"\nAfter 200 iterations:")
+    print(f"  Surviving organisms: {len(env.get_all_organisms())}")
+    print(f"  Food consumed: {env.get_food_consumption_in_iteration()}")
+
+
+if __name__ == "__main__":
+    main()
@@ -8,7 +8,7 @@ from utils.common import (
     reproduce_organisms,
     setup_base_organism,
 )
-from utils.visualize import visualize_objects
+from utils.visualize import render_objects
 
 def distribute_food_like_oasis(env, food_count):
     distribute_food_randomly(env, int(food_count / 4), (1600, 1600), (1800, 1800))
@@ -57,7 +57,7 @@ for i in range(6000):
     print("After iteration, organism count: ", organism_count)
 
     if i % 100 == 0:
-        visualize_objects(env, f"Organisms and Food Distribution (Generation {i})")
+        render_objects(env, f"Organisms and Food Distribution (Generation {i})")
         input("Press Enter to continue...")
 
     reproduce_organisms(env)
@@ -0,0 +1,302 @@
+"""
+Performance regression harness: record throughput baselines, then check new
+builds against them.
+
+Runs fixed-seed scenarios several times each: the C++ end-to-end benchmark
+(benchmark_environment) and a few Python scenarios through simevopy. Every
+repetition yields one throughput sample, in items per second.
+
+    # On the reference build
+    python examples/regression_benchmark.py record -o baseline.json \\
+        --binary build/tests/cpp/benchmark_environment
+
+    # On the build under test; exits 1 on a regression
+    python examples/regression_benchmark.py compare baseline.json \\
+        --binary build/tests/cpp/benchmark_environment
+
+A scenario regresses when its mean throughput drops by more than --threshold
+and the 95% confidence interval of the change excludes zero. Noisy runs
+therefore do not fail the check on their own; use more repetitions to narrow
+the intervals. Baselines are only comparable on the same machine and build
+type. Nothing leaves the machine.
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import statistics
+import subprocess
+import sys
+import time
+
+# Fixed workload of the C++ suite; changing it invalidates recorded baselines
+CPP_ARGS = [
+    "--populations", "1000,4000",
+    "--foods", "uniform,oasis",
+    "--indexes", "default,optimized",
+    "--threads", "1",
+    "--ticks", "20",
+    "--warmup", "2",
+    "--seed", "42",
+]
+
+# Two-sided 95% Student t critical values by degrees of freedom
+T_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+
+def t_critical(df):
+    """Two-sided 95% critical value; df may be fractional (Welch)."""
+    if df < 1:
+        return T_95[0]
+    if df >= len(T_95):
+        # Approaches the normal 1.96 from above
+        return 1.960 + (T_95[-1] - 1.960) * len(T_95) / df
+    low = int(df)
+    high = min(low + 1, len(T_95))
+    fraction = df - low
+    return T_95[low - 1] + (T_95[high - 1] - T_95[low - 1]) * fraction
+
+
+def summarize(samples):
+    """Mean, standard deviation and 95% confidence interval of the mean."""
+    n = len(samples)
+    mean = statistics.fmean(samples)
+    stdev = statistics.stdev(samples) if n > 1 else 0.0
+    half = t_critical(n - 1) * stdev / math.sqrt(n) if n > 1 else 0.0
+    return {"n": n, "mean": mean, "stdev": stdev, "ci_low": mean - half, "ci_high": mean + half}
+
+
+def compare_samples(baseline, current, threshold):
+    """
+    Relative change of the mean throughput with its 95% confidence interval
+    (Welch's t), and a verdict: "regression", "improvement", "unchanged" or
+    "noisy" when a change beyond the threshold is not significant.
+    """
+    base, cur = summarize(baseline), summarize(current)
+    if base["mean"] <= 0:
+        raise ValueError("baseline throughput must be positive")
+    change = (cur["mean"] - base["mean"]) / base["mean"]
+
+    var_base = base["stdev"] ** 2 / base["n"]
+    var_cur = cur["stdev"] ** 2 / cur["n"]
+    se = math.sqrt(var_base + var_cur)
+    if se > 0:
+        # Welch-Satterthwaite degrees of freedom; a single sample contributes none
+        denominator = sum(v * v / (s["n"] - 1)
+                          for v, s in ((var_base, base), (var_cur, cur)) if s["n"] > 1)
+        df = (var_base + var_cur) ** 2 / denominator if denominator > 0 else 1
+        half = t_critical(df) * se / base["mean"]
+    else:
+        half = 0.0
+    low, high = change - half, change + half
+
+    if change < -threshold and high < 0:
+        verdict = "regression"
+    elif change > threshold and low > 0:
+        verdict = "improvement"
+    elif abs(change) > threshold:
+        verdict = "noisy"
+    else:
+        verdict = "unchanged"
+    return {"baseline": base, "current": cur, "change": change, "ci_low": low,
+            "ci_high": high, "verdict": verdict}
+
+
+def run_cpp(binary, repetitions):
+    """Samples of every benchmark_environment scenario, in organism-ticks per second."""
+    command = [binary, *CPP_ARGS, "--repetitions", str(repetitions), "--json", "-"]
+    output = subprocess.run(command, check=True, capture_output=True, text=True).stdout
+    report = json.loads(output)
+    return {"cpp/" + r["name"]: {"unit": report["unit"], "samples": r["organism_ticks_per_second"]}
+            for r in report["results"]}
+
+
+def python_simulate(reaction=None):
+    """Organism-ticks per second of a fixed-seed world, optionally with a Python strategy."""
+    import numpy as np
+    from simevopy import Environment, Policy
+
+    rng = np.random.default_rng(42)
+    count, size = (300, 350) if reaction else (2000, 900)
+    dna = np.column_stack([rng.integers(16, 49, count), rng.integers(24, 33, count),
+                           rng.integers(16, 65, count), np.zeros(count)]).astype(np.uint8)
+    env = Environment(size, size, type="optimized")
+    env.set_seed(42)
+    env.add_organisms(dna, rng.uniform(0, size - 1, count).astype(np.float32),
+                      rng.uniform(0, size - 1, count).astype(np.float32),
+                      policy=Policy(reaction=reaction) if reaction else None)
+    env.add_foods(rng.uniform(0, size - 1, count // 2).astype(np.float32),
+                  rng.uniform(0, size - 1, count // 2).astype(np.float32))
+    env.simulate_iteration(2)
+    env.reset_profile()
+
+    start = time.perf_counter()
+    env.simulate_iteration(10)
+    seconds = time.perf_counter() - start
+    return env.get_profile()["organisms_reacted"] / seconds
+
+
+def python_callback():
+    def drift(organism, neighbours):
+        return (1.0, 0.5) if neighbours else (0.5, 1.0)
+
+    return python_simulate(reaction=drift)
+
+
+def python_bulk_foods():
+    """Foods added and removed per second through the NumPy bulk calls."""
+    import numpy as np
+    from simevopy import Environment
+
+    rng = np.random.default_rng(7)
+    count, size = 20000, 4000
+    xs = rng.uniform(0, size - 1, count).astype(np.float32)
+    ys = rng.uniform(0, size - 1, count).astype(np.float32)
+    env = Environment(size, size, type="optimized")
+    start = time.perf_counter()
+    env.add_foods(xs, ys)
+    env.remove_all_foods()
+    return 2 * count / (time.perf_counter() - start)
+
+
+PYTHON_SCENARIOS = {
+    "python/simulate_default": ("organism_ticks_per_second", python_simulate),
+    "python/simulate_callback": ("organism_ticks_per_second", python_callback),
+    "python/bulk_foods": ("objects_per_second", python_bulk_foods),
+}
+
+
+def run_python(repetitions):
+    return {name: {"unit": unit, "samples": [scenario() for _ in range(repetitions)]}
+            for name, (unit, scenario) in PYTHON_SCENARIOS.items()}
+
+
+def git_revision():
+    try:
+        return subprocess.run(["git", "rev-parse", "--short", "HEAD"], check=True,
+                              capture_output=True, text=True,
+                              cwd=os.path.dirname(os.path.abspath(__file__))).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def run_suites(args):
+    scenarios = {}
+    if "cpp" in args.suites:
+        if not args.binary:
+            sys.exit("regression_benchmark: --binary is required for the cpp suite")
+        print(f"running the C++ suite, {args.repetitions} repetitions...", file=sys.stderr)
+        scenarios.update(run_cpp(args.binary, args.repetitions))
+    if "python" in args.suites:
+        print(f"running the Python suite, {args.repetitions} repetitions...", file=sys.stderr)
+        try:
+            scenarios.update(run_python(args.repetitions))
+        except ImportError as error:
+            sys.exit(f"regression_benchmark: the python suite needs simevopy ({error}); "
+                     "install it or pass --suites cpp")
+    return {
+        "revision": git_revision(),
+        "label": args.label,
+        "recorded": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "machine": {"host": platform.node(), "cpu_count": os.cpu_count(),
+                    "python": platform.python_version()},
+        "cpp_args": CPP_ARGS,
+        "repetitions": args.repetitions,
+        "scenarios": scenarios,
+    }
+
+
+def write_json(path, data):
+    with open(path, "w") as out:
+        json.dump(data, out, indent=2)
+        out.write("\n")
+
+
+def print_comparison(baseline, current, threshold):
+    """Print one row per scenario; return the names of regressed scenarios."""
+    regressions = []
+    print(f"{'Scenario':<56} {'Baseline':>12} {'Current':>12} {'Change':>8} "
+          f"{'95% CI':>17}  Verdict")
+    for name in sorted(set(baseline["scenarios"]) | set(current["scenarios"])):
+        if name not in current["scenarios"]:
+            print(f"{name:<56} {'':>12} {'':>12} {'':>8} {'':>17}  missing from current run")
+            continue
+        if name not in baseline["scenarios"]:
+            print(f"{name:<56} {'':>12} {'':>12} {'':>8} {'':>17}  new, no baseline")
+            continue
+        result = compare_samples(baseline["scenarios"][name]["samples"],
+                                 current["scenarios"][name]["samples"], threshold)
+        interval = f"[{result['ci_low']:+.1%}, {result['ci_high']:+.1%}]"
+        print(f"{name:<56} {result['baseline']['mean']:>12.4g} {result['current']['mean']:>12.4g} "
+              f"{result['change']:>+8.1%} {interval:>17}  {result['verdict']}")
+        if result["verdict"] == "regression":
+            regressions.append(name)
+    return regressions
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    def add_run_options(command):
+        command.add_argument("--binary", help="path to benchmark_environment")
+        command.add_argument("--suites", default="cpp,python",
+                             type=lambda text: set(text.split(",")),
+                             help="comma-separated suites to run (cpp, python)")
+        command.add_argument("--repetitions", type=int, default=5,
+                             help="samples per scenario (default 5)")
+        command.add_argument("--label", default="", help="free text stored with the results")
+
+    record = commands.add_parser("record", help="run the suites and write a baseline")
+    add_run_options(record)
+    record.add_argument("-o", "--output", required=True, help="baseline JSON to write")
+
+    compare = commands.add_parser("compare", help="run the suites and compare to a baseline")
+    add_run_options(compare)
+    compare.add_argument("baseline", help="baseline JSON written by record")
+    compare.add_argument("--results", help="compare this results JSON instead of running")
+    compare.add_argument("--save", help="also write the new results to this path")
+    compare.add_argument("--threshold", type=float, default=0.05,
+                         help="fractional throughput drop that fails (default 0.05)")
+
+    args = parser.parse_args(argv)
+    unknown = args.suites - {"cpp", "python"} if hasattr(args, "suites") else set()
+    if unknown:
+        parser.error(f"unknown suites: {', '.join(sorted(unknown))}")
+    if args.repetitions < 2:
+        parser.error("--repetitions must be at least 2 for confidence intervals")
+
+    if args.command == "record":
+        write_json(args.output, run_suites(args))
+        print(f"baseline written to {args.output}", file=sys.stderr)
+        return 0
+
+    with open(args.baseline) as source:
+        baseline = json.load(source)
+    if args.results:
+        with open(args.results) as source:
+            current = json.load(source)
+    else:
+        current = run_suites(args)
+    if args.save:
+        write_json(args.save, current)
+    if baseline.get("cpp_args") != current.get("cpp_args"):
+        print("warning: the C++ workload differs from the baseline's", file=sys.stderr)
+    if baseline.get("machine", {}).get("host") != current.get("machine", {}).get("host"):
+        print("warning: the baseline was recorded on another machine", file=sys.stderr)
+
+    print(f"baseline {baseline.get('revision') or '?'}, current {current.get('revision') or '?'}, "
+          f"threshold {args.threshold:.0%}")
+    regressions = print_comparison(baseline, current, args.threshold)
+    if regressions:
+        print(f"{len(regressions)} scenario(s) regressed", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,39 @@
+"""
+Record a run natively, then replay it from the trajectory file.
+
+The simulation never calls back into Python: frames are captured in C++
+and written by the recorder's background thread. The replay reads the
+memory-mapped file and draws each frame with one scatter call per layer.
+"""
+
+import sys
+
+import matplotlib.pyplot as plt
+from simevopy import Environment, FoodRegion, TrajectoryRecorder
+from utils.common import setup_base_organism
+from utils.trajectory import TrajectoryReader
+
+path = sys.argv[1] if len(sys.argv) > 1 else "run.trajectory"
+
+env = Environment(1000, 1000)
+setup_base_organism(env, 50)
+env.distribute_food(FoodRegion(0, 0, 1000, 1000, 300))
+with TrajectoryRecorder(path, env.get_width(), env.get_height(), interval=5) as recorder:
+    env.set_recorder(recorder)
+    env.simulate_iteration(500)
+    env.set_recorder(None)
+
+reader = TrajectoryReader(path)
+print(f"{len(reader)} frames, ticks {reader.ticks[0]}..{reader.ticks[-1]}")
+for frame in reader:
+    plt.clf()
+    food = frame["food_positions"]
+    plt.scatter(food[:, 0], food[:, 1], s=1, color="green", label="Food")
+    positions = frame["positions"]
+    plt.scatter(positions[:, 0], positions[:, 1], s=frame["size"] ** 2, color="blue",
+                alpha=0.5, label="Organisms")
+    plt.xlim(0, reader.width)
+    plt.ylim(0, reader.height)
+    plt.title(f"Tick {frame['tick']}: {len(positions)} organisms, {frame['eaten']} eaten")
+    plt.legend()
+    plt.pause(0.01)
@@ -0,0 +1,51 @@
+"""
+Example: Rule-Based Behavior Strategies
+
+The herbivore/predator species from custom_behavior.py expressed as rule
+tables. The rules are evaluated in C++, so no Python runs inside the
+simulation loop and reactions are spread across worker threads.
+"""
+
+import random
+
+from simevopy import (Environment, Food, Genes, ObjectKind, Organism, Policy, Rule,
+                      RuleBasedStrategy)
+
+
+def main():
+    env = Environment(500, 500, threads=4)
+
+    # Herbivores: flee any organism within 20, otherwise seek and eat food
+    herbivore = Policy(rules=RuleBasedStrategy([
+        Rule(target=ObjectKind.ORGANISM, range=20, weight=-10),
+        Rule(target=ObjectKind.FOOD, weight=1, consume=True),
+    ]))
+
+    # Predators: ignore food, chase and eat organisms 1.2x smaller
+    predator = Policy(rules=RuleBasedStrategy([
+        Rule(target=ObjectKind.ORGANISM, max_size_ratio=1 / 1.2, weight=1, consume=True),
+    ]))
+
+    for _ in range(15):
+        dna = chr(60) + chr(15) + chr(80) + chr(0)  # fast, small, aware
+        org = Organism(Genes(dna), herbivore)
+        env.add_organism(org, random.uniform(10, 490), random.uniform(10, 490))
+
+    for _ in range(5):
+        dna = chr(30) + chr(80) + chr(60) + chr(0)  # slow, big, moderate awareness
+        org = Organism(Genes(dna), predator)
+        env.add_organism(org, random.uniform(10, 490), random.uniform(10, 490))
+
+    for _ in range(30):
+        env.add_food(Food(), random.uniform(10, 490), random.uniform(10, 490))
+
+    env.simulate_iteration(200)
+
+    print(f"\nAfter 200 iterations:")
+    print(f"  Surviving organisms: {len(env.get_all_organisms())}")
+    print(f"  Food consumed: {env.get_food_consumption_in_iteration()}")
+    print(f"  Dead organisms: {len(env.get_dead_organisms())}")
+
+
+if __name__ == "__main__":
+    main()
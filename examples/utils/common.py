@@ -1,5 +1,5 @@
 import random 
-from simevopy import Environment, Food, Genes, Organism
+from simevopy import Environment, Genes, Organism
 
 def setup_base_organism(env: Environment, count=20, start=(0, 0), end=(1000, 1000)):
     if end == (0, 0):
@@ -22,11 +22,9 @@ def distribute_food_randomly(env: Environment, food_count=50, start=(0, 0), end=
     if end[0] < start[0] or end[1] < start[1]:
         raise ValueError("End point should be greater than start point")
 
-    for _ in range(food_count):
-        x = random.randint(start[0], end[0] - 1)
-        y = random.randint(start[1], end[1] - 1)
-
-        env.add_food(Food(), x, y)
+    xs = [random.randint(start[0], end[0] - 1) for _ in range(food_count)]
+    ys = [random.randint(start[1], end[1] - 1) for _ in range(food_count)]
+    env.add_foods(xs, ys)
 
 def reproduce_organisms(env: Environment):
     organisms = env.get_all_organisms()
@@ -36,6 +34,4 @@ def reproduce_organisms(env: Environment):
             env.add_organism(new_org, org.get_position()[0], org.get_position()[1])
 
 def remove_all_foods(env: Environment):
-    remaining_food = env.get_all_foods()
-    for f in remaining_food:
-        env.remove_food(f)
+    env.remove_all_foods()
@@ -0,0 +1,117 @@
+"""Observer for the shared-memory segment published by simevopy.LiveFeed.
+
+Attach from any process with the feed's name and call sample() as often as
+needed; the simulation never waits for readers. See include/core/LiveFeed.hpp
+for the layout and the seqlock protocol.
+"""
+from multiprocessing import resource_tracker, shared_memory
+
+import numpy as np
+
+SEGMENT_HEADER = np.dtype([
+    ("magic", "S8"), ("version", np.uint32), ("interval", np.uint32),
+    ("organism_capacity", np.uint32), ("food_capacity", np.uint32),
+    ("buffer_bytes", np.uint64), ("published", np.uint64), ("active", np.uint32),
+    ("width", np.float32), ("height", np.float32), ("reserved", np.uint32, 3),
+])
+BUFFER_HEADER = np.dtype([
+    ("sequence", np.uint64), ("tick", np.uint64), ("version", np.uint64),
+    ("organisms", np.uint32), ("foods", np.uint32), ("organism_rows", np.uint32),
+    ("food_rows", np.uint32), ("food_consumed", np.uint32), ("reserved", np.uint32, 5),
+])
+ORGANISM_COLUMNS = ["x", "y", "speed", "size", "awareness", "life_span"]
+FOOD_COLUMNS = ["food_x", "food_y"]
+
+
+def _attach(name):
+    try:
+        return shared_memory.SharedMemory(name=name, track=False)
+    except TypeError:
+        # Before Python 3.13 every attachment is registered with the resource
+        # tracker, which would unlink the simulation's segment when we exit
+        segment = shared_memory.SharedMemory(name=name)
+        resource_tracker.unregister(segment._name, "shared_memory")
+        return segment
+
+
+class LiveFeedReader:
+    """Consistent samples of the latest publication of a LiveFeed.
+
+    The seqlock check relies on loads not being reordered across each other,
+    which holds for NumPy reads on x86-64; on weakly ordered CPUs a torn
+    sample is possible but rare, and the next sample is correct again.
+    """
+
+    def __init__(self, name, retries=1000):
+        self._segment = _attach(name.lstrip("/"))
+        self._header = np.ndarray((), SEGMENT_HEADER, self._segment.buf, 0)
+        if self._header["magic"] != b"SIMEVOLF":
+            self.close()
+            raise ValueError(f"{name} is not a SimEvo live feed")
+        if self._header["version"] != 1:
+            version = int(self._header["version"])
+            self.close()
+            raise ValueError(f"Unsupported live feed version {version}")
+        self.retries = retries
+        self.interval = int(self._header["interval"])
+        self.organism_capacity = int(self._header["organism_capacity"])
+        self.food_capacity = int(self._header["food_capacity"])
+        buffer_bytes = int(self._header["buffer_bytes"])
+        self._buffers = [SEGMENT_HEADER.itemsize + b * buffer_bytes for b in (0, 1)]
+        self._sequences = [np.ndarray((), np.uint64, self._segment.buf, offset)
+                           for offset in self._buffers]
+
+    @property
+    def published(self):
+        """Number of publications so far; poll it to detect new data cheaply."""
+        return int(self._header["published"])
+
+    def sample(self):
+        """Copy the latest publication into a dict of arrays and counters.
+
+        food_consumed counts the food eaten since the previous publication,
+        not a running total. Returns None before the first publication.
+        Raises RuntimeError if no consistent copy could be taken within the
+        retry budget.
+        """
+        if self.published == 0:
+            return None
+        for _ in range(self.retries):
+            active = int(self._header["active"])
+            before = int(self._sequences[active])
+            if before % 2:
+                continue
+            sample = self._copy(self._buffers[active])
+            if int(self._sequences[active]) == before:
+                return sample
+        raise RuntimeError("LiveFeed: no consistent sample; the writer is too fast")
+
+    def _copy(self, offset):
+        buf = self._segment.buf
+        header = np.ndarray((), BUFFER_HEADER, buf, offset).copy()
+        sample = {name: int(header[name]) for name in
+                  ("tick", "version", "organisms", "foods", "food_consumed")}
+        sample["width"] = float(self._header["width"])
+        sample["height"] = float(self._header["height"])
+        cursor = offset + BUFFER_HEADER.itemsize
+        rows = min(int(header["organism_rows"]), self.organism_capacity)
+        for name in ORGANISM_COLUMNS:
+            sample[name] = np.ndarray(rows, np.float32, buf, cursor).copy()
+            cursor += self.organism_capacity * 4
+        rows = min(int(header["food_rows"]), self.food_capacity)
+        for name in FOOD_COLUMNS:
+            sample[name] = np.ndarray(rows, np.float32, buf, cursor).copy()
+            cursor += self.food_capacity * 4
+        return sample
+
+    def close(self):
+        # Views must be released before the mapping can be closed
+        self._header = None
+        self._sequences = []
+        self._segment.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
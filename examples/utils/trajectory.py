@@ -0,0 +1,140 @@
+"""Reader for trajectory files written by simevopy.TrajectoryRecorder.
+
+The file is memory-mapped; every column is a zero-copy NumPy view into it.
+See include/core/TrajectoryRecorder.hpp for the layout.
+"""
+import numpy as np
+
+FILE_HEADER = np.dtype([
+    ("magic", "S8"), ("version", np.uint32), ("interval", np.uint32),
+    ("width", np.float32), ("height", np.float32),
+    ("chunk_frames", np.uint32), ("reserved", np.uint32),
+])
+CHUNK_HEADER = np.dtype([
+    ("magic", "S4"), ("frames", np.uint32), ("organism_rows", np.uint32),
+    ("introduced_rows", np.uint32), ("food_added_rows", np.uint32),
+    ("food_removed_rows", np.uint32), ("payload_bytes", np.uint64),
+])
+FRAME_COLUMNS = ["organisms", "introduced", "food_added", "food_removed",
+                 "births", "deaths", "eaten"]
+
+
+def _offsets(counts):
+    return np.concatenate((np.zeros(1, np.int64), np.cumsum(counts, dtype=np.int64)))
+
+
+class Chunk:
+    """Columns of one chunk; row columns span all of its frames."""
+
+    def __init__(self, data, offset):
+        header = np.frombuffer(data, CHUNK_HEADER, 1, offset)[0]
+        if header["magic"] != b"CHNK":
+            raise ValueError(f"Corrupt trajectory: no chunk at byte {offset}")
+        self.frames = int(header["frames"])
+        self.end = offset + CHUNK_HEADER.itemsize + int(header["payload_bytes"])
+        cursor = offset + CHUNK_HEADER.itemsize
+
+        def take(dtype, count):
+            nonlocal cursor
+            column = np.frombuffer(data, dtype, count, cursor)
+            cursor += column.nbytes
+            return column
+
+        self.tick = take(np.uint64, self.frames)
+        for name in FRAME_COLUMNS:
+            setattr(self, name, take(np.uint32, self.frames))
+        rows = int(header["organism_rows"])
+        self.ids, self.x, self.y = take(np.uint32, rows), take(np.float32, rows), take(np.float32, rows)
+        self.life_span = take(np.float32, rows)
+        rows = int(header["introduced_rows"])
+        self.introduced_ids = take(np.uint32, rows)
+        self.speed, self.size = take(np.float32, rows), take(np.float32, rows)
+        self.awareness = take(np.float32, rows)
+        rows = int(header["food_added_rows"])
+        self.food_added_ids = take(np.uint32, rows)
+        self.food_x, self.food_y = take(np.float32, rows), take(np.float32, rows)
+        self.food_removed_ids = take(np.uint32, int(header["food_removed_rows"]))
+
+        # Row offsets of every frame within the row columns
+        self.organism_offsets = _offsets(self.organisms)
+        self.introduced_offsets = _offsets(self.introduced)
+        self.added_offsets = _offsets(self.food_added)
+        self.removed_offsets = _offsets(self.food_removed)
+
+
+class TrajectoryReader:
+    """Random access to the frames of a trajectory file.
+
+    Organism columns of a frame are views into the file. Traits and food
+    are delta-encoded, so a frame is rebuilt by replaying its chunk from the
+    keyframe; iterating in order replays each frame once.
+    """
+
+    def __init__(self, path):
+        self.data = np.memmap(path, dtype=np.uint8, mode="r")
+        header = np.frombuffer(self.data, FILE_HEADER, 1, 0)[0]
+        if header["magic"] != b"SIMEVOTJ":
+            raise ValueError(f"{path} is not a SimEvo trajectory")
+        if header["version"] != 1:
+            raise ValueError(f"Unsupported trajectory version {header['version']}")
+        self.interval = int(header["interval"])
+        self.width = float(header["width"])
+        self.height = float(header["height"])
+
+        self.chunks = []
+        offset = FILE_HEADER.itemsize
+        while offset < len(self.data):
+            chunk = Chunk(self.data, offset)
+            self.chunks.append(chunk)
+            offset = chunk.end
+        self.chunk_starts = np.cumsum([0] + [c.frames for c in self.chunks])
+
+    def __len__(self):
+        return int(self.chunk_starts[-1])
+
+    @property
+    def ticks(self):
+        return np.concatenate([c.tick for c in self.chunks]) if self.chunks else np.empty(0, np.uint64)
+
+    def frame(self, index):
+        if not 0 <= index < len(self):
+            raise IndexError(index)
+        c = int(np.searchsorted(self.chunk_starts, index, side="right")) - 1
+        for local, frame in enumerate(self._replay(self.chunks[c])):
+            if local == index - self.chunk_starts[c]:
+                return frame
+
+    def __iter__(self):
+        for chunk in self.chunks:
+            yield from self._replay(chunk)
+
+    def _replay(self, chunk):
+        traits = {}
+        foods = {}
+        for f in range(chunk.frames):
+            lo, hi = chunk.introduced_offsets[f], chunk.introduced_offsets[f + 1]
+            for i in range(lo, hi):
+                traits[int(chunk.introduced_ids[i])] = (
+                    chunk.speed[i], chunk.size[i], chunk.awareness[i])
+            for i in chunk.food_removed_ids[chunk.removed_offsets[f]:chunk.removed_offsets[f + 1]]:
+                foods.pop(int(i), None)
+            lo, hi = chunk.added_offsets[f], chunk.added_offsets[f + 1]
+            for i in range(lo, hi):
+                foods[int(chunk.food_added_ids[i])] = (chunk.food_x[i], chunk.food_y[i])
+
+            lo, hi = chunk.organism_offsets[f], chunk.organism_offsets[f + 1]
+            ids = chunk.ids[lo:hi]
+            organism_traits = np.array([traits[int(i)] for i in ids], dtype=np.float32).reshape(-1, 3)
+            yield {
+                "tick": int(chunk.tick[f]),
+                "ids": ids,
+                "positions": np.stack([chunk.x[lo:hi], chunk.y[lo:hi]], axis=1),
+                "life_span": chunk.life_span[lo:hi],
+                "speed": organism_traits[:, 0],
+                "size": organism_traits[:, 1],
+                "awareness": organism_traits[:, 2],
+                "food_positions": np.array(list(foods.values()), dtype=np.float32).reshape(-1, 2),
+                "births": int(chunk.births[f]),
+                "deaths": int(chunk.deaths[f]),
+                "eaten": int(chunk.eaten[f]),
+            }
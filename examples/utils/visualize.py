@@ -1,5 +1,6 @@
 import matplotlib.pyplot as plt
 import numpy as np
+from simevopy import RenderLayer
 
 def visualize_objects(env, title="Objects Distribution"):
     # Get all eatable foods
@@ -52,3 +53,24 @@ def visualize_objects(env, title="Objects Distribution"):
     plt.pause(0.005)
     # input("Press Enter to continue...")
 
+
+def render_objects(env, title="Objects Distribution", resolution=512, threads=0):
+    """Draw the environment from a native raster instead of one artist per object.
+
+    Cost depends on the image size, not the population, so this stays
+    interactive for populations where visualize_objects() does not.
+    """
+    image = env.render(
+        resolution,
+        resolution,
+        [RenderLayer.FOOD, RenderLayer.SIZE, RenderLayer.AWARENESS],
+        threads=threads,
+        rgba=True,
+    )
+    plt.clf()
+    plt.imshow(image, origin="lower", extent=(0, env.get_width(), 0, env.get_height()))
+    plt.xlabel("X")
+    plt.ylabel("Y")
+    plt.title(title)
+    plt.draw()
+    plt.pause(0.005)
@@ -0,0 +1,87 @@
+#ifndef ENSEMBLE_RUNNER_HPP
+#define ENSEMBLE_RUNNER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Environment.hpp"
+
+/**
+ * @brief Summary of one environment after an EnsembleRunner::run() call.
+ *
+ * Trait means are taken over the organisms alive at the end of the run and
+ * are 0 when none survived.
+ */
+struct RunSummary {
+    std::size_t organisms = 0;         ///< Living organisms at the end of the run
+    std::size_t foods = 0;             ///< Uneaten food at the end of the run
+    std::size_t deadOrganisms = 0;     ///< Organisms that have died so far
+    unsigned long foodConsumption = 0; ///< Food eaten so far
+    std::size_t species = 0;           ///< Distinct policies, including the default
+    double meanLifeSpan = 0.0;         ///< Mean remaining life-span of survivors
+    double meanSpeed = 0.0;            ///< Mean speed of survivors
+    double meanSize = 0.0;             ///< Mean size of survivors
+    double meanAwareness = 0.0;        ///< Mean awareness of survivors
+    double elapsedMs = 0.0;            ///< Wall-clock time spent simulating this environment
+};
+
+/**
+ * @brief Advances many independent environments in parallel.
+ *
+ * Intended for parameter sweeps and replicate runs: each environment is
+ * simulated on its own worker thread (environments share no state), so
+ * throughput scales with cores as long as the environments themselves run
+ * single-threaded. Workers pull the next environment from a shared counter,
+ * which balances runs of uneven cost.
+ */
+class EnsembleRunner {
+public:
+    /**
+     * @brief Create an empty ensemble.
+     * @param numThreads Worker threads; 0 uses std::thread::hardware_concurrency().
+     */
+    explicit EnsembleRunner(int numThreads = 0);
+
+    /**
+     * @brief Add an environment to the ensemble.
+     * @param environment Environment to advance on every run().
+     * @return Index of the environment, also its position in run() results.
+     * @throws std::invalid_argument If environment is null.
+     */
+    std::size_t add(std::shared_ptr<Environment> environment);
+
+    /**
+     * @brief Get an environment by index.
+     * @throws std::out_of_range If index >= size().
+     */
+    const std::shared_ptr<Environment> &get(std::size_t index) const;
+
+    /** @brief Number of environments in the ensemble. */
+    std::size_t size() const { return environments.size(); }
+
+    /** @brief Number of worker threads used by run(). */
+    int getNumThreads() const { return numThreads; }
+
+    /** @brief Remove all environments. */
+    void clear() { environments.clear(); }
+
+    /**
+     * @brief Simulate every environment for the given number of iterations.
+     * @param iterations Iterations passed to each Environment::simulateIteration().
+     * @return One summary per environment, in insertion order.
+     *
+     * If a simulation throws, the remaining environments still finish and
+     * the first exception (in environment order) is rethrown afterwards.
+     */
+    std::vector<RunSummary> run(int iterations);
+
+    /** @brief Summarise the current state of an environment. */
+    static RunSummary summarise(const Environment &environment);
+
+private:
+    int numThreads;
+    std::vector<std::shared_ptr<Environment>> environments;
+};
+
+#endif
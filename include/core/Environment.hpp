@@ -3,11 +3,24 @@
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_hash.hpp>
+#include <functional>
 #include <memory>
+#include <random>
+#include <span>
+#include <string>
 #include <unordered_map>
 
+#include "EnvironmentState.hpp"
 #include "Food.hpp"
+#include "GenerationPolicy.hpp"
+#include "LiveFeed.hpp"
 #include "Organism.hpp"
+#include "PopulationStats.hpp"
+#include "Raster.hpp"
+#include "SimulationProfile.hpp"
+#include "SpeciesTable.hpp"
+#include "TrajectoryRecorder.hpp"
+#include "WorkerPool.hpp"
 #include "index/ISpatialIndex.hpp"
 
 /**
@@ -15,15 +28,10 @@
  *
  * Environment owns all simulation objects, delegates spatial lookups to an
  * ISpatialIndex implementation, and drives the interact-react-move lifecycle
- * each iteration. Both phases currently run single-threaded so that Python
- * strategy callbacks can safely acquire the GIL.
- *
- * TODO: Re-enable multi-threaded handleReactions(). The reaction phase only
- * writes to each organism's own movement fields and is inherently parallelizable.
- * When Python callbacks are involved, either release the GIL before spawning
- * worker threads (using py::gil_scoped_release) or detect at runtime whether
- * any organism has a custom strategy and only fall back to single-threaded in
- * that case.
+ * each iteration. The interaction phase runs single-threaded; the reaction
+ * phase is split across numThreads workers unless an organism uses a
+ * std::function reaction strategy, which may be a Python callback that needs
+ * the GIL. Built-in and native (C function pointer) strategies never do.
  */
 class Environment {
 public:
@@ -32,7 +40,7 @@ public:
      * @param width  The horizontal extent of the simulation area.
      * @param height The vertical extent of the simulation area.
      * @param type   Spatial index implementation: "default" or "optimized".
-     * @param numThreads Reserved for future multi-threaded reaction phase.
+     * @param numThreads Worker threads for the reaction phase (see handleReactions()).
      * @throws std::invalid_argument If type is not "default" or "optimized".
      */
     Environment(int width, int height, std::string type = "default", int numThreads = 1);
@@ -109,6 +117,299 @@ public:
     void simulateIteration(int iterations,
                            std::function<void(const Environment&)> on_each_iteration = nullptr);
 
+    /**
+     * @brief Run a whole evolutionary experiment without leaving C++.
+     * @param generations Number of generations to run.
+     * @param iterationsPerGeneration simulateIteration() steps per generation.
+     * @param policy Food spawning, reproduction and food reset rules.
+     * @param on_each_generation Optional callback invoked with the generation
+     *        index after its iterations, before reproduction and food reset.
+     * @throws std::invalid_argument If a food region is empty or inverted.
+     * @throws std::out_of_range If a food region exceeds the environment bounds.
+     *
+     * Offspring are placed at their parent's position. Stops early once no
+     * organisms are left.
+     */
+    void simulateGenerations(
+        int generations, int iterationsPerGeneration, const GenerationPolicy &policy,
+        std::function<void(const Environment &, int)> on_each_generation = nullptr);
+
+    /**
+     * @brief Spawn food uniformly at random inside a region.
+     * @param region Rectangle and item count.
+     * @param energy Energy of each spawned food item.
+     * @throws std::invalid_argument If the region is empty or inverted.
+     * @throws std::out_of_range If the region exceeds the environment bounds.
+     */
+    void distributeFood(const FoodRegion &region, int energy = 500);
+
+    /**
+     * @brief Let every organism above a life-span threshold reproduce once.
+     * @param threshold Minimum life-span (exclusive) required to reproduce.
+     * @param maxPopulation Stop adding offspring at this many organisms; 0 means unlimited.
+     * @return Number of offspring added.
+     */
+    std::size_t reproduceOrganisms(float threshold = 1000, std::size_t maxPopulation = 0);
+
+    /**
+     * @brief Remove every food item, eaten or not, in one pass.
+     *
+     * Rebuilds the spatial index from the remaining objects instead of
+     * removing foods one by one, which is linear per item on both indexes.
+     * Eaten food still counts towards getFoodConsumptionInIteration().
+     */
+    void removeAllFoods();
+
+    /**
+     * @brief Add many food items with one bulk spatial-index insertion.
+     * @param xs Horizontal positions.
+     * @param ys Vertical positions, same length as xs.
+     * @param energies Energy per item, same length as xs; empty uses the default 500.
+     * @throws std::invalid_argument If the lengths differ.
+     * @throws std::out_of_range If any position is out of bounds (nothing is added).
+     */
+    void addFoods(std::span<const float> xs, std::span<const float> ys,
+                  std::span<const int> energies = {});
+
+    /**
+     * @brief Add many organisms with one bulk spatial-index insertion.
+     * @param dna Row-major (N, 4) DNA bytes, one row per organism.
+     * @param xs Horizontal positions, length N.
+     * @param ys Vertical positions, length N.
+     * @param policy Shared policy for all new organisms; nullptr selects the default.
+     * @throws std::invalid_argument If the lengths are inconsistent.
+     * @throws std::out_of_range If any position is out of bounds (nothing is added).
+     */
+    void addOrganisms(std::span<const std::uint8_t> dna, std::span<const float> xs,
+                      std::span<const float> ys,
+                      std::shared_ptr<const Organism::Policy> policy = nullptr);
+
+    /**
+     * @brief Remove every object matching a predicate, rebuilding the index once.
+     * @param predicate Returns true for objects to remove.
+     * @return Number of objects removed.
+     *
+     * Removed objects are dropped, not archived: organisms do not appear in
+     * getDeadOrganisms() and food does not count as consumed.
+     */
+    std::size_t removeWhere(const std::function<bool(const EnvironmentObject &)> &predicate);
+
+    /**
+     * @brief Remove every object of one kind, rebuilding the index once.
+     * @param kind Kind of objects to remove.
+     * @return Number of objects removed.
+     */
+    std::size_t removeKind(ObjectKind kind);
+
+    /**
+     * @brief Seed the random generator used for food placement.
+     * @param seed Any value; equal seeds reproduce the same food layouts.
+     */
+    void setSeed(unsigned int seed) { rng.seed(seed); }
+
+    /**
+     * @brief Fork an independent copy of this environment.
+     * @return A new environment in the same state, with the same object ids.
+     * @throws std::runtime_error If a CUSTOM object is present (it cannot be copied from C++).
+     *
+     * Organisms and food are deep-copied and the spatial index is copied
+     * structurally, without re-inserting anything. Immutable data is shared:
+     * policies (and with them all strategies), mutation functions and the
+     * archive of dead organisms. Statistics, counters and the RNG state are
+     * copied, so both environments continue identically until they diverge.
+     */
+    std::unique_ptr<Environment> clone() const;
+
+    /// Version of the binary format written by encodeSnapshot(); bumped on layout changes.
+    static constexpr std::uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+
+    /// Policies to re-attach on load, indexed by the species id saved with each organism.
+    using PolicyTable = std::span<const std::shared_ptr<const Organism::Policy>>;
+
+    /**
+     * @brief Encode the full simulation state in the binary snapshot format.
+     * @return The encoded bytes.
+     * @throws std::runtime_error If a CUSTOM object is present (it may carry Python state).
+     *
+     * Saved are dimensions, index type, thread count, every organism (id,
+     * position, DNA, life-span, movement, species id) including the dead ones,
+     * every food item, the consumption and tick counters and the food placement
+     * RNG state. Each column is written contiguously so decoding is a sequence
+     * of block copies. Behaviour policies and custom mutation functions are code,
+     * not data: they are not saved, see decodeSnapshot().
+     */
+    std::string encodeSnapshot() const;
+
+    /**
+     * @brief Replace the whole environment with a decoded snapshot.
+     * @param bytes Output of encodeSnapshot().
+     * @param policies Optional policies by saved species id; organisms whose id
+     *        has no entry (or a null one) get Organism::defaultPolicy().
+     * @throws std::runtime_error If the bytes are not a valid snapshot of a
+     *         supported format version. The environment is left unchanged.
+     *
+     * The statistics are rebuilt from the restored objects; the tick history
+     * starts empty.
+     */
+    void decodeSnapshot(std::span<const char> bytes, PolicyTable policies = {});
+
+    /**
+     * @brief Whether decoding the snapshot without policies reproduces this environment.
+     * @return False if a living organism has a non-default policy or a custom
+     *         mutation function; those only survive when passed back to decodeSnapshot().
+     */
+    bool isSnapshotSelfContained() const;
+
+    /**
+     * @brief Write encodeSnapshot() to a file.
+     * @param path Destination file, overwritten if present.
+     * @throws std::runtime_error If encoding fails or the file cannot be written.
+     */
+    void saveSnapshot(const std::string &path) const;
+
+    /**
+     * @brief Restore a snapshot file written by saveSnapshot().
+     * @param path Snapshot file; memory-mapped and decoded in place where supported.
+     * @param policies See decodeSnapshot().
+     * @throws std::runtime_error If the file cannot be read or is not a valid snapshot.
+     */
+    void loadSnapshot(const std::string &path, PolicyTable policies = {});
+
+    /**
+     * @brief Get a column-oriented snapshot of every object.
+     * @return Shared immutable state; the same instance is returned until the
+     *         environment is next mutated through its own methods.
+     *
+     * Changes made directly on objects (e.g. Organism::addLifeSpan() from a
+     * script) do not bump the version; they show up after the next tick or
+     * add/remove. Not safe to call concurrently with a running simulation.
+     */
+    std::shared_ptr<const EnvironmentState> getState() const;
+
+    /**
+     * @brief Rasterise the environment into float image planes.
+     * @param widthPx Image width in pixels; the environment width maps onto it.
+     * @param heightPx Image height in pixels.
+     * @param layers Quantity of each plane, in output order.
+     * @param numThreads Threads splitting the image into row bands; 0 uses all cores.
+     * @return The planes; see Raster.
+     * @throws std::invalid_argument If a dimension is not positive or layers is empty.
+     *
+     * Positions are gathered once; each band then scans them and draws only
+     * its own rows, so bands never write the same pixel.
+     */
+    Raster render(int widthPx, int heightPx, const std::vector<RenderLayer> &layers,
+                  int numThreads = 1) const;
+
+    /**
+     * @brief Get the incrementally maintained population statistics.
+     *
+     * Trait statistics follow objects as they are added and removed; dead
+     * organisms and eaten food leave at the end of simulateIteration(). The
+     * history holds one sample per simulated tick.
+     */
+    const PopulationStats &getStats() const { return stats; }
+
+    /**
+     * @brief Resize the per-tick history ring buffer, dropping recorded samples.
+     * @throws std::invalid_argument If capacity is 0.
+     */
+    void setStatsHistoryCapacity(std::size_t capacity) { stats.setHistoryCapacity(capacity); }
+
+    /** @brief Get the number of ticks simulated since construction. */
+    std::uint64_t getTickCount() const { return ticks; }
+
+    /**
+     * @brief Record sampled frames of every following tick.
+     * @param recorder Recorder to feed after each tick, or nullptr to stop recording.
+     *
+     * Capture runs on the simulating thread right after post-iteration; the
+     * recorder's writer thread does the encoding and I/O. Clones and restored
+     * snapshots do not inherit the recorder.
+     */
+    void setRecorder(std::shared_ptr<TrajectoryRecorder> recorder) {
+        this->recorder = std::move(recorder);
+    }
+
+    /** @brief Get the attached trajectory recorder, if any. */
+    const std::shared_ptr<TrajectoryRecorder> &getRecorder() const { return recorder; }
+
+    /**
+     * @brief Publish sampled state to shared memory after every following tick.
+     * @param feed Feed to fill after each tick, or nullptr to stop publishing.
+     *
+     * Publishing runs on the simulating thread right after the recorder, if
+     * any. Clones do not inherit the feed.
+     */
+    void setLiveFeed(std::shared_ptr<LiveFeed> feed) { liveFeed = std::move(feed); }
+
+    /** @brief Get the attached live feed, if any. */
+    const std::shared_ptr<LiveFeed> &getLiveFeed() const { return liveFeed; }
+
+    /**
+     * @brief Record a timeline of the following runs for dumpTrace().
+     * @param capacity Most recent zone spans to keep (ticks, phases, reaction
+     *        workers, index rebuilds, callbacks, GIL waits); 0 stops tracing
+     *        and drops the timeline.
+     *
+     * Spans come from the PROFILE_ZONE scopes that run on behalf of this
+     * environment, on whichever thread runs them. Clones do not inherit the
+     * timeline.
+     */
+    void setTracing(std::size_t capacity);
+
+    /** @brief Get the timeline being recorded, or nullptr when not tracing. */
+    const std::shared_ptr<TraceBuffer> &getTrace() const { return trace; }
+
+    /**
+     * @brief Write the recorded timeline as Chrome trace-event JSON.
+     * @param path Output file, overwritten if present; open it in a trace viewer.
+     * @throws std::runtime_error If tracing is off or the file cannot be written.
+     */
+    void dumpTrace(const std::string &path) const;
+
+    /**
+     * @brief Count hardware events (cycles, instructions, cache and branch
+     *        misses) around each phase of the following runs.
+     * @param enabled Whether to count; off by default.
+     * @return Whether any counter can be opened in this process. When none
+     *         can (no PMU, perf_event_paranoid, non-Linux) runs proceed
+     *         without counters.
+     *
+     * Counters are opened on the thread calling simulateIteration() and
+     * include the reaction workers it starts; the interaction, reaction,
+     * post-iteration and clean-up zones of getProfile() carry the sums.
+     */
+    bool setHardwareCounters(bool enabled);
+
+    /**
+     * @brief Get this environment's cumulative profile.
+     *
+     * Per-zone totals and latency quantiles (ticks, phases, workers, ...),
+     * neighbour-query counts with a neighbours-per-query distribution, and
+     * objects processed per phase, and the cost of every strategy call by
+     * policy (see StrategyProfile), accumulated across simulateIteration()
+     * calls until resetProfile(). Only work done for this environment is
+     * counted, even with other environments running concurrently.
+     */
+    SimulationProfile getProfile() const;
+
+    /** @brief Zero the cumulative profile. */
+    void resetProfile() { profile->clear(); }
+
+    /**
+     * @brief Visit every object without copying shared pointers.
+     * @param visit Called with a const reference to each object; must not add
+     *        or remove objects.
+     */
+    template <typename F>
+    void forEachObject(F &&visit) const {
+        for (const auto &object : objectsMapper) visit(*object.second);
+    }
+
+    /** @brief Get a counter that increases whenever the environment changes. */
+    std::uint64_t getVersion() const { return version; }
+
     /** @brief Get all living organisms currently in the environment. */
     std::vector<std::shared_ptr<Organism>> getAllOrganisms() const;
 
@@ -124,6 +425,22 @@ public:
     /** @brief Get the total number of food items consumed across all iterations. */
     unsigned long getFoodConsumptionInIteration() const;
 
+    /** @brief Get the number of food items eaten during the most recent tick. */
+    std::uint64_t getFoodEatenInTick() const { return foodEatenInTick; }
+
+    /** @brief Get the number of distinct organism policies (species), including the default. */
+    std::size_t getSpeciesCount() const { return species.size(); }
+
+    /**
+     * @brief Check whether simulating this environment may run Python code.
+     * @return true if any organism requiresGil() or any CUSTOM object (which
+     *         may be a Python subclass overriding postIteration) is present.
+     *
+     * Bindings use this to decide whether the GIL can be released for the
+     * duration of simulateIteration().
+     */
+    bool requiresGil() const;
+
 private:
     int width, height;
     std::string type;  ///< Spatial index type identifier ("default" or "optimized")
@@ -131,13 +448,46 @@ private:
     /// Maps object UUIDs to their shared pointers for O(1) lookup
     std::unordered_map<boost::uuids::uuid, std::shared_ptr<EnvironmentObject>> objectsMapper;
 
+    SpeciesTable species;  ///< Shared organism policies, indexed by species id
+    ReactionBatch reactionBatch;  ///< Reused buffer for batched reaction strategies
+
     std::vector<std::shared_ptr<Organism>> deadOrganisms;  ///< Accumulated dead organisms
     unsigned long foodConsumption = 0;                      ///< Running food consumption counter
+    /// foodConsumption plus eaten food awaiting clean-up, at the end of the last tick
+    std::uint64_t foodEatenTotal = 0;
+    std::uint64_t foodEatenInTick = 0;  ///< See getFoodEatenInTick()
 
-    // TODO: use numThreads to re-enable multi-threaded handleReactions()
-    int numThreads = 1;  ///< Reserved for future multi-threaded reaction phase
+    int numThreads = 1;  ///< Worker threads for the reaction phase
+    /// Reaction-phase threads, started on first use and kept for later ticks
+    std::unique_ptr<WorkerPool> reactionWorkers;
     bool verbose = false;
 
+    std::mt19937 rng{std::random_device{}()};  ///< Food placement randomness
+
+    PopulationStats stats;    ///< Incremental population statistics and tick history
+    std::uint64_t ticks = 0;  ///< Ticks simulated since construction
+    std::shared_ptr<TrajectoryRecorder> recorder;  ///< Optional per-tick frame recorder
+    std::shared_ptr<LiveFeed> liveFeed;            ///< Optional shared-memory publisher
+    std::shared_ptr<TraceBuffer> trace;            ///< Optional timeline of zone spans
+    bool hardwareCounters = false;                 ///< Count hardware events per phase
+    std::unique_ptr<ProfileCounters> profile = std::make_unique<ProfileCounters>();
+
+    std::uint64_t version = 0;  ///< Bumped by every mutation, see getState()
+    mutable std::shared_ptr<const EnvironmentState> cachedState;  ///< Last getState() result
+
+    /** @brief Record a mutation, invalidating the cached state. */
+    void touch() { version++; }
+
+    /**
+     * @brief Create the spatial index named by type for a width x height area.
+     * @throws std::invalid_argument If type is not "default" or "optimized".
+     */
+    static std::unique_ptr<ISpatialIndex<boost::uuids::uuid>> createSpatialIndex(
+        const std::string &type, int width, int height);
+
+    /** @brief Re-insert every object of objectsMapper into an emptied spatial index. */
+    void rebuildSpatialIndex();
+
     /**
      * @brief Validate that coordinates fall within environment bounds.
      * @param x Horizontal coordinate.
@@ -149,6 +499,26 @@ private:
     /** @brief Sync organism positions into the spatial index, clamping to bounds. */
     void updatePositionsInSpatialIndex();
 
+    /**
+     * @brief Gather the objects within a radius of an organism, excluding itself.
+     * @param organism The querying organism.
+     * @param radius Query radius around the organism's position.
+     * @param out Cleared and filled with the neighbouring objects.
+     * @param tally Query counts of the calling phase or worker, merged into the profile later.
+     */
+    void collectNeighbours(const Organism& organism, float radius,
+                           std::vector<std::shared_ptr<EnvironmentObject>>& out,
+                           QueryTally& tally);
+
+    /** @brief Profiling destinations that threads working for this environment bind to. */
+    ProfileTargets profileTargets() const { return {trace.get(), &profile->zones}; }
+
+    /** @brief Get an organism's species id, re-interning it if its policy was replaced. */
+    Organism::SpeciesId resolveSpecies(Organism& organism);
+
+    /** @brief Merge a phase's strategy costs, keyed by the policies its species ids stand for. */
+    void mergeStrategies(const StrategyTally& tally);
+
     /**
      * @brief Run the interaction phase: organisms eat food and fight.
      *
@@ -160,17 +530,29 @@ private:
     /**
      * @brief Run the reaction phase: organisms decide movement direction.
      *
-     * Currently runs single-threaded for GIL safety with Python callbacks.
-     * TODO: Re-enable multi-threading -- each organism only writes to its own
-     * movement/reactionCounter fields, so this phase is inherently parallelizable.
+     * Batched species are dispatched once per species. Other organisms only
+     * write to their own movement/reactionCounter fields and are processed by
+     * numThreads workers, falling back to one thread when a std::function
+     * reaction strategy (possibly Python) is involved.
      */
     void handleReactions();
 
+    /**
+     * @brief Run one species' BatchReactionStrategy over all of its living members.
+     * @param strategy The species' batched reaction strategy.
+     * @param members Living organisms of the species.
+     */
+    void reactInBatch(const Organism::BatchReactionStrategy& strategy,
+                      const std::vector<Organism*>& members);
+
     /** @brief Run post-iteration: deduct life consumption, move organisms, update spatial index. */
     void postIteration();
 
     /** @brief Remove dead organisms and eaten food from the active object map. */
     void cleanUp();
+
+    /** @brief Rebuild the species table from living organisms, dropping unused policies. */
+    void compactSpecies();
 };
 
 #endif
@@ -3,16 +3,28 @@
 
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
+#include <cassert>
+#include <cstdint>
 
 #include "Vec2.hpp"
 
+/**
+ * @brief Compact type tag identifying the concrete kind of an EnvironmentObject.
+ *
+ * Lets hot simulation paths branch on object type with a single byte compare
+ * instead of RTTI. Objects constructed directly from EnvironmentObject (e.g.
+ * Python subclasses) are tagged CUSTOM.
+ */
+enum class ObjectKind : std::uint8_t { ORGANISM, FOOD, CUSTOM };
+
 /**
  * @brief Base class for all objects that exist in the simulation environment.
  *
  * Each object has a unique UUID identifier and a 2D position. Derived classes
  * include Organism and Food. Position is stored as Vec2 and is accessible
  * both as Vec2 (getPos/setPos) and as std::pair (getPosition/setPosition)
- * for backward compatibility.
+ * for backward compatibility. Every object also carries an ObjectKind tag so
+ * callers can downcast with as<T>() without going through dynamic_cast.
  */
 class EnvironmentObject {
 public:
@@ -21,12 +33,35 @@ public:
      * @param x Initial x position.
      * @param y Initial y position.
      */
-    EnvironmentObject(float x, float y)
-        : id(boost::uuids::random_generator()()), position(x, y) {}
+    EnvironmentObject(float x, float y) : EnvironmentObject(x, y, ObjectKind::CUSTOM) {}
 
     /** @brief Get the unique identifier of this object. */
     boost::uuids::uuid getId() const { return id; }
 
+    /** @brief Get the concrete kind of this object. */
+    ObjectKind getKind() const { return kind; }
+
+    /**
+     * @brief Downcast to a concrete subclass without RTTI.
+     * @tparam T Organism or Food (any class exposing a static KIND tag).
+     * @return Pointer to this object as T.
+     *
+     * The caller must have checked getKind() == T::KIND beforehand; the cast
+     * itself is a plain static_cast.
+     */
+    template <typename T>
+    T* as() {
+        assert(kind == T::KIND);
+        return static_cast<T*>(this);
+    }
+
+    /** @brief Const overload of as<T>(). */
+    template <typename T>
+    const T* as() const {
+        assert(kind == T::KIND);
+        return static_cast<const T*>(this);
+    }
+
     virtual ~EnvironmentObject() = default;
 
     /** @brief Called at the end of each simulation iteration. Override in subclasses. */
@@ -48,11 +83,38 @@ public:
     /** @brief Set position from a Vec2. */
     void setPos(Vec2 pos) { position = pos; }
 
+protected:
+    /**
+     * @brief Construct an environment object with an explicit kind tag.
+     * @param x Initial x position.
+     * @param y Initial y position.
+     * @param kind Concrete kind of the derived class.
+     */
+    EnvironmentObject(float x, float y, ObjectKind kind)
+        : id(generateId()), position(x, y), kind(kind) {}
+
 private:
+    friend class Environment;  // Restores ids when loading a snapshot
+
+    /**
+     * @brief Draw a random UUID from a per-thread generator.
+     *
+     * boost's random_generator reads OS entropy on every call; an mt19937
+     * based generator seeded once per thread is about ten times cheaper and
+     * needs no locking.
+     */
+    static boost::uuids::uuid generateId() {
+        static thread_local boost::uuids::random_generator_mt19937 generator;
+        return generator();
+    }
+
     boost::uuids::uuid id;  ///< Unique identifier for spatial-index lookups
 
 protected:
     Vec2 position;  ///< Current position (accessible to subclasses)
+
+private:
+    ObjectKind kind;  ///< Concrete kind, fixed at construction
 };
 
 #endif
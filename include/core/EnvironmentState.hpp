@@ -0,0 +1,39 @@
+#ifndef ENVIRONMENT_STATE_HPP
+#define ENVIRONMENT_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Immutable, column-oriented copy of every object in an Environment.
+ *
+ * One row per object, stored as contiguous row-major arrays so bindings can
+ * expose them as NumPy views without copying. Rows are ordered by kind:
+ * organisms occupy [0, organismCount), food the next foodCount rows, custom
+ * objects the rest. Columns that do not apply to a kind hold 0.
+ *
+ * Environment::getState() shares one instance until the environment is
+ * next mutated, so repeated queries between ticks cost nothing.
+ */
+struct EnvironmentState {
+    /// Number of columns in the traits array: speed, size, awareness.
+    static constexpr int TRAIT_COUNT = 3;
+
+    std::uint64_t version = 0;     ///< Environment version this state was taken at
+    std::size_t organismCount = 0;  ///< Leading organism rows
+    std::size_t foodCount = 0;      ///< Food rows following the organisms
+
+    std::vector<float> positions;          ///< (N, 2) x, y
+    std::vector<std::uint8_t> kinds;       ///< (N) ObjectKind values
+    std::vector<std::uint8_t> alive;       ///< (N) living organism / uneaten food / custom
+    std::vector<float> lifeSpans;          ///< (N) organism life-span
+    std::vector<float> energies;           ///< (N) food energy
+    std::vector<float> traits;             ///< (N, TRAIT_COUNT) organism traits
+    std::vector<std::uint16_t> species;    ///< (N) organism species id
+
+    /** @brief Total number of rows. */
+    std::size_t size() const { return kinds.size(); }
+};
+
+#endif
@@ -20,14 +20,17 @@ enum class FoodState { FRESH, EATEN };
  */
 class Food : public EnvironmentObject {
 public:
+    /// Kind tag used by EnvironmentObject::as<Food>().
+    static constexpr ObjectKind KIND = ObjectKind::FOOD;
+
     /** @brief Construct a Food object at the origin with default energy (500). */
-    Food() : EnvironmentObject(0, 0) {}
+    Food() : EnvironmentObject(0, 0, KIND) {}
 
     /**
      * @brief Construct food with a custom energy value.
      * @param energy The amount of energy this food provides when consumed.
      */
-    explicit Food(int energy) : EnvironmentObject(0, 0), energy(energy) {}
+    explicit Food(int energy) : EnvironmentObject(0, 0, KIND), energy(energy) {}
 
     /**
      * @brief Check whether this food is still available for consumption.
@@ -0,0 +1,40 @@
+#ifndef GENERATION_POLICY_HPP
+#define GENERATION_POLICY_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Axis-aligned rectangle that receives a fixed amount of food each generation.
+ *
+ * Food is placed uniformly at random in [x0, x1) x [y0, y1). Overlapping
+ * regions simply add up, which is how the "oasis" layouts are built.
+ */
+struct FoodRegion {
+    float x0 = 0.0f;        ///< Left edge
+    float y0 = 0.0f;        ///< Top edge
+    float x1 = 0.0f;        ///< Right edge (exclusive)
+    float y1 = 0.0f;        ///< Bottom edge (exclusive)
+    std::size_t count = 0;  ///< Food items added per generation
+};
+
+/**
+ * @brief What Environment::simulateGenerations() does between generations.
+ *
+ * Each generation: spawn food in every region, simulate the iterations,
+ * invoke the per-generation callback, let organisms above the reproduction
+ * threshold reproduce, then remove uneaten food.
+ */
+struct GenerationPolicy {
+    std::vector<FoodRegion> foodRegions;  ///< Where food spawns each generation
+    int foodEnergy = 500;                 ///< Energy of every spawned food item
+
+    bool reproduce = true;               ///< Reproduce organisms at the end of a generation
+    float reproductionThreshold = 1000;  ///< Minimum life-span (exclusive) to reproduce
+    /// Offspring are not added once this many organisms are alive; 0 means unlimited
+    std::size_t maxPopulation = 0;
+
+    bool resetFood = true;  ///< Remove uneaten food at the end of a generation
+};
+
+#endif
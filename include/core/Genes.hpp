@@ -2,6 +2,7 @@
 #define GENES_HPP
 
 #include <functional>
+#include <memory>
 
 /**
  * @brief Encodes the genetic traits of an organism as a 4-byte DNA sequence.
@@ -14,6 +15,8 @@
  *
  * Mutation logic can be customized by providing a MutationFunction. If none
  * is provided, the default adds a small random offset ([-3, +3]) to each byte.
+ * The mutation function is held through a shared immutable pointer, so copying
+ * Genes (once per reproduction) never copies the callable itself.
  */
 class Genes {
 public:
@@ -43,12 +46,19 @@ public:
      */
     char getDNA(int index) const;
 
+    /** @brief Whether the genes mutate with something other than the default logic. */
+    bool hasCustomMutation() const { return mutationLogic != defaultMutation(); }
+
 private:
-    char dna[4];                    ///< The 4-byte DNA sequence
-    MutationFunction mutationLogic; ///< The mutation strategy applied during reproduction
+    char dna[4];  ///< The 4-byte DNA sequence
+    /// The mutation strategy applied during reproduction, shared by a whole lineage
+    std::shared_ptr<const MutationFunction> mutationLogic;
 
     /// @brief Default mutation: adds uniform random offset in [-3, +3] to each byte.
     static void defaultMutationLogic(char dna[4]);
+
+    /// @brief Shared instance wrapping defaultMutationLogic, used by all default genes.
+    static const std::shared_ptr<const MutationFunction> &defaultMutation();
 };
 
 #endif
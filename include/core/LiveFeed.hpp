@@ -0,0 +1,122 @@
+#ifndef LIVE_FEED_HPP
+#define LIVE_FEED_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Environment;
+
+/**
+ * @brief Publishes sampled simulation state into a POSIX shared-memory segment.
+ *
+ * Attach a feed with Environment::setLiveFeed(); every interval-th tick the
+ * simulating thread copies organism positions and traits, food positions and
+ * a few counters straight into the segment. Observer processes map the same
+ * segment read-only and sample it whenever they like, without locks and
+ * without any call back into the simulation.
+ *
+ * Segment layout (native byte order, every block 64-byte aligned):
+ *
+ *   SegmentHeader, then two buffers of bufferBytes each. A buffer is a
+ *   BufferHeader followed by organismCapacity f32 values for each of x, y,
+ *   speed, size, awareness and life_span, then foodCapacity f32 values for
+ *   each of food_x and food_y. Only the first organismRows / foodRows values
+ *   of each column are valid; objects beyond the capacity are not published
+ *   but still counted in organisms / foods.
+ *
+ * Consistency is a seqlock per buffer: the writer fills the buffer that is
+ * not active, making its sequence odd while writing and even when done,
+ * then flips active. A reader reads active, then the buffer's sequence,
+ * copies the columns, and retries if the sequence was odd or changed. With
+ * two buffers a retry only happens when a copy takes longer than a whole
+ * publishing interval.
+ */
+class LiveFeed {
+public:
+    /// Version of the segment layout; bumped on layout changes.
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    /** @brief Leading 64 bytes of the segment. */
+    struct SegmentHeader {
+        char magic[8];                    ///< "SIMEVOLF"
+        std::uint32_t version;            ///< FORMAT_VERSION
+        std::uint32_t interval;           ///< Ticks between publications
+        std::uint32_t organismCapacity;   ///< Rows of each organism column
+        std::uint32_t foodCapacity;       ///< Rows of each food column
+        std::uint64_t bufferBytes;        ///< Size of one buffer, header included
+        std::uint64_t published;          ///< Publications so far (atomic)
+        std::uint32_t active;             ///< Buffer holding the latest publication (atomic)
+        float width;                      ///< Environment width at the last publication
+        float height;                     ///< Environment height at the last publication
+        std::uint32_t reserved[3];
+    };
+
+    /** @brief Leading 64 bytes of each buffer. */
+    struct BufferHeader {
+        std::uint64_t sequence;       ///< Odd while the writer is filling the buffer (atomic)
+        std::uint64_t tick;           ///< Tick the buffer was captured at
+        std::uint64_t version;        ///< Environment::getVersion() at capture
+        std::uint32_t organisms;      ///< Living organisms in the environment
+        std::uint32_t foods;          ///< Edible food in the environment
+        std::uint32_t organismRows;   ///< Valid rows of the organism columns
+        std::uint32_t foodRows;       ///< Valid rows of the food columns
+        std::uint32_t foodConsumed;   ///< Food eaten since the previous publication
+        std::uint32_t reserved[5];
+    };
+
+    /**
+     * @brief Create (or replace) the shared-memory segment and map it.
+     * @param name Segment name, with or without the leading '/'.
+     * @param organismCapacity Maximum organisms published per tick.
+     * @param foodCapacity Maximum food items published per tick.
+     * @param interval Publish every interval-th tick.
+     * @throws std::invalid_argument If the name is empty or contains '/' after
+     *         the first character, or interval is 0.
+     * @throws std::runtime_error If the segment cannot be created or mapped,
+     *         or shared memory is unavailable on this platform.
+     */
+    LiveFeed(const std::string &name, std::uint32_t organismCapacity,
+             std::uint32_t foodCapacity, std::uint32_t interval = 1);
+
+    /** @brief Unmap and unlink the segment; mapped observers keep their view. */
+    ~LiveFeed();
+
+    LiveFeed(const LiveFeed &) = delete;
+    LiveFeed &operator=(const LiveFeed &) = delete;
+
+    /**
+     * @brief Copy the environment into the inactive buffer if tick is a
+     *        multiple of the interval, then make it active.
+     * @param env Environment to sample.
+     * @param tick Current tick number (Environment::getTickCount()).
+     *
+     * Called by Environment after every tick; must not be called concurrently.
+     */
+    void publish(const Environment &env, std::uint64_t tick);
+
+    /** @brief Segment name as passed to shm_open (with the leading '/'). */
+    const std::string &getName() const { return name; }
+
+    /** @brief Total size of the mapped segment in bytes. */
+    std::size_t getSize() const { return size; }
+
+    /** @brief Number of publications so far. */
+    std::uint64_t getPublishedCount() const { return published; }
+
+    /** @brief Ticks between publications. */
+    std::uint32_t getInterval() const { return interval; }
+
+private:
+    std::string name;
+    std::uint32_t organismCapacity;
+    std::uint32_t foodCapacity;
+    std::uint32_t interval;
+    std::size_t bufferBytes = 0;
+    std::size_t size = 0;
+    char *segment = nullptr;
+    std::uint64_t published = 0;
+    std::uint64_t eatenSincePublished = 0;  ///< Food eaten in ticks skipped by the interval
+};
+
+#endif
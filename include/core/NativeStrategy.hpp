@@ -0,0 +1,52 @@
+#ifndef NATIVE_STRATEGY_HPP
+#define NATIVE_STRATEGY_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Plain C ABI for strategies compiled outside the engine (Numba cfunc, cffi, C).
+ *
+ * Native strategies receive flat float arrays instead of C++ objects, so any
+ * language that can produce a C function pointer can implement them. They
+ * never touch the Python interpreter and may be called from worker threads.
+ *
+ * The organism itself is described by SELF_STRIDE floats:
+ *   x, y, speed, size, awareness, lifeSpan
+ *
+ * Each neighbour is described by NEIGHBOUR_STRIDE floats:
+ *   x, y, kind (ObjectKind as float), size (0 unless organism),
+ *   active (1 if alive organism / edible food / custom, else 0),
+ *   value (food energy or organism lifeSpan, else 0)
+ */
+namespace NativeStrategy {
+
+/// Number of floats describing the calling organism.
+constexpr int SELF_STRIDE = 6;
+
+/// Number of floats describing each neighbour.
+constexpr int NEIGHBOUR_STRIDE = 6;
+
+extern "C" {
+
+/**
+ * @brief Native reaction: write a movement direction to direction[0..1].
+ *
+ * direction arrives zero-filled; leaving it at (0, 0) means "no reaction".
+ */
+typedef void (*ReactionFn)(const float *self, const float *neighbours, std::int32_t count,
+                           float *direction);
+
+/**
+ * @brief Native interaction: flag neighbours to consume in consume[0..count).
+ *
+ * consume arrives zero-filled. A non-zero entry eats an edible food (gaining
+ * its energy) or kills a living organism (absorbing its life-span); other
+ * kinds are ignored.
+ */
+typedef void (*InteractionFn)(const float *self, const float *neighbours, std::int32_t count,
+                              std::uint8_t *consume);
+}
+
+}  // namespace NativeStrategy
+
+#endif
@@ -8,6 +8,9 @@
 
 #include "EnvironmentObject.hpp"
 #include "Genes.hpp"
+#include "NativeStrategy.hpp"
+#include "ReactionBatch.hpp"
+#include "RuleBasedStrategy.hpp"
 
 /**
  * @brief A living entity in the simulation that can move, eat, fight, and reproduce.
@@ -19,9 +22,20 @@
  * When no custom strategy is set, built-in defaults are used. Custom strategies
  * are inherited by offspring produced via reproduce(), enabling Python-side
  * behaviour injection that persists across generations.
+ *
+ * Either strategy may also be a native C function pointer (see NativeStrategy),
+ * which runs without the Python GIL and can take part in multi-threaded phases.
+ * A RuleBasedStrategy covers both with a declarative rule table evaluated in C++.
+ *
+ * The strategies and the optional life consumption calculator are bundled in
+ * an immutable Policy shared by every organism of a lineage. Reproduction
+ * copies the policy pointer and species id, never the callables themselves.
  */
 class Organism : public EnvironmentObject {
 public:
+    /// Kind tag used by EnvironmentObject::as<Organism>().
+    static constexpr ObjectKind KIND = ObjectKind::ORGANISM;
+
     /**
      * @brief Callable that computes per-iteration life consumption from organism attributes.
      *
@@ -50,6 +64,60 @@ public:
     using InteractionStrategy = std::function<void(
         Organism &, const std::vector<std::shared_ptr<EnvironmentObject>> &)>;
 
+    /**
+     * @brief Strategy that decides movement for a whole species at once.
+     *
+     * Called once per tick per species with every organism of that species in
+     * @p batch. Must write one (dx, dy) direction per organism into
+     * @p movements, which arrives sized batch.size() and zero-filled; a zero
+     * vector means "no reaction", as with ReactionStrategy.
+     */
+    using BatchReactionStrategy =
+        std::function<void(const ReactionBatch &batch, std::vector<Vec2> &movements)>;
+
+    /**
+     * @brief Immutable bundle of the callables that define a species' behaviour.
+     *
+     * Empty members fall back to the built-in defaults. Policies are shared by
+     * pointer between organisms; Environment assigns each distinct policy a
+     * small species id through its SpeciesTable.
+     */
+    struct Policy {
+        LifeConsumptionCalculator lifeConsumptionCalculator;  ///< Optional custom life drain
+        ReactionStrategy reactionStrategy;                    ///< Optional custom reaction
+        InteractionStrategy interactionStrategy;              ///< Optional custom interaction
+        /// Optional per-species reaction; takes precedence over reactionStrategy in Environment
+        BatchReactionStrategy batchReactionStrategy;
+        NativeStrategy::ReactionFn nativeReaction = nullptr;        ///< Optional C reaction
+        NativeStrategy::InteractionFn nativeInteraction = nullptr;  ///< Optional C interaction
+        /// Optional rule table; used when no callback or native strategy is set
+        std::shared_ptr<const RuleBasedStrategy> rules;
+    };
+
+    /**
+     * @brief Small integer identifying a policy within one Environment.
+     *
+     * An Environment therefore holds at most 65536 distinct live policies;
+     * Environment::add() throws std::length_error beyond that.
+     */
+    using SpeciesId = std::uint16_t;
+
+    /** @brief Get the shared policy with no custom callables. */
+    static const std::shared_ptr<const Policy> &defaultPolicy();
+
+    /**
+     * @brief Get a policy holding only a life consumption calculator.
+     * @param calculator The calculator; empty selects defaultPolicy().
+     * @param identity Identifies the calculator, e.g. the Python callable it
+     *        wraps, and must stay alive as long as the calculator does.
+     *
+     * Calls with the same plain function pointer, or else the same non-null
+     * identity, share one policy while it is alive, so organisms built from
+     * one calculator form one species. Other calls create a fresh policy.
+     */
+    static std::shared_ptr<const Policy> lifeConsumptionPolicy(
+        LifeConsumptionCalculator calculator, const void *identity = nullptr);
+
     /** @brief Construct a default organism with preset genes and 500 lifespan. */
     Organism();
 
@@ -63,17 +131,29 @@ public:
      * @brief Construct an organism with genes and a custom life consumption formula.
      * @param genes The genetic data determining speed, size, and awareness.
      * @param lifeConsumptionCalculator Custom function to compute per-tick life drain.
+     *
+     * Organisms built from the same plain function pointer share one policy.
+     * Any other callable (a lambda, a std::bind) gets a policy of its own and
+     * so a species of its own; for many organisms share one Policy instead,
+     * see SpeciesId for the limit.
      */
     Organism(const Genes &genes, LifeConsumptionCalculator lifeConsumptionCalculator);
 
+    /**
+     * @brief Construct an organism that shares an existing policy.
+     * @param genes The genetic data determining speed, size, and awareness.
+     * @param policy Shared behaviour policy; nullptr selects the default policy.
+     */
+    Organism(const Genes &genes, std::shared_ptr<const Policy> policy);
+
     /** @brief Get movement speed derived from gene index 0 (DNA byte / 4.0). */
-    float getSpeed() const;
+    float getSpeed() const { return traits.speed; }
 
     /** @brief Get body size derived from gene index 1 (DNA byte / 4.0). */
-    float getSize() const;
+    float getSize() const { return traits.size; }
 
     /** @brief Get awareness radius derived from gene index 2 (DNA byte / 4.0). */
-    float getAwareness() const;
+    float getAwareness() const { return traits.awareness; }
 
     /**
      * @brief Get per-iteration life consumption.
@@ -89,7 +169,7 @@ public:
      * @brief Get the radius within which this organism can react to objects.
      * @return Sum of size and awareness attributes.
      */
-    float getReactionRadius() const;
+    float getReactionRadius() const { return traits.reactionRadius; }
 
     /** @brief Mark this organism as dead (lifespan set to 0). */
     void killed();
@@ -120,34 +200,99 @@ public:
 
     // ── Behaviour injection ─────────────────────────────────────────────
 
+    /** @brief Get the shared behaviour policy of this organism. */
+    const std::shared_ptr<const Policy> &getPolicy() const { return policy; }
+
+    /**
+     * @brief Replace the whole behaviour policy.
+     * @param newPolicy Shared policy; nullptr selects the default policy.
+     */
+    void setPolicy(std::shared_ptr<const Policy> newPolicy);
+
+    /** @brief Get the species id assigned by the owning Environment. */
+    SpeciesId getSpeciesId() const { return speciesId; }
+
+    /**
+     * @brief Set the species id. Called by Environment when the organism is added.
+     * @param id Index of this organism's policy in the Environment's SpeciesTable.
+     */
+    void setSpeciesId(SpeciesId id) { speciesId = id; }
+
     /**
      * @brief Replace the reaction strategy with a custom implementation.
      *
      * The strategy is propagated to offspring during reproduce(). Pass nullptr
-     * or an empty std::function to revert to the built-in default.
+     * or an empty std::function to revert to the built-in default. Organisms
+     * of one policy given the same plain function pointer, or else the same
+     * non-null identity, share one derived policy and so stay one species;
+     * any other call derives a new policy for this organism.
      *
      * @param strategy Callable matching the ReactionStrategy signature.
+     * @param identity Identifies the callable, e.g. the Python callable it
+     *        wraps, and must stay alive as long as the strategy does.
      */
-    void setReactionStrategy(ReactionStrategy strategy);
+    void setReactionStrategy(ReactionStrategy strategy, const void *identity = nullptr);
 
     /**
      * @brief Replace the interaction strategy with a custom implementation.
      *
      * The strategy is propagated to offspring during reproduce(). Pass nullptr
-     * or an empty std::function to revert to the built-in default.
+     * or an empty std::function to revert to the built-in default. Callables
+     * share derived policies as in setReactionStrategy().
      *
      * @param strategy Callable matching the InteractionStrategy signature.
+     * @param identity See setReactionStrategy().
+     */
+    void setInteractionStrategy(InteractionStrategy strategy, const void *identity = nullptr);
+
+    /**
+     * @brief Replace the reaction strategy with a native C function.
+     *
+     * Clears any std::function reaction strategy. Pass nullptr to revert to
+     * the built-in default. Organisms of one policy given the same function
+     * share one derived policy.
+     *
+     * @param strategy Function following the NativeStrategy::ReactionFn ABI.
+     */
+    void setNativeReactionStrategy(NativeStrategy::ReactionFn strategy);
+
+    /**
+     * @brief Replace the interaction strategy with a native C function.
+     *
+     * Clears any std::function interaction strategy. Pass nullptr to revert to
+     * the built-in default. Organisms of one policy given the same function
+     * share one derived policy.
+     *
+     * @param strategy Function following the NativeStrategy::InteractionFn ABI.
+     */
+    void setNativeInteractionStrategy(NativeStrategy::InteractionFn strategy);
+
+    /**
+     * @brief Replace both reaction and interaction with a rule table.
+     *
+     * Clears every callback and native reaction/interaction strategy, so the
+     * rules take effect. Pass nullptr to revert to the built-in defaults.
+     * Organisms of one policy given the same table share one derived policy.
+     *
+     * @param strategy Shared rule table.
      */
-    void setInteractionStrategy(InteractionStrategy strategy);
+    void setRuleBasedStrategy(std::shared_ptr<const RuleBasedStrategy> strategy);
 
     /**
      * @brief Check whether this organism has any custom (non-default) strategy set.
-     * @return true if either reactionStrategy or interactionStrategy is set.
+     * @return true if any callback, native or rule-based strategy is set.
+     */
+    bool hasCustomStrategy() const;
+
+    /**
+     * @brief Check whether this organism's behaviour involves std::function callbacks.
+     * @return true if any strategy or the life consumption calculator is a
+     *         std::function, which may wrap a Python callable needing the GIL.
      *
+     * Built-in defaults and native function pointers never require the GIL.
      * Used by Environment to decide whether multi-threaded execution is safe.
-     * Custom strategies may involve Python callbacks that require the GIL.
      */
-    bool hasCustomStrategy() const;
+    bool requiresGil() const;
 
     // ── Actions ─────────────────────────────────────────────────────────
 
@@ -161,6 +306,14 @@ public:
      */
     void react(const std::vector<std::shared_ptr<EnvironmentObject>> &reactableObjects);
 
+    /**
+     * @brief Record a reaction decided outside react(), e.g. by a BatchReactionStrategy.
+     * @param direction Movement direction; a zero vector means "no reaction".
+     *
+     * Follows the same rules as react(): only the first reaction per tick counts.
+     */
+    void applyReaction(Vec2 direction);
+
     /**
      * @brief Interact with objects within the organism's body size range.
      * @param interactableObjects Objects overlapping the organism's size radius.
@@ -173,8 +326,8 @@ public:
 
     /**
      * @brief Create a mutated offspring organism.
-     * @return A new organism with mutated genes, inheriting the life consumption
-     *         calculator and any custom behavior strategies.
+     * @return A new organism with mutated genes, sharing the parent's policy
+     *         and species id.
      *
      * The parent's lifespan is halved. The child is placed at a small offset
      * from the parent's position.
@@ -187,18 +340,38 @@ public:
     void postIteration() override;
 
 private:
-    Genes genes;                                           ///< Genetic data driving attributes
-    LifeConsumptionCalculator lifeConsumptionCalculator;   ///< Optional custom life drain formula
-    ReactionStrategy reactionStrategy;                     ///< Optional custom reaction behaviour
-    InteractionStrategy interactionStrategy;               ///< Optional custom interaction behaviour
-    float lifeSpan;                                        ///< Remaining life points
+    friend class Environment;  // Saves and restores private state in snapshots
+
+    /**
+     * @brief Attributes decoded once from the (immutable) genes.
+     *
+     * Read many times per tick by spatial queries, the default strategies and
+     * movement, so they are kept together in one small block instead of being
+     * re-decoded from DNA bytes on every call.
+     */
+    struct Traits {
+        float speed;            ///< DNA byte 0 / 4
+        float size;             ///< DNA byte 1 / 4
+        float awareness;        ///< DNA byte 2 / 4
+        float reactionRadius;   ///< size + awareness
+        float lifeConsumption;  ///< Default per-tick cost (ignores custom calculator)
+    };
+
+    /// @brief Decode traits and the default per-tick cost from genes.
+    static Traits decodeTraits(const Genes &genes);
+
+    Traits traits;                         ///< Cached decoded attributes
+    Genes genes;                           ///< Genetic data driving attributes
+    std::shared_ptr<const Policy> policy;  ///< Shared behaviour policy (never null)
+    SpeciesId speciesId = 0;               ///< Index of policy in the owning Environment
+    float lifeSpan;                        ///< Remaining life points
 
     /**
      * @brief Compute Euclidean distance to another environment object.
      * @param object The target object.
      * @return Distance in environment coordinate units.
      */
-    double calculateDistance(const std::shared_ptr<EnvironmentObject> &object) const;
+    double calculateDistance(const EnvironmentObject &object) const;
 
     Vec2 movement;              ///< Current movement direction vector
     int reactionCounter = 0;    ///< Guards against multiple reactions per tick
@@ -212,6 +385,15 @@ private:
      */
     void makeMove();
 
+    // Native strategy adapters: pack views into flat arrays and call the C function
+    static std::pair<float, float> nativeReaction(
+        Organism &self, const std::vector<std::shared_ptr<EnvironmentObject>> &objects);
+    static void nativeInteraction(
+        Organism &self, const std::vector<std::shared_ptr<EnvironmentObject>> &objects);
+    static void packNativeViews(const Organism &self,
+                                const std::vector<std::shared_ptr<EnvironmentObject>> &objects,
+                                std::vector<float> &selfView, std::vector<float> &neighbourView);
+
     // Default built-in strategies
     static std::pair<float, float> defaultReaction(
         Organism &self, const std::vector<std::shared_ptr<EnvironmentObject>> &objects);
@@ -0,0 +1,110 @@
+#ifndef POPULATION_STATS_HPP
+#define POPULATION_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EnvironmentObject.hpp"
+
+/**
+ * @brief Incrementally maintained population statistics for one Environment.
+ *
+ * Trait statistics (count, mean, Welford variance, fixed-bin histograms)
+ * are updated in O(1) whenever an organism enters or leaves the
+ * environment, so queries never walk the population. Traits are decoded
+ * from immutable genes, which is what makes exact removal possible.
+ *
+ * A bounded ring buffer additionally keeps one TickSample per simulated
+ * tick, gathered during the post-iteration pass the simulation makes anyway.
+ */
+class PopulationStats {
+public:
+    /// Organism traits tracked by the statistics.
+    enum Trait : int { SPEED = 0, SIZE = 1, AWARENESS = 2 };
+
+    /// Number of tracked traits.
+    static constexpr int TRAIT_COUNT = 3;
+
+    /// Bins per trait histogram, covering [0, TRAIT_MAX).
+    static constexpr int HISTOGRAM_BINS = 32;
+
+    /// Upper bound of trait values (DNA byte 255 / 4, rounded up).
+    static constexpr float TRAIT_MAX = 64.0f;
+
+    /// Histogram bin counts for one trait.
+    using Histogram = std::array<std::uint32_t, HISTOGRAM_BINS>;
+
+    /** @brief Aggregate values of one simulated tick. */
+    struct TickSample {
+        std::uint64_t tick = 0;      ///< Ticks simulated by the environment so far
+        std::uint32_t organisms = 0; ///< Living organisms at the end of the tick
+        std::uint32_t foods = 0;     ///< Edible food at the end of the tick
+        float meanLifeSpan = 0.0f;   ///< Mean life-span of living organisms
+        float meanSpeed = 0.0f;      ///< Mean speed of living organisms
+        float meanSize = 0.0f;       ///< Mean size of living organisms
+        float meanAwareness = 0.0f;  ///< Mean awareness of living organisms
+    };
+
+    /**
+     * @brief Create empty statistics.
+     * @param historyCapacity Number of tick samples kept; older ones are overwritten.
+     */
+    explicit PopulationStats(std::size_t historyCapacity = 1024);
+
+    /** @brief Account for an object entering the environment. */
+    void onAdded(const EnvironmentObject &object);
+
+    /** @brief Account for an object leaving the environment. */
+    void onRemoved(const EnvironmentObject &object);
+
+    /** @brief Forget all objects (history is kept). */
+    void clear();
+
+    /** @brief Number of organisms currently tracked. */
+    std::size_t getOrganismCount() const { return organisms; }
+
+    /** @brief Number of food items currently tracked. */
+    std::size_t getFoodCount() const { return foods; }
+
+    /** @brief Mean of a trait over tracked organisms; 0 when there are none. */
+    double getMean(Trait trait) const { return organisms ? means[trait] : 0.0; }
+
+    /** @brief Population variance of a trait; 0 with fewer than two organisms. */
+    double getVariance(Trait trait) const;
+
+    /** @brief Histogram of a trait over tracked organisms. */
+    const Histogram &getHistogram(Trait trait) const { return histograms[trait]; }
+
+    /** @brief Append a tick sample, overwriting the oldest when full. */
+    void record(const TickSample &sample);
+
+    /** @brief Get the recorded tick samples, oldest first. */
+    std::vector<TickSample> getHistory() const;
+
+    /** @brief Get the ring buffer capacity. */
+    std::size_t getHistoryCapacity() const { return history.size(); }
+
+    /**
+     * @brief Resize the ring buffer, dropping recorded samples.
+     * @throws std::invalid_argument If capacity is 0.
+     */
+    void setHistoryCapacity(std::size_t capacity);
+
+    /** @brief Histogram bin of a trait value, clamped to the valid range. */
+    static int binOf(float value);
+
+private:
+    std::size_t organisms = 0;
+    std::size_t foods = 0;
+    std::array<double, TRAIT_COUNT> means{};  ///< Welford running means
+    std::array<double, TRAIT_COUNT> m2{};     ///< Welford sums of squared deviations
+    std::array<Histogram, TRAIT_COUNT> histograms{};
+
+    std::vector<TickSample> history;  ///< Ring buffer storage
+    std::size_t historyNext = 0;      ///< Slot written by the next record()
+    std::size_t historySize = 0;      ///< Number of valid samples
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef RASTER_HPP
+#define RASTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Quantity rasterised into one image plane by Environment::render().
+ */
+enum class RenderLayer : std::uint8_t {
+    ORGANISMS,  ///< Living organisms per pixel (point splat at the centre)
+    FOOD,       ///< Edible food items per pixel
+    SIZE,       ///< Organism bodies covering the pixel (disc of radius size)
+    AWARENESS   ///< Organisms whose reaction radius covers the pixel
+};
+
+/**
+ * @brief Float image planes produced by Environment::render().
+ *
+ * Planes are stored back to back, each row-major with row 0 at y = 0, so
+ * the buffer maps directly onto a (layers, height, width) array.
+ */
+struct Raster {
+    int width = 0;                    ///< Pixels per row
+    int height = 0;                   ///< Rows per plane
+    std::vector<RenderLayer> layers;  ///< Quantity of each plane, in order
+    std::vector<float> data;          ///< layers.size() * height * width values
+
+    /** @brief Get the first value of a plane. */
+    float *plane(std::size_t index) { return data.data() + index * width * height; }
+
+    /** @brief Const overload of plane(). */
+    const float *plane(std::size_t index) const {
+        return data.data() + index * width * height;
+    }
+
+    /**
+     * @brief Composite the planes into an 8-bit RGBA image (height * width * 4).
+     *
+     * Each layer has a fixed colour (organisms and bodies blue, food green,
+     * awareness red) and is normalised by its own maximum. Colours are
+     * blended additively; alpha is the strongest layer, so empty pixels stay
+     * transparent.
+     */
+    std::vector<std::uint8_t> toRGBA() const;
+};
+
+#endif
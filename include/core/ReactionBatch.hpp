@@ -0,0 +1,52 @@
+#ifndef REACTION_BATCH_HPP
+#define REACTION_BATCH_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "EnvironmentObject.hpp"
+
+/**
+ * @brief Flat, per-species view of the reaction phase for batched strategies.
+ *
+ * Holds one row per organism of a species and one row per distinct object
+ * seen by any of them. Neighbourhoods are stored in CSR form: the neighbours
+ * of organism i are neighbourIndices[neighbourOffsets[i] .. neighbourOffsets[i + 1]),
+ * each an index into the neighbour* arrays. All arrays are row-major so they
+ * map directly onto NumPy arrays.
+ */
+struct ReactionBatch {
+    /// Number of columns in the traits array: speed, size, awareness, lifeSpan.
+    static constexpr int TRAIT_COUNT = 4;
+
+    std::vector<float> positions;  ///< (N, 2) organism x, y
+    std::vector<float> traits;     ///< (N, TRAIT_COUNT) organism traits
+
+    std::vector<std::uint32_t> neighbourOffsets;  ///< (N + 1) CSR row offsets
+    std::vector<std::uint32_t> neighbourIndices;  ///< (nnz) rows into the neighbour arrays
+
+    std::vector<float> neighbourPositions;       ///< (M, 2) neighbour x, y
+    std::vector<float> neighbourSizes;           ///< (M) organism size, 0 for other kinds
+    std::vector<std::uint8_t> neighbourKinds;    ///< (M) ObjectKind values
+    std::vector<std::uint8_t> neighbourActive;   ///< (M) 1 if alive organism / edible food / custom
+
+    /** @brief Number of organisms in the batch. */
+    std::size_t size() const { return positions.size() / 2; }
+
+    /** @brief Number of distinct neighbour objects in the batch. */
+    std::size_t neighbourCount() const { return neighbourKinds.size(); }
+
+    /** @brief Empty all arrays, keeping their capacity for the next batch. */
+    void clear() {
+        positions.clear();
+        traits.clear();
+        neighbourOffsets.clear();
+        neighbourIndices.clear();
+        neighbourPositions.clear();
+        neighbourSizes.clear();
+        neighbourKinds.clear();
+        neighbourActive.clear();
+    }
+};
+
+#endif
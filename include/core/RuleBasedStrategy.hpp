@@ -0,0 +1,79 @@
+#ifndef RULE_BASED_STRATEGY_HPP
+#define RULE_BASED_STRATEGY_HPP
+
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "EnvironmentObject.hpp"
+
+class Organism;
+
+/**
+ * @brief Declarative reaction/interaction strategy evaluated entirely in C++.
+ *
+ * Covers the common "seek food, flee bigger organisms, chase smaller ones"
+ * behaviours with a small table of rules instead of callbacks. It needs no
+ * Python interpreter and is safe to run from worker threads, so species using
+ * it take part in the multi-threaded reaction phase.
+ *
+ * Reaction: for every rule, the nearest active neighbour matching it (within
+ * the rule's range) contributes weight * unit direction towards it; the sum
+ * is the movement direction. Positive weights attract, negative weights
+ * repel. A zero sum means "no reaction".
+ *
+ * Interaction: each active neighbour is consumed (food eaten, organism killed)
+ * if the first rule matching it has @c consume set.
+ */
+class RuleBasedStrategy {
+public:
+    /** @brief One row of the rule table. */
+    struct Rule {
+        ObjectKind target = ObjectKind::FOOD;  ///< Kind of neighbour the rule applies to
+        /// Inclusive lower bound on neighbour size / own size (organisms only)
+        float minSizeRatio = 0.0f;
+        /// Exclusive upper bound on neighbour size / own size (organisms only)
+        float maxSizeRatio = std::numeric_limits<float>::infinity();
+        /// Only neighbours closer than this are considered by the reaction
+        float range = std::numeric_limits<float>::infinity();
+        float weight = 1.0f;   ///< Attraction (> 0) or repulsion (< 0) strength
+        bool consume = false;  ///< Eat/kill matching neighbours on contact
+    };
+
+    /**
+     * @brief Build a strategy from a rule table.
+     * @param rules Rules in priority order (first match wins for interactions).
+     * @throws std::invalid_argument If a rule has an empty size-ratio interval,
+     *         a non-positive range, or a non-finite weight.
+     */
+    explicit RuleBasedStrategy(std::vector<Rule> rules);
+
+    /** @brief Get the rule table. */
+    const std::vector<Rule> &getRules() const { return rules; }
+
+    /**
+     * @brief Compute a movement direction for @p self.
+     * @param self The reacting organism.
+     * @param objects Neighbours within its reaction radius.
+     * @return Weighted direction; {0, 0} when no rule matched.
+     */
+    std::pair<float, float> react(
+        const Organism &self, const std::vector<std::shared_ptr<EnvironmentObject>> &objects) const;
+
+    /**
+     * @brief Consume neighbours whose first matching rule has @c consume set.
+     * @param self The interacting organism.
+     * @param objects Neighbours within its size radius.
+     */
+    void interact(Organism &self,
+                  const std::vector<std::shared_ptr<EnvironmentObject>> &objects) const;
+
+private:
+    std::vector<Rule> rules;  ///< Rules in priority order
+
+    /// @brief Check kind, liveness/edibility and size ratio (range is checked by react()).
+    static bool matches(const Rule &rule, const Organism &self, const EnvironmentObject &object);
+};
+
+#endif
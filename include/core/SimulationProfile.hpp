@@ -0,0 +1,321 @@
+#ifndef SIMULATION_PROFILE_HPP
+#define SIMULATION_PROFILE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utils/perf_counters.hpp>
+#include <utils/profiler.hpp>
+#include <vector>
+
+/**
+ * @brief Neighbour-query counts gathered privately by one thread.
+ *
+ * Phases keep one per worker and merge it into the environment's
+ * ProfileCounters once, so queries never touch shared counters.
+ */
+struct QueryTally {
+    /// Neighbours-per-query buckets: 0, 1, 2-3, 4-7, ..., the last one open-ended
+    static constexpr std::size_t BUCKETS = 16;
+
+    std::uint64_t queries = 0;
+    std::uint64_t neighbours = 0;
+    std::array<std::uint64_t, BUCKETS> perQuery{};
+
+    /** @brief Count one query that returned found neighbours. */
+    void add(std::size_t found) {
+        queries++;
+        neighbours += found;
+        perQuery[std::min<std::size_t>(BUCKETS - 1, std::bit_width(found))]++;
+    }
+};
+
+/** @brief Which strategy call of a species a StrategyCost covers. */
+enum class StrategyCall : std::uint8_t {
+    REACTION,        ///< Organism::react()
+    BATCH_REACTION,  ///< One BatchReactionStrategy call for the whole species
+    INTERACTION,     ///< Organism::interact()
+    COUNT
+};
+
+inline constexpr std::size_t STRATEGY_CALL_COUNT = static_cast<std::size_t>(StrategyCall::COUNT);
+
+/** @brief Name of a strategy call as it appears in profiles. */
+inline const char *strategyCallName(StrategyCall call) {
+    switch (call) {
+        case StrategyCall::REACTION: return "reaction";
+        case StrategyCall::BATCH_REACTION: return "batchReaction";
+        case StrategyCall::INTERACTION: return "interaction";
+        default: return "unknown";
+    }
+}
+
+/** @brief How a species implements a strategy call. */
+enum class StrategyImplementation : std::uint8_t {
+    DEFAULT,   ///< Built-in behaviour
+    CALLBACK,  ///< std::function, e.g. a Python callable
+    NATIVE,    ///< C function pointer
+    RULES      ///< RuleBasedStrategy table
+};
+
+/** @brief Name of a strategy implementation as it appears in profiles. */
+inline const char *strategyImplementationName(StrategyImplementation implementation) {
+    switch (implementation) {
+        case StrategyImplementation::DEFAULT: return "default";
+        case StrategyImplementation::CALLBACK: return "callback";
+        case StrategyImplementation::NATIVE: return "native";
+        case StrategyImplementation::RULES: return "rules";
+    }
+    return "unknown";
+}
+
+/** @brief Accumulated cost of one strategy call of one species, in Profiler ticks. */
+struct StrategyCost {
+    std::uint64_t calls = 0;
+    std::uint64_t neighbours = 0;  ///< Sum of the neighbour-list sizes passed in
+    std::uint64_t ticks = 0;       ///< Wall time inside the strategy, GIL waits included
+    std::uint64_t gilTicks = 0;    ///< Part of ticks spent waiting for the Python GIL
+
+    void operator+=(const StrategyCost &other) {
+        calls += other.calls;
+        neighbours += other.neighbours;
+        ticks += other.ticks;
+        gilTicks += other.gilTicks;
+    }
+};
+
+/**
+ * @brief Strategy costs gathered privately by one thread, by species and call.
+ *
+ * Phases keep one per worker and bind it to the thread for the duration of
+ * their loop, so StrategyScope in Organism::react()/interact() finds it
+ * without the organism knowing its environment. Merged into the
+ * environment's ProfileCounters once per worker, like QueryTally.
+ */
+class StrategyTally {
+public:
+    /** @brief Makes a tally the calling thread's target; restores the previous one. */
+    class Binding {
+    public:
+        explicit Binding(StrategyTally &tally) : previous(slot()) { slot() = &tally; }
+        ~Binding() { slot() = previous; }
+        Binding(const Binding &) = delete;
+        Binding &operator=(const Binding &) = delete;
+
+    private:
+        StrategyTally *previous;
+    };
+
+    /** @brief The tally bound to the calling thread, or nullptr. */
+    static StrategyTally *current() { return slot(); }
+
+    /**
+     * @brief Charge a GIL wait to the strategy running on the calling thread.
+     *
+     * Called by the bindings' ProfiledGilAcquire; a no-op outside strategies.
+     */
+    static void addGilWait(std::uint64_t ticks) {
+        StrategyTally *tally = slot();
+        if (tally && tally->open != NONE) tally->costs[tally->open].gilTicks += ticks;
+    }
+
+    /** @brief Costs indexed by species * STRATEGY_CALL_COUNT + call. */
+    const std::vector<StrategyCost> &getCosts() const { return costs; }
+
+private:
+    friend class StrategyScope;
+    static constexpr std::size_t NONE = ~std::size_t{0};
+
+    std::vector<StrategyCost> costs;
+    std::size_t open = NONE;  ///< Entry of the innermost running StrategyScope
+
+    static StrategyTally *&slot() {
+        static thread_local StrategyTally *bound = nullptr;
+        return bound;
+    }
+
+    std::size_t entry(std::uint16_t species, StrategyCall call) {
+        const std::size_t index = species * STRATEGY_CALL_COUNT + static_cast<std::size_t>(call);
+        if (index >= costs.size()) costs.resize(index + 1);
+        return index;
+    }
+};
+
+/**
+ * @brief Times one strategy call into the calling thread's StrategyTally.
+ *
+ * Costs two timestamps when a tally is bound and one thread-local read
+ * otherwise; compiled out with the profiler (SIMEVO_DISABLE_PROFILING).
+ */
+class StrategyScope {
+public:
+#ifndef SIMEVO_DISABLE_PROFILING
+    StrategyScope(std::uint16_t species, StrategyCall call, std::size_t neighbours)
+        : tally(StrategyTally::current()) {
+        if (!tally) return;
+        previous = tally->open;
+        tally->open = tally->entry(species, call);
+        StrategyCost &cost = tally->costs[tally->open];
+        cost.calls++;
+        cost.neighbours += neighbours;
+        start = Profiler::now();
+    }
+
+    ~StrategyScope() {
+        if (!tally) return;
+        tally->costs[tally->open].ticks += Profiler::now() - start;
+        tally->open = previous;
+    }
+#else
+    StrategyScope(std::uint16_t, StrategyCall, std::size_t) {}
+#endif
+
+    StrategyScope(const StrategyScope &) = delete;
+    StrategyScope &operator=(const StrategyScope &) = delete;
+
+#ifndef SIMEVO_DISABLE_PROFILING
+private:
+    StrategyTally *tally;
+    std::size_t previous = StrategyTally::NONE;
+    std::uint64_t start = 0;
+#endif
+};
+
+/**
+ * @brief The policy a species id stands for, resolved by the environment.
+ *
+ * Species ids are renumbered whenever the species table is compacted, so
+ * ProfileCounters keys strategy costs by policy identity instead.
+ */
+struct StrategyOwner {
+    std::shared_ptr<const void> policy;  ///< Identity only; never dereferenced
+    std::array<StrategyImplementation, STRATEGY_CALL_COUNT> implementations{};
+};
+
+/** @brief Totals and latency quantiles of one profiling zone. */
+struct ZoneProfile {
+    std::string name;        ///< profileZoneName() of the zone
+    std::uint64_t count = 0;  ///< Completed scopes
+    double totalMs = 0.0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;  ///< Quantiles are bucketed: at most 25% high
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;  ///< Exact
+    /// Hardware counters summed over the zone, see Environment::setHardwareCounters()
+    PerfReading counters;
+};
+
+/** @brief Cost of one strategy call of one policy. */
+struct StrategyProfile {
+    std::uint32_t policy = 0;   ///< Serial of the policy, stable until the profile is reset
+    std::uint16_t species = 0;  ///< Current id in the environment's species table
+    bool hasSpecies = true;     ///< False once no species uses the policy; species is then 0
+    StrategyCall call = StrategyCall::REACTION;
+    StrategyImplementation implementation = StrategyImplementation::DEFAULT;
+    std::uint64_t calls = 0;
+    std::uint64_t neighbours = 0;  ///< Total neighbour-list size over all calls
+    double totalMs = 0.0;          ///< Wall time, GIL waits included
+    double meanUs = 0.0;           ///< Per call
+    double gilWaitMs = 0.0;        ///< Time spent acquiring the Python GIL
+};
+
+/**
+ * @brief Cumulative profile of one environment, see Environment::getProfile().
+ */
+struct SimulationProfile {
+    std::uint64_t ticks = 0;         ///< Ticks simulated since the profile was last reset
+    std::vector<ZoneProfile> zones;  ///< Zones that ran, in ProfileZone order
+
+    std::uint64_t queries = 0;     ///< Spatial-index neighbour queries
+    std::uint64_t neighbours = 0;  ///< Neighbours returned by those queries
+    /// Queries by neighbours returned: bucket b counts [2^(b-1), 2^b), bucket 0 empty results
+    std::array<std::uint64_t, QueryTally::BUCKETS> neighboursPerQuery{};
+
+    std::uint64_t organismsInteracted = 0;  ///< Interact calls
+    std::uint64_t organismsReacted = 0;     ///< Individual and batched reactions
+    std::uint64_t indexUpdates = 0;         ///< Organisms moved in the spatial index
+    std::uint64_t objectsRemoved = 0;       ///< Dead organisms and eaten food cleaned up
+
+    /// Strategy calls that ran, by policy in order of first use, then call
+    std::vector<StrategyProfile> strategies;
+};
+
+/**
+ * @brief Counters behind SimulationProfile, safe to update from workers.
+ *
+ * Accumulates across simulateIteration() calls until clear(); the
+ * process-wide Profiler is never involved, so concurrent environments do
+ * not mix their numbers.
+ */
+class ProfileCounters {
+public:
+    ZoneAccumulator zones;  ///< Bound to the environment's threads via ProfileBinding
+
+    /** @brief Merge a phase's query tally. */
+    void merge(const QueryTally &tally);
+
+    /**
+     * @brief Merge a worker's strategy costs.
+     * @param owner Resolves a species id of the tally to its policy; the species
+     *              table must not be compacted between the tally and the merge.
+     */
+    void merge(const StrategyTally &tally,
+               const std::function<StrategyOwner(std::uint16_t)> &owner);
+
+    /** @brief Add the hardware counter delta of one run of a zone. */
+    void addCounters(ProfileZone zone, const PerfReading &delta);
+
+    /** @brief Count objects processed by a phase. */
+    void addInteracted(std::uint64_t n) { interacted.fetch_add(n, std::memory_order_relaxed); }
+    void addReacted(std::uint64_t n) { reacted.fetch_add(n, std::memory_order_relaxed); }
+    void addIndexUpdates(std::uint64_t n) { indexUpdates.fetch_add(n, std::memory_order_relaxed); }
+    void addRemoved(std::uint64_t n) { removed.fetch_add(n, std::memory_order_relaxed); }
+    void addTick() { ticks.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Read every counter into a plain profile.
+     *
+     * Strategy species are left to the environment, see strategyPolicies().
+     */
+    SimulationProfile snapshot() const;
+
+    /** @brief Policies that ran strategies, indexed by StrategyProfile::policy. */
+    std::vector<std::weak_ptr<const void>> strategyPolicies() const;
+
+    /** @brief Zero every counter and histogram. */
+    void clear();
+
+private:
+    std::atomic<std::uint64_t> ticks{0};
+    std::atomic<std::uint64_t> queries{0};
+    std::atomic<std::uint64_t> neighbours{0};
+    std::array<std::atomic<std::uint64_t>, QueryTally::BUCKETS> perQuery{};
+    std::atomic<std::uint64_t> interacted{0};
+    std::atomic<std::uint64_t> reacted{0};
+    std::atomic<std::uint64_t> indexUpdates{0};
+    std::atomic<std::uint64_t> removed{0};
+
+    /// Costs of one policy; weak, so profiling never keeps a policy's callables alive
+    struct PolicyCosts {
+        std::weak_ptr<const void> policy;
+        std::array<StrategyImplementation, STRATEGY_CALL_COUNT> implementations{};
+        std::array<StrategyCost, STRATEGY_CALL_COUNT> costs{};
+    };
+
+    mutable std::mutex mutex;  ///< Guards strategies and counters; taken once per phase
+    std::vector<PolicyCosts> strategies;  ///< Indexed by serial
+    /// Serial of each policy; an expired owner still keeps its own key
+    std::map<std::weak_ptr<const void>, std::uint32_t, std::owner_less<>> policySerials;
+    std::array<PerfReading, PROFILE_ZONE_COUNT> counters{};
+};
+
+#endif
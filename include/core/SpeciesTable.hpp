@@ -0,0 +1,67 @@
+#ifndef SPECIES_TABLE_HPP
+#define SPECIES_TABLE_HPP
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Organism.hpp"
+
+/**
+ * @brief Per-Environment registry mapping shared organism policies to small ids.
+ *
+ * Every distinct Organism::Policy seen by an Environment is interned once and
+ * identified by a SpeciesId. Organisms store only that id (plus the policy
+ * pointer), which lets the simulation group organisms by species and dispatch
+ * each policy once per group. Id 0 is always the default policy.
+ */
+class SpeciesTable {
+public:
+    using SpeciesId = Organism::SpeciesId;
+
+    /// Id reserved for Organism::defaultPolicy().
+    static constexpr SpeciesId DEFAULT_SPECIES = 0;
+
+    /** @brief Create a table containing only the default policy. */
+    SpeciesTable();
+
+    /**
+     * @brief Look up or register a policy.
+     * @param policy Shared policy pointer; identity (not contents) defines a species.
+     * @return The id assigned to the policy.
+     * @throws std::length_error If more distinct policies than SpeciesId can index are live.
+     */
+    SpeciesId intern(const std::shared_ptr<const Organism::Policy> &policy);
+
+    /**
+     * @brief Get the policy registered under an id.
+     * @param id A species id previously returned by intern().
+     */
+    const std::shared_ptr<const Organism::Policy> &get(SpeciesId id) const {
+        return policies[id];
+    }
+
+    /**
+     * @brief Look up a policy without registering it.
+     * @param policy Policy whose id to find.
+     * @return Its id, or std::nullopt if the policy is not in the table.
+     */
+    std::optional<SpeciesId> find(const Organism::Policy *policy) const {
+        auto it = ids.find(policy);
+        if (it == ids.end()) return std::nullopt;
+        return it->second;
+    }
+
+    /** @brief Number of registered species, including the default one. */
+    std::size_t size() const { return policies.size(); }
+
+    /** @brief Forget every policy except the default one. */
+    void clear();
+
+private:
+    std::vector<std::shared_ptr<const Organism::Policy>> policies;  ///< Indexed by SpeciesId
+    std::unordered_map<const Organism::Policy *, SpeciesId> ids;     ///< Reverse lookup
+};
+
+#endif
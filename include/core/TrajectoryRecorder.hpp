@@ -0,0 +1,168 @@
+#ifndef TRAJECTORY_RECORDER_HPP
+#define TRAJECTORY_RECORDER_HPP
+
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_hash.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Environment;
+
+/**
+ * @brief Streams sampled simulation frames to a compact columnar file.
+ *
+ * Attach a recorder with Environment::setRecorder(); every interval-th tick
+ * the simulation thread copies the frame into a bounded queue and a
+ * background thread encodes and writes it, so the tick loop never waits on
+ * disk unless the writer falls maxPendingFrames behind.
+ *
+ * File layout (native byte order):
+ *
+ *   FileHeader, then chunks of up to chunkFrames frames. Each chunk is a
+ *   ChunkHeader followed by contiguous columns, padded to 8 bytes:
+ *
+ *   per frame      tick u64, organisms, introduced, food_added,
+ *                  food_removed, births, deaths, eaten (u32 each)
+ *   per organism   id u32, x f32, y f32, life_span f32
+ *   introduced     id u32, speed f32, size f32, awareness f32
+ *   food added     id u32, x f32, y f32
+ *   food removed   id u32
+ *
+ * Ids are small integers assigned by the recorder, stable for the whole
+ * recording. Static data is delta-encoded: organism traits are written when
+ * an organism is first seen in a chunk and food only when it appears or
+ * disappears. The first frame of every chunk is a keyframe that introduces
+ * every organism and food item, so chunks decode independently. Columns
+ * are plain arrays and can be read with np.memmap.
+ */
+class TrajectoryRecorder {
+public:
+    /// Version of the file format; bumped on layout changes.
+    static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    /** @brief Leading bytes of a trajectory file. */
+    struct FileHeader {
+        char magic[8];               ///< "SIMEVOTJ"
+        std::uint32_t version;       ///< FORMAT_VERSION
+        std::uint32_t interval;      ///< Ticks between frames
+        float width;                 ///< Environment width at creation
+        float height;                ///< Environment height at creation
+        std::uint32_t chunkFrames;   ///< Maximum frames per chunk
+        std::uint32_t reserved;
+    };
+
+    /** @brief Header in front of every chunk's columns. */
+    struct ChunkHeader {
+        char magic[4];                   ///< "CHNK"
+        std::uint32_t frames;            ///< Frames in the chunk
+        std::uint32_t organismRows;      ///< Sum of per-frame organism counts
+        std::uint32_t introducedRows;    ///< Sum of per-frame introduced counts
+        std::uint32_t foodAddedRows;     ///< Sum of per-frame food_added counts
+        std::uint32_t foodRemovedRows;   ///< Sum of per-frame food_removed counts
+        std::uint64_t payloadBytes;      ///< Column bytes after this header, padding included
+    };
+
+    /**
+     * @brief Create the file and start the writer thread.
+     * @param path Output file, overwritten if present.
+     * @param width Environment width stored in the header (for replay tools).
+     * @param height Environment height stored in the header.
+     * @param interval Record every interval-th tick.
+     * @param chunkFrames Frames per chunk (keyframe spacing).
+     * @param maxPendingFrames Frames queued for the writer before capture blocks.
+     * @throws std::invalid_argument If interval, chunkFrames or maxPendingFrames is 0.
+     * @throws std::runtime_error If the file cannot be created.
+     */
+    TrajectoryRecorder(const std::string &path, float width, float height,
+                       std::uint32_t interval = 1, std::uint32_t chunkFrames = 64,
+                       std::size_t maxPendingFrames = 256);
+
+    /** @brief Flush and close, ignoring write errors (call close() to see them). */
+    ~TrajectoryRecorder();
+
+    TrajectoryRecorder(const TrajectoryRecorder &) = delete;
+    TrajectoryRecorder &operator=(const TrajectoryRecorder &) = delete;
+
+    /**
+     * @brief Sample the environment if tick is a multiple of the interval.
+     * @param env Environment to copy the frame from.
+     * @param tick Current tick number (Environment::getTickCount()).
+     * @throws std::runtime_error If the recorder is closed or the writer failed.
+     *
+     * Called by Environment after every tick; must not be called concurrently.
+     */
+    void capture(const Environment &env, std::uint64_t tick);
+
+    /**
+     * @brief Write all pending frames, finish the file and stop the writer.
+     * @throws std::runtime_error If writing failed.
+     *
+     * Idempotent; capture() throws afterwards.
+     */
+    void close();
+
+    /** @brief Number of frames captured so far. */
+    std::uint64_t getFrameCount() const { return framesCaptured; }
+
+    /** @brief Ticks between recorded frames. */
+    std::uint32_t getInterval() const { return interval; }
+
+private:
+    /** @brief One captured frame, in the column layout of the file. */
+    struct Frame {
+        std::uint64_t tick = 0;
+        std::uint32_t births = 0, deaths = 0, eaten = 0;
+        std::vector<std::uint32_t> ids;
+        std::vector<float> xs, ys, lifeSpans;
+        std::vector<std::uint32_t> introducedIds;
+        std::vector<float> speeds, sizes, awareness;
+        std::vector<std::uint32_t> foodAddedIds;
+        std::vector<float> foodXs, foodYs;
+        std::vector<std::uint32_t> foodRemovedIds;
+    };
+
+    /** @brief Recorder id of a tracked object and the last frame it was seen in. */
+    struct Tracked {
+        std::uint32_t id;
+        std::uint64_t lastSeen;
+        std::uint64_t lastChunk;  ///< Chunk in which the static data was last written
+    };
+
+    std::uint32_t interval;
+    std::uint32_t chunkFrames;
+    std::size_t maxPendingFrames;
+
+    // Simulation-thread state
+    std::unordered_map<boost::uuids::uuid, Tracked> organisms;
+    std::unordered_map<boost::uuids::uuid, Tracked> foods;
+    std::uint32_t nextId = 0;
+    std::uint64_t framesCaptured = 0;
+    std::uint32_t previousOrganisms = 0;
+
+    // Shared with the writer thread
+    std::mutex mutex;
+    std::condition_variable framesAvailable;
+    std::condition_variable spaceAvailable;
+    std::deque<Frame> pending;
+    bool closing = false;
+    std::exception_ptr writeError;
+
+    // Writer-thread state
+    std::ofstream out;
+    std::vector<Frame> chunk;
+    std::thread writer;
+
+    void writerLoop();
+    void writeChunk();
+    void rethrowWriteError();
+};
+
+#endif
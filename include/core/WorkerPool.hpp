@@ -0,0 +1,67 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of threads that run index-parallel tasks, reused across calls.
+ *
+ * An Environment keeps one for its reaction phase, so ticks do not pay for
+ * thread start-up and each worker keeps its profiler buffer and trace track.
+ * The calling thread takes part in every run, so a pool of n threads starts
+ * n - 1 of its own.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Start the pool's threads.
+     * @param threads Threads taking part in a run, the caller included; at least 1.
+     */
+    explicit WorkerPool(std::size_t threads);
+
+    /** @brief Stop and join the threads; must not run concurrently with run(). */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /** @brief Threads taking part in a run, the caller included. */
+    std::size_t size() const { return threads.size() + 1; }
+
+    /**
+     * @brief Call task(i) for every i in [0, count) and wait for all of them.
+     * @throws Whatever the first failing task threw, after every task has finished.
+     *
+     * Tasks are handed out one index at a time, to the pool and the caller.
+     * Only one thread may call run() at a time.
+     */
+    void run(std::size_t count, const std::function<void(std::size_t)> &task);
+
+private:
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable started;   ///< A run began, or the pool is stopping
+    std::condition_variable finished;  ///< The last thread of a run left it
+    std::uint64_t generation = 0;      ///< Incremented per run so threads join it once
+    bool stopping = false;
+
+    // State of the current run, guarded by mutex
+    const std::function<void(std::size_t)> *task = nullptr;
+    std::size_t count = 0;
+    std::size_t next = 0;    ///< Next index to hand out
+    std::size_t active = 0;  ///< Threads still inside the run
+    std::exception_ptr error;
+
+    void threadLoop();
+    void work();
+};
+
+#endif
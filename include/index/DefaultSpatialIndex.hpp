@@ -8,10 +8,13 @@ class DefaultSpatialIndex : public ISpatialIndex<T> {
 public:
     DefaultSpatialIndex();
     void insert(const T& object, float x, float y) override;
+    void insertBulk(const std::vector<T>& objects,
+                    const std::vector<std::pair<float, float>>& positions) override;
     std::vector<T> query(float x, float y, float range) override;
     void update(const T& object, float newX, float newY) override;
     void remove(const T& object) override;
     void clear() override;
+    std::unique_ptr<ISpatialIndex<T>> clone() const override;
 
 private:
     std::vector<SpatialObject<T>> spatialObjects;
@@ -1,7 +1,10 @@
 #ifndef ISPATIALINDEX_HPP
 #define ISPATIALINDEX_HPP
 
+#include <cstddef>
 #include <list>
+#include <memory>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -23,10 +26,33 @@ template <typename T>
 class ISpatialIndex {
 public:
     virtual void insert(const T& object, float x, float y) = 0;
+
+    /**
+     * @brief Insert many objects at once.
+     * @param objects Objects to insert.
+     * @param positions Position of each object, same length as objects.
+     *
+     * The default inserts one by one; implementations override it when they
+     * can build in bulk.
+     */
+    virtual void insertBulk(const std::vector<T>& objects,
+                            const std::vector<std::pair<float, float>>& positions) {
+        for (std::size_t i = 0; i < objects.size(); i++) {
+            insert(objects[i], positions[i].first, positions[i].second);
+        }
+    }
     virtual std::vector<T> query(float x, float y, float range) = 0;
     virtual void update(const T& object, float newX, float newY) = 0;
     virtual void remove(const T& object) = 0;
     virtual void clear() = 0;
+
+    /**
+     * @brief Deep-copy the index, preserving its internal structure.
+     *
+     * Cheaper than re-inserting every object: no tree splits or searches run.
+     */
+    virtual std::unique_ptr<ISpatialIndex<T>> clone() const = 0;
+
     virtual ~ISpatialIndex() = default;
 };
 
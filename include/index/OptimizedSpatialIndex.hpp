@@ -14,6 +14,7 @@ public:
     void update(const T& object, float newX, float newY) override;
     void remove(const T& object) override;
     void clear() override;
+    std::unique_ptr<ISpatialIndex<T>> clone() const override;
     ~OptimizedSpatialIndex() override = default;
 
     std::vector<SpatialObject<T>> spatialObjects;  // objects in this node
@@ -38,6 +39,7 @@ private:
     int getChildIndex(float x, float y) const;
     float getDistance(float x1, float y1, float x2, float y2) const;
     OptimizedSpatialIndex<T>* _findLeaf(float x, float y);
+    std::unique_ptr<OptimizedSpatialIndex<T>> cloneNode() const;
 };
 
 #endif
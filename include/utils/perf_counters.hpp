@@ -0,0 +1,224 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Hardware events counted by PerfCounters.
+ *
+ * Chosen to tell memory-layout changes apart from plain wall time: cache
+ * misses at both ends of the hierarchy, plus the cycle, instruction and
+ * branch counts needed to read them in context.
+ */
+enum class PerfEvent : std::uint8_t {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_MISSES,     ///< L1 data cache read misses
+    LLC_MISSES,     ///< Last-level cache misses
+    BRANCH_MISSES,
+    COUNT
+};
+
+inline constexpr std::size_t PERF_EVENT_COUNT = static_cast<std::size_t>(PerfEvent::COUNT);
+
+/** @brief Name of an event as it appears in reports and profiles. */
+inline const char *perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES: return "cycles";
+        case PerfEvent::INSTRUCTIONS: return "instructions";
+        case PerfEvent::L1D_MISSES: return "l1dMisses";
+        case PerfEvent::LLC_MISSES: return "llcMisses";
+        case PerfEvent::BRANCH_MISSES: return "branchMisses";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Counter values, or differences of them, for the events that could be read.
+ *
+ * Events the kernel or CPU does not provide are marked invalid rather than
+ * reported as zero, so a missing counter never looks like a perfect cache.
+ */
+struct PerfReading {
+    std::array<std::uint64_t, PERF_EVENT_COUNT> values{};
+    std::uint32_t validMask = 0;  ///< Bit e is set when values[e] was read
+
+    bool has(PerfEvent event) const { return validMask & (1u << static_cast<unsigned>(event)); }
+    bool empty() const { return validMask == 0; }
+
+    std::uint64_t operator[](PerfEvent event) const {
+        return values[static_cast<std::size_t>(event)];
+    }
+
+    /** @brief Instructions per cycle, or 0 when either is missing. */
+    double ipc() const {
+        if (!has(PerfEvent::CYCLES) || !has(PerfEvent::INSTRUCTIONS) ||
+            (*this)[PerfEvent::CYCLES] == 0) {
+            return 0.0;
+        }
+        return static_cast<double>((*this)[PerfEvent::INSTRUCTIONS]) /
+               static_cast<double>((*this)[PerfEvent::CYCLES]);
+    }
+
+    /** @brief Counts between an earlier reading and this one; valid where both are. */
+    PerfReading operator-(const PerfReading &earlier) const {
+        PerfReading delta;
+        delta.validMask = validMask & earlier.validMask;
+        for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+            // Multiplexed counters are scaled estimates and may step back slightly
+            if (delta.validMask & (1u << e)) {
+                delta.values[e] = values[e] > earlier.values[e] ? values[e] - earlier.values[e] : 0;
+            }
+        }
+        return delta;
+    }
+
+    /** @brief Accumulate another delta; an event is valid once any delta had it. */
+    PerfReading &operator+=(const PerfReading &other) {
+        validMask |= other.validMask;
+        for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) values[e] += other.values[e];
+        return *this;
+    }
+
+    /** @brief Print "name=value" pairs, n/a for missing events, and the IPC. */
+    void report(std::ostream &out) const {
+        for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+            const auto event = static_cast<PerfEvent>(e);
+            out << (e ? " " : "") << perfEventName(event) << '=';
+            if (has(event)) {
+                out << values[e];
+            } else {
+                out << "n/a";
+            }
+        }
+        if (ipc() > 0.0) {
+            char ipcText[32];
+            std::snprintf(ipcText, sizeof(ipcText), " ipc=%.2f", ipc());
+            out << ipcText;
+        }
+    }
+};
+
+/**
+ * @brief Hardware performance counters of the calling thread, via perf_event_open.
+ *
+ * Counters are opened for the constructing thread and inherited by threads
+ * it starts afterwards; a child's counts join the total when it exits, so
+ * workers joined inside a measured region are included. Read the counters
+ * before and after a region and subtract the readings.
+ *
+ * Each event is opened on its own and may fail on its own: no PMU in a VM,
+ * perf_event_paranoid too strict, non-Linux builds. Such events are simply
+ * absent from readings; getError() says why the first one failed. Counters
+ * multiplexed by the kernel are scaled by their enabled/running time.
+ * Only user-space events are counted.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        fds.fill(-1);
+#ifdef __linux__
+        for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            configure(static_cast<PerfEvent>(e), attr);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            long fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+            if (fd >= 0) {
+                fds[e] = static_cast<int>(fd);
+            } else if (error.empty()) {
+                error = std::string(perfEventName(static_cast<PerfEvent>(e))) +
+                        ": perf_event_open failed: " + std::strerror(errno);
+            }
+        }
+#else
+        error = "perf_event_open requires Linux";
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /** @brief Whether at least one event could be opened. */
+    bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    /** @brief Whether an event could be opened. */
+    bool has(PerfEvent event) const { return fds[static_cast<std::size_t>(event)] >= 0; }
+
+    /** @brief Why the first unavailable event failed to open; empty if all opened. */
+    const std::string &getError() const { return error; }
+
+    /** @brief Current totals of every open event since construction. */
+    PerfReading read() const {
+        PerfReading reading;
+#ifdef __linux__
+        for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+            if (fds[e] < 0) continue;
+            std::uint64_t raw[3];  // value, time enabled, time running
+            if (::read(fds[e], raw, sizeof(raw)) != static_cast<ssize_t>(sizeof(raw))) continue;
+            std::uint64_t value = raw[0];
+            if (raw[2] > 0 && raw[2] < raw[1]) {
+                value = static_cast<std::uint64_t>(static_cast<double>(value) *
+                                                   static_cast<double>(raw[1]) /
+                                                   static_cast<double>(raw[2]));
+            }
+            reading.values[e] = value;
+            reading.validMask |= 1u << e;
+        }
+#endif
+        return reading;
+    }
+
+private:
+    std::array<int, PERF_EVENT_COUNT> fds;
+    std::string error;
+
+#ifdef __linux__
+    static void configure(PerfEvent event, perf_event_attr &attr) {
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (event) {
+            case PerfEvent::CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+            case PerfEvent::INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+            case PerfEvent::LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+            case PerfEvent::BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+            case PerfEvent::L1D_MISSES:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                break;
+            default: break;
+        }
+    }
+#endif
+};
+
+#endif
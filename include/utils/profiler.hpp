@@ -1,66 +1,575 @@
 #ifndef PROFILER_H
 #define PROFILER_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
-#include <iostream>
-#include <string>
-#include <unordered_map>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define SIMEVO_PROFILER_TSC 1
+#endif
+
+/**
+ * @brief Code regions timed by the profiler, fixed at compile time.
+ *
+ * Zones index flat per-thread arrays, so recording one is two timestamp
+ * reads and a few stores; add new zones before COUNT and name them in
+ * profileZoneName().
+ */
+enum class ProfileZone : std::uint8_t {
+    SIMULATE_ITERATION,   ///< A whole simulateIteration() call
+    TICK,                 ///< One iteration of simulateIteration()
+    HANDLE_INTERACTIONS,  ///< Interaction phase of a tick
+    HANDLE_REACTIONS,     ///< Reaction phase of a tick
+    REACTION_WORKER,      ///< One worker's share of the reaction phase
+    POST_ITERATION,       ///< Life deduction, movement and statistics
+    UPDATE_INDEX,         ///< Moving organisms in the spatial index
+    CLEAN_UP,             ///< Removing dead organisms and eaten food
+    REBUILD_INDEX,        ///< Re-inserting every object into a fresh index
+    ON_EACH_ITERATION,    ///< The per-tick user callback
+    GIL_WAIT,             ///< Waiting to acquire the Python GIL
+    COUNT
+};
+
+/// Number of profiling zones.
+constexpr std::size_t PROFILE_ZONE_COUNT = static_cast<std::size_t>(ProfileZone::COUNT);
+
+/** @brief Human-readable name of a zone (the old string keys). */
+constexpr const char* profileZoneName(ProfileZone zone) {
+    switch (zone) {
+        case ProfileZone::SIMULATE_ITERATION: return "simulateIteration";
+        case ProfileZone::TICK: return "tick";
+        case ProfileZone::HANDLE_INTERACTIONS: return "handleInteractions";
+        case ProfileZone::HANDLE_REACTIONS: return "handleReactions";
+        case ProfileZone::REACTION_WORKER: return "reactionWorker";
+        case ProfileZone::POST_ITERATION: return "postIteration";
+        case ProfileZone::UPDATE_INDEX: return "updateIndex";
+        case ProfileZone::CLEAN_UP: return "cleanUp";
+        case ProfileZone::REBUILD_INDEX: return "rebuildIndex";
+        case ProfileZone::ON_EACH_ITERATION: return "onEachIteration";
+        case ProfileZone::GIL_WAIT: return "gilWait";
+        case ProfileZone::COUNT: break;
+    }
+    return "unknown";
+}
+
+/** @brief Accumulated timings of one zone. */
+struct ZoneTotals {
+    std::uint64_t ns = 0;     ///< Total time spent in the zone
+    std::uint64_t count = 0;  ///< Number of completed scopes
+    std::uint64_t maxNs = 0;  ///< Longest single scope since the totals began
+
+    /** @brief Total time in milliseconds. */
+    double ms() const { return static_cast<double>(ns) / 1e6; }
+};
+
+/**
+ * @brief Zone totals summed over every thread at one point in time.
+ *
+ * Subtract an earlier snapshot to get the cost of the work in between;
+ * maxNs is not differentiable and keeps the later value.
+ */
+struct ProfileSnapshot {
+    std::array<ZoneTotals, PROFILE_ZONE_COUNT> zones{};
+
+    const ZoneTotals& operator[](ProfileZone zone) const {
+        return zones[static_cast<std::size_t>(zone)];
+    }
+
+    ProfileSnapshot operator-(const ProfileSnapshot& earlier) const {
+        ProfileSnapshot delta = *this;
+        for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+            // The tick-to-ns ratio is refined between snapshots; never wrap below 0
+            delta.zones[z].ns -= std::min(delta.zones[z].ns, earlier.zones[z].ns);
+            delta.zones[z].count -= earlier.zones[z].count;
+        }
+        return delta;
+    }
+
+    /** @brief Print total, count and average of every zone that ran. */
+    void report(std::ostream& out) const {
+        for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+            const ZoneTotals& totals = zones[z];
+            if (totals.count == 0) continue;
+            out << profileZoneName(static_cast<ProfileZone>(z)) << ": " << totals.ms()
+                << " ms total, " << totals.count << " times, "
+                << totals.ms() / static_cast<double>(totals.count) << " ms average\n";
+        }
+    }
+};
+
+/**
+ * @brief Process-wide zone profiler with per-thread, lock-free recording.
+ *
+ * Every thread records into its own buffer of relaxed atomics, which only
+ * that thread writes, so recording never contends and parallel phases are
+ * not serialised by it. snapshot() sums the live buffers under a mutex that
+ * recording never takes; buffers of exited threads are folded into a
+ * retired total so their time is not lost. Timestamps come from the TSC
+ * where available (converted to nanoseconds against steady_clock) and from
+ * steady_clock elsewhere. Totals are never reset; diff snapshots instead.
+ *
+ * Define SIMEVO_DISABLE_PROFILING (CMake: -DSIMEVO_PROFILING=OFF) to
+ * compile every PROFILE_ZONE out.
+ */
 class Profiler {
 public:
-    static Profiler& getInstance() {
-        static Profiler instance;
-        return instance;
+    /** @brief Raw timestamp in clock ticks; see toNanoseconds(). */
+    static std::uint64_t now() {
+#ifdef SIMEVO_PROFILER_TSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+
+    /** @brief Convert a difference of now() values to nanoseconds. */
+    static double toNanoseconds(std::uint64_t ticks) {
+        return static_cast<double>(ticks) * nanosecondsPerTick();
+    }
+
+    /** @brief Add one completed scope of zone to the calling thread's buffer. */
+    static void record(ProfileZone zone, std::uint64_t ticks) {
+        ThreadBuffer& buffer = localBuffer();
+        const auto z = static_cast<std::size_t>(zone);
+        // Single writer per buffer: plain load/store, no locked read-modify-write
+        buffer.ticks[z].store(buffer.ticks[z].load(std::memory_order_relaxed) + ticks,
+                              std::memory_order_relaxed);
+        buffer.counts[z].store(buffer.counts[z].load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+        if (ticks > buffer.maxTicks[z].load(std::memory_order_relaxed)) {
+            buffer.maxTicks[z].store(ticks, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Small sequential id of the calling thread, stable for its lifetime. */
+    static std::uint32_t threadIndex() {
+        static std::atomic<std::uint32_t> nextIndex{0};
+        static thread_local const std::uint32_t index = nextIndex++;
+        return index;
+    }
+
+    /** @brief Sum every thread's totals, converted to nanoseconds. */
+    static ProfileSnapshot snapshot() {
+        Registry& registry = getRegistry();
+        std::array<std::uint64_t, PROFILE_ZONE_COUNT> ticks{}, maxTicks{};
+        ProfileSnapshot result;
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto add = [&](const ThreadBuffer& buffer) {
+                for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+                    ticks[z] += buffer.ticks[z].load(std::memory_order_relaxed);
+                    result.zones[z].count += buffer.counts[z].load(std::memory_order_relaxed);
+                    maxTicks[z] =
+                        std::max(maxTicks[z], buffer.maxTicks[z].load(std::memory_order_relaxed));
+                }
+            };
+            add(registry.retired);
+            for (const auto& buffer : registry.live) add(*buffer);
+        }
+        const double perTick = nanosecondsPerTick();
+        for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+            result.zones[z].ns = static_cast<std::uint64_t>(static_cast<double>(ticks[z]) * perTick);
+            result.zones[z].maxNs =
+                static_cast<std::uint64_t>(static_cast<double>(maxTicks[z]) * perTick);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Tick length, calibrated against steady_clock since the first call.
+     *
+     * The longer the process runs, the more precise the ratio; the first
+     * call waits 10 ms so early snapshots are already within about 0.1%.
+     */
+    static double nanosecondsPerTick() {
+#ifdef SIMEVO_PROFILER_TSC
+        using Clock = std::chrono::steady_clock;
+        struct Anchor {
+            Clock::time_point time = Clock::now();
+            std::uint64_t ticks = __rdtsc();
+        };
+        static const Anchor anchor = [] {
+            Anchor start;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return start;
+        }();
+        const auto ticks = __rdtsc() - anchor.ticks;
+        const auto ns = std::chrono::duration<double, std::nano>(Clock::now() - anchor.time);
+        return ticks > 0 ? ns.count() / static_cast<double>(ticks) : 0.0;
+#else
+        return 1.0;
+#endif
+    }
+
+private:
+    struct ThreadBuffer {
+        std::array<std::atomic<std::uint64_t>, PROFILE_ZONE_COUNT> ticks{};
+        std::array<std::atomic<std::uint64_t>, PROFILE_ZONE_COUNT> counts{};
+        std::array<std::atomic<std::uint64_t>, PROFILE_ZONE_COUNT> maxTicks{};
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<ThreadBuffer*> live;
+        ThreadBuffer retired;
+    };
+
+    /** @brief Registers the thread's buffer on first use and retires it on exit. */
+    struct LocalHandle {
+        ThreadBuffer buffer;
+
+        LocalHandle() {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.live.push_back(&buffer);
+        }
+
+        ~LocalHandle() {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+                auto fold = [z](auto& into, const auto& from, bool max) {
+                    auto value = from[z].load(std::memory_order_relaxed);
+                    auto current = into[z].load(std::memory_order_relaxed);
+                    into[z].store(max ? std::max(current, value) : current + value,
+                                  std::memory_order_relaxed);
+                };
+                fold(registry.retired.ticks, buffer.ticks, false);
+                fold(registry.retired.counts, buffer.counts, false);
+                fold(registry.retired.maxTicks, buffer.maxTicks, true);
+            }
+            std::erase(registry.live, &buffer);
+        }
+    };
+
+    static Registry& getRegistry() {
+        // Leaked on purpose: thread-local handles may retire during static destruction
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+
+    static ThreadBuffer& localBuffer() {
+        static thread_local LocalHandle handle;
+        return handle.buffer;
+    }
+};
+
+/** @brief One timed zone scope, in Profiler::now() ticks. */
+struct TraceSpan {
+    std::uint64_t start = 0;
+    std::uint64_t end = 0;
+    std::uint32_t thread = 0;  ///< Profiler::threadIndex() of the recording thread
+    ProfileZone zone = ProfileZone::COUNT;
+};
+
+/**
+ * @brief Ring buffer of the most recent zone spans, for timeline export.
+ *
+ * Spans are recorded by every PROFILE_ZONE that closes on a thread the
+ * buffer is bound to (see ProfileBinding), so one buffer collects the ticks,
+ * phases and workers of one environment even when several environments run
+ * on other threads. Writers claim slots with one atomic increment and
+ * publish them with a per-slot stamp, so concurrent workers never lock;
+ * once full, the oldest spans are overwritten.
+ */
+class TraceBuffer {
+public:
+    /**
+     * @brief Allocate room for capacity spans.
+     * @throws std::invalid_argument If capacity is 0.
+     */
+    explicit TraceBuffer(std::size_t capacity) : slots(capacity) {
+        if (capacity == 0) throw std::invalid_argument("TraceBuffer: capacity must be positive.");
+    }
+
+    /** @brief Append a span, overwriting the oldest one when full. */
+    void push(ProfileZone zone, std::uint64_t start, std::uint64_t end) {
+        const std::uint64_t index = next.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slots[index % slots.size()];
+        slot.stamp.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.span = TraceSpan{start, end, Profiler::threadIndex(), zone};
+        slot.stamp.store(index + 1, std::memory_order_release);
+    }
+
+    /** @brief Copy the retained spans, oldest first, skipping any being rewritten. */
+    std::vector<TraceSpan> spans() const {
+        const std::uint64_t end = next.load(std::memory_order_acquire);
+        const std::uint64_t begin = end > slots.size() ? end - slots.size() : 0;
+        std::vector<TraceSpan> result;
+        result.reserve(static_cast<std::size_t>(end - begin));
+        for (std::uint64_t index = begin; index < end; index++) {
+            const Slot& slot = slots[index % slots.size()];
+            if (slot.stamp.load(std::memory_order_acquire) != index + 1) continue;
+            TraceSpan span = slot.span;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.stamp.load(std::memory_order_relaxed) == index + 1) result.push_back(span);
+        }
+        return result;
     }
 
-    void start(const std::string& key) {
-        startTimes[key] = std::chrono::high_resolution_clock::now();
+    /** @brief Number of spans ever pushed, including overwritten ones. */
+    std::uint64_t getRecorded() const { return next.load(std::memory_order_relaxed); }
+
+    /** @brief Maximum number of spans retained. */
+    std::size_t getCapacity() const { return slots.size(); }
+
+    /**
+     * @brief Write the retained spans as Chrome trace-event JSON.
+     *
+     * Every span is a complete ("X") event in microseconds from the oldest
+     * retained span, on a track per recording thread; the output opens in
+     * chrome://tracing and ui.perfetto.dev.
+     */
+    void writeChromeTrace(std::ostream& out) const {
+        std::vector<TraceSpan> retained = spans();
+        std::uint64_t origin = std::numeric_limits<std::uint64_t>::max();
+        std::vector<std::uint32_t> threads;
+        for (const TraceSpan& span : retained) {
+            origin = std::min(origin, span.start);
+            if (std::find(threads.begin(), threads.end(), span.thread) == threads.end()) {
+                threads.push_back(span.thread);
+            }
+        }
+        auto micros = [](std::uint64_t ticks) { return Profiler::toNanoseconds(ticks) / 1000.0; };
+
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+               "\"args\":{\"name\":\"SimEvo\"}}";
+        for (std::uint32_t thread : threads) {
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+                << ",\"args\":{\"name\":\"thread " << thread << "\"}}";
+        }
+        out << std::fixed;
+        out.precision(3);
+        for (const TraceSpan& span : retained) {
+            out << ",\n{\"name\":\"" << profileZoneName(span.zone)
+                << "\",\"cat\":\"simevo\",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread
+                << ",\"ts\":" << micros(span.start - origin)
+                << ",\"dur\":" << micros(span.end - span.start) << "}";
+        }
+        out << "\n]}\n";
     }
 
-    void stop(const std::string& key) {
-        auto end = std::chrono::high_resolution_clock::now();
-        auto start = startTimes.find(key);
-        if (start != startTimes.end()) {
-            durations[key] +=
-                std::chrono::duration<double, std::milli>(end - start->second).count();
-            counts[key]++;
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> stamp{0};  ///< index + 1 once the span is complete
+        TraceSpan span;
+    };
+
+    std::vector<Slot> slots;
+    std::atomic<std::uint64_t> next{0};
+};
+
+/**
+ * @brief Log-linear histogram of durations in Profiler::now() ticks.
+ *
+ * Four buckets per power of two keep quantiles at most 25% high in
+ * roughly a kilobyte; buckets are atomic so concurrent workers can record
+ * into the same histogram.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned MIN_EXPONENT = 6;  ///< Durations below 2^6 ticks share bucket 0
+    static constexpr unsigned EXPONENTS = 40;    ///< Octaves above that before clamping
+    static constexpr unsigned SUB_BUCKETS = 4;
+    static constexpr std::size_t BUCKETS = (EXPONENTS + 1) * SUB_BUCKETS;
+
+    void record(std::uint64_t ticks) {
+        buckets[bucketOf(ticks)].fetch_add(1, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t previous = max.load(std::memory_order_relaxed);
+        while (ticks > previous &&
+               !max.compare_exchange_weak(previous, ticks, std::memory_order_relaxed)) {
         }
     }
 
-    void report(std::string key) const {
-        auto entry = durations.find(key);
-        if (entry != durations.end()) {
-            auto count = counts.find(key)->second;
-            double average = entry->second / count;
-            std::cout << key << ": " << entry->second << " ms total, " << count << " times, "
-                      << average << " ms average" << std::endl;
+    std::uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+
+    /** @brief Longest recorded duration, exact. */
+    std::uint64_t maxTicks() const { return max.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Approximate q-quantile in ticks (0 when empty).
+     *
+     * Reports the upper edge of the bucket holding the quantile, capped by
+     * the exact maximum, so estimates err on the slow side by under 25%.
+     */
+    std::uint64_t quantileTicks(double q) const {
+        const std::uint64_t total = getCount();
+        if (total == 0) return 0;
+        const auto rank = std::max<std::uint64_t>(
+            1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(total))));
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < BUCKETS; b++) {
+            seen += buckets[b].load(std::memory_order_relaxed);
+            if (seen >= rank) return std::min(upperEdge(b), maxTicks());
         }
+        return maxTicks();
+    }
+
+    void clear() {
+        for (auto& bucket : buckets) bucket.store(0, std::memory_order_relaxed);
+        count.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
     }
 
-    void report() const {
-        for (const auto& entry : durations) {
-            auto count = counts.find(entry.first)->second;
-            double average = entry.second / count;
-            std::cout << entry.first << ": " << entry.second << " ms total, " << count << " times, "
-                      << average << " ms average" << std::endl;
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS> buckets{};
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> max{0};
+
+    static std::size_t bucketOf(std::uint64_t ticks) {
+        const unsigned exponent = static_cast<unsigned>(std::bit_width(ticks)) - 1;
+        if (ticks == 0 || exponent < MIN_EXPONENT) return 0;
+        const unsigned sub = static_cast<unsigned>(ticks >> (exponent - 2)) & (SUB_BUCKETS - 1);
+        return std::min<std::size_t>(BUCKETS - 1,
+                                     (exponent - MIN_EXPONENT + 1) * SUB_BUCKETS + sub);
+    }
+
+    static std::uint64_t upperEdge(std::size_t bucket) {
+        if (bucket < SUB_BUCKETS) return std::uint64_t{1} << MIN_EXPONENT;
+        const unsigned exponent = static_cast<unsigned>(bucket / SUB_BUCKETS) - 1 + MIN_EXPONENT;
+        const std::uint64_t sub = bucket % SUB_BUCKETS;
+        return (SUB_BUCKETS + sub + 1) << (exponent - 2);
+    }
+};
+
+/**
+ * @brief Zone totals and latency histograms for one owner (an environment).
+ *
+ * Unlike the process-wide Profiler this is shared by every thread bound to
+ * the owner, so it uses atomic read-modify-writes; zones close at most a
+ * few times per tick per thread, so contention stays negligible.
+ */
+class ZoneAccumulator {
+public:
+    void add(ProfileZone zone, std::uint64_t ticks) {
+        Entry& entry = entries[static_cast<std::size_t>(zone)];
+        entry.ticks.fetch_add(ticks, std::memory_order_relaxed);
+        entry.histogram.record(ticks);
+    }
+
+    /** @brief Total ticks spent in a zone. */
+    std::uint64_t ticks(ProfileZone zone) const {
+        return entries[static_cast<std::size_t>(zone)].ticks.load(std::memory_order_relaxed);
+    }
+
+    const LatencyHistogram& histogram(ProfileZone zone) const {
+        return entries[static_cast<std::size_t>(zone)].histogram;
+    }
+
+    /** @brief This owner's totals in nanoseconds; diff two to cover the work in between. */
+    ProfileSnapshot snapshot() const {
+        ProfileSnapshot result;
+        const double perTick = Profiler::nanosecondsPerTick();
+        for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+            const Entry& entry = entries[z];
+            const double ticks = static_cast<double>(entry.ticks.load(std::memory_order_relaxed));
+            result.zones[z].ns = static_cast<std::uint64_t>(ticks * perTick);
+            result.zones[z].count = entry.histogram.getCount();
+            result.zones[z].maxNs =
+                static_cast<std::uint64_t>(static_cast<double>(entry.histogram.maxTicks()) * perTick);
         }
+        return result;
+    }
+
+    void clear() {
+        for (Entry& entry : entries) {
+            entry.ticks.store(0, std::memory_order_relaxed);
+            entry.histogram.clear();
+        }
+    }
+
+private:
+    struct Entry {
+        std::atomic<std::uint64_t> ticks{0};
+        LatencyHistogram histogram;
+    };
+    std::array<Entry, PROFILE_ZONE_COUNT> entries;
+};
+
+/** @brief Where a thread's closing zones go besides the process-wide totals. */
+struct ProfileTargets {
+    TraceBuffer* trace = nullptr;        ///< Timeline to append spans to
+    ZoneAccumulator* totals = nullptr;   ///< Per-owner totals and histograms
+};
+
+/**
+ * @brief Routes the calling thread's zones to an owner's targets for its lifetime.
+ *
+ * Bind at every entry point that does work for the owner, including on
+ * worker threads; bindings nest and restore the previous targets.
+ */
+class ProfileBinding {
+public:
+    explicit ProfileBinding(ProfileTargets targets) : previous(current()) { current() = targets; }
+    ~ProfileBinding() { current() = previous; }
+
+    ProfileBinding(const ProfileBinding&) = delete;
+    ProfileBinding& operator=(const ProfileBinding&) = delete;
+
+    /** @brief Targets of the calling thread. */
+    static ProfileTargets& current() {
+        static thread_local ProfileTargets targets;
+        return targets;
     }
 
-    void reset() {
-        durations.clear();
-        startTimes.clear();
-        counts.clear();
+private:
+    ProfileTargets previous;
+};
+
+/**
+ * @brief Times the enclosing scope into a zone.
+ *
+ * Prefer the PROFILE_ZONE macro, which compiles out with profiling disabled.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone) : zone(zone), start(Profiler::now()) {}
+    ~ProfileScope() { emit(zone, start, Profiler::now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+    /** @brief Record a span measured by hand into the profiler and the bound targets. */
+    static void emit(ProfileZone zone, std::uint64_t start, std::uint64_t end) {
+        Profiler::record(zone, end - start);
+        const ProfileTargets& targets = ProfileBinding::current();
+        if (targets.trace) targets.trace->push(zone, start, end);
+        if (targets.totals) targets.totals->add(zone, end - start);
     }
 
 private:
-    Profiler() = default;
-    ~Profiler() = default;
-    Profiler(const Profiler&) = delete;
-    Profiler& operator=(const Profiler&) = delete;
-
-    std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> startTimes;
-    std::unordered_map<std::string, double> durations;
-    std::unordered_map<std::string, int> counts;
+    ProfileZone zone;
+    std::uint64_t start;
 };
 
+#define SIMEVO_PROFILE_CONCAT_(a, b) a##b
+#define SIMEVO_PROFILE_CONCAT(a, b) SIMEVO_PROFILE_CONCAT_(a, b)
+
+#ifdef SIMEVO_DISABLE_PROFILING
+#define PROFILE_ZONE(zone) ((void)0)
+#else
+/// Time the rest of the enclosing block into the given ProfileZone value.
+#define PROFILE_ZONE(zone) \
+    ProfileScope SIMEVO_PROFILE_CONCAT(profileScope, __LINE__)(ProfileZone::zone)
+#endif
+
 #endif  // PROFILER_H
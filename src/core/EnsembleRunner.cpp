@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <core/EnsembleRunner.hpp>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+EnsembleRunner::EnsembleRunner(int numThreads) : numThreads(numThreads) {
+    if (this->numThreads <= 0) {
+        this->numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+std::size_t EnsembleRunner::add(std::shared_ptr<Environment> environment) {
+    if (!environment) {
+        throw std::invalid_argument("Cannot add a null environment to an ensemble.");
+    }
+    environments.push_back(std::move(environment));
+    return environments.size() - 1;
+}
+
+const std::shared_ptr<Environment> &EnsembleRunner::get(std::size_t index) const {
+    if (index >= environments.size()) {
+        throw std::out_of_range("Ensemble index out of range.");
+    }
+    return environments[index];
+}
+
+RunSummary EnsembleRunner::summarise(const Environment &environment) {
+    RunSummary summary;
+    auto organisms = environment.getAllOrganisms();
+    summary.organisms = organisms.size();
+    summary.foods = environment.getAllFoods().size();
+    summary.deadOrganisms = environment.getDeadOrganisms().size();
+    summary.foodConsumption = environment.getFoodConsumptionInIteration();
+    summary.species = environment.getSpeciesCount();
+
+    if (!organisms.empty()) {
+        for (const auto &organism : organisms) {
+            summary.meanLifeSpan += organism->getLifeSpan();
+            summary.meanSpeed += organism->getSpeed();
+            summary.meanSize += organism->getSize();
+            summary.meanAwareness += organism->getAwareness();
+        }
+        double count = static_cast<double>(organisms.size());
+        summary.meanLifeSpan /= count;
+        summary.meanSpeed /= count;
+        summary.meanSize /= count;
+        summary.meanAwareness /= count;
+    }
+    return summary;
+}
+
+std::vector<RunSummary> EnsembleRunner::run(int iterations) {
+    std::vector<RunSummary> summaries(environments.size());
+    std::vector<std::exception_ptr> errors(environments.size());
+    std::atomic<std::size_t> next{0};
+
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < environments.size(); i = next++) {
+            try {
+                auto start = std::chrono::steady_clock::now();
+                environments[i]->simulateIteration(iterations);
+                auto end = std::chrono::steady_clock::now();
+                summaries[i] = summarise(*environments[i]);
+                summaries[i].elapsedMs =
+                    std::chrono::duration<double, std::milli>(end - start).count();
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    // The calling thread works too, so a single-thread ensemble spawns nothing
+    std::size_t workers = std::min<std::size_t>(numThreads, environments.size());
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < workers; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return summaries;
+}
@@ -1,32 +1,127 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <core/Environment.hpp>
 #include <core/Food.hpp>
+#include <fstream>
 #include <index/DefaultSpatialIndex.hpp>
 #include <index/OptimizedSpatialIndex.hpp>
+#include <iostream>
 #include <memory>
-#include <thread>
+#include <optional>
+#include <utils/perf_counters.hpp>
 #include <utils/profiler.hpp>
 #include <vector>
 
+namespace {
+
+// Adds the hardware counter delta of its lifetime to a zone of the profile
+class CountedZone {
+public:
+    CountedZone(const PerfCounters* counters, ProfileCounters& profile, ProfileZone zone)
+        : counters(counters), profile(profile), zone(zone) {
+        if (counters) start = counters->read();
+    }
+    ~CountedZone() {
+        if (counters) profile.addCounters(zone, counters->read() - start);
+    }
+    CountedZone(const CountedZone&) = delete;
+    CountedZone& operator=(const CountedZone&) = delete;
+
+private:
+    const PerfCounters* counters;
+    ProfileCounters& profile;
+    ProfileZone zone;
+    PerfReading start;
+};
+
+StrategyImplementation strategyImplementation(const Organism::Policy& policy, StrategyCall call) {
+    switch (call) {
+        case StrategyCall::REACTION:
+            if (policy.reactionStrategy) return StrategyImplementation::CALLBACK;
+            if (policy.nativeReaction) return StrategyImplementation::NATIVE;
+            if (policy.rules) return StrategyImplementation::RULES;
+            break;
+        case StrategyCall::BATCH_REACTION:
+            return StrategyImplementation::CALLBACK;
+        case StrategyCall::INTERACTION:
+            if (policy.interactionStrategy) return StrategyImplementation::CALLBACK;
+            if (policy.nativeInteraction) return StrategyImplementation::NATIVE;
+            if (policy.rules) return StrategyImplementation::RULES;
+            break;
+        default:
+            break;
+    }
+    return StrategyImplementation::DEFAULT;
+}
+
+}  // namespace
+
 /**
  * @brief Construct an environment with the given dimensions and spatial index type.
  * @param width  Environment width in simulation units.
  * @param height Environment height in simulation units.
  * @param type   Spatial index type: "default" or "optimized".
- * @param numThreads Reserved for future multi-threaded reaction phase.
+ * @param numThreads Worker threads used by the reaction phase when no callbacks are involved.
  * @throws std::invalid_argument If the spatial index type is unknown.
  */
 Environment::Environment(int width, int height, std::string type, int numThreads)
-    : width(width), height(height), type(type), numThreads(numThreads) {
+    : width(width),
+      height(height),
+      type(type),
+      spatialIndex(createSpatialIndex(type, width, height)),
+      numThreads(numThreads) {}
+
+std::unique_ptr<ISpatialIndex<boost::uuids::uuid>> Environment::createSpatialIndex(
+    const std::string& type, int width, int height) {
     if (type == "default") {
-        spatialIndex = std::make_unique<DefaultSpatialIndex<boost::uuids::uuid>>();
+        return std::make_unique<DefaultSpatialIndex<boost::uuids::uuid>>();
     } else if (type == "optimized") {
         // Use the longest side as the quadtree grid dimension
         unsigned long size = static_cast<unsigned long>(std::max(width, height));
-        spatialIndex = std::make_unique<OptimizedSpatialIndex<boost::uuids::uuid>>(size);
-    } else {
-        throw std::invalid_argument("Invalid spatial index type: " + type);
+        return std::make_unique<OptimizedSpatialIndex<boost::uuids::uuid>>(size);
     }
+    throw std::invalid_argument("Invalid spatial index type: " + type);
+}
+
+/**
+ * @brief Copy objects one by one and the spatial index as a whole.
+ *
+ * Food holds an atomic state and is rebuilt field by field; Organism is
+ * copied with its implicit copy constructor, which keeps id, genes, policy
+ * and movement.
+ */
+std::unique_ptr<Environment> Environment::clone() const {
+    auto copy = std::make_unique<Environment>(width, height, type, numThreads);
+    copy->objectsMapper.reserve(objectsMapper.size());
+    for (const auto& object : objectsMapper) {
+        switch (object.second->getKind()) {
+            case ObjectKind::ORGANISM:
+                copy->objectsMapper.emplace(
+                    object.first, std::make_shared<Organism>(*object.second->as<Organism>()));
+                break;
+            case ObjectKind::FOOD: {
+                const Food* food = object.second->as<Food>();
+                auto foodCopy = std::make_shared<Food>(food->getEnergy());
+                foodCopy->id = food->id;
+                foodCopy->position = food->position;
+                if (!food->canBeEaten()) foodCopy->eaten();
+                copy->objectsMapper.emplace(object.first, std::move(foodCopy));
+                break;
+            }
+            case ObjectKind::CUSTOM:
+                throw std::runtime_error("Environments with custom objects cannot be cloned.");
+        }
+    }
+    copy->spatialIndex = spatialIndex->clone();
+    copy->species = species;
+    copy->deadOrganisms = deadOrganisms;
+    copy->foodConsumption = foodConsumption;
+    copy->foodEatenTotal = foodEatenTotal;
+    copy->foodEatenInTick = foodEatenInTick;
+    copy->verbose = verbose;
+    copy->rng = rng;
+    copy->stats = stats;
+    copy->ticks = ticks;
+    return copy;
 }
 
 /**
@@ -49,11 +144,13 @@ void Environment::checkBounds(float x, float y) const {
  * @throws std::out_of_range If coordinates are out of bounds.
  */
 void Environment::add(const std::shared_ptr<Organism>& organism, float x, float y) {
+    touch();
     checkBounds(x, y);
     auto id = organism->getId();
     organism->setPosition(x, y);
+    organism->setSpeciesId(species.intern(organism->getPolicy()));
     spatialIndex->insert(id, x, y);
-    objectsMapper.insert({id, organism});
+    if (objectsMapper.insert({id, organism}).second) stats.onAdded(*organism);
 }
 
 /**
@@ -64,11 +161,12 @@ void Environment::add(const std::shared_ptr<Organism>& organism, float x, float
  * @throws std::out_of_range If coordinates are out of bounds.
  */
 void Environment::add(const std::shared_ptr<Food>& food, float x, float y) {
+    touch();
     checkBounds(x, y);
     auto id = food->getId();
     food->setPosition(x, y);
     spatialIndex->insert(id, x, y);
-    objectsMapper.insert({id, food});
+    if (objectsMapper.insert({id, food}).second) stats.onAdded(*food);
 }
 
 /**
@@ -77,10 +175,12 @@ void Environment::add(const std::shared_ptr<Food>& food, float x, float y) {
  * @throws std::runtime_error If the organism is not found.
  */
 void Environment::remove(const std::shared_ptr<Organism>& organism) {
+    touch();
     if (objectsMapper.find(organism->getId()) == objectsMapper.end()) {
         throw std::runtime_error("Organism not found in Environment.");
     }
     spatialIndex->remove(organism->getId());
+    stats.onRemoved(*organism);
     objectsMapper.erase(organism->getId());
 }
 
@@ -90,10 +190,12 @@ void Environment::remove(const std::shared_ptr<Organism>& organism) {
  * @throws std::runtime_error If the food is not found.
  */
 void Environment::remove(const std::shared_ptr<Food>& food) {
+    touch();
     if (objectsMapper.find(food->getId()) == objectsMapper.end()) {
         throw std::runtime_error("Food not found in Environment.");
     }
     spatialIndex->remove(food->getId());
+    stats.onRemoved(*food);
     objectsMapper.erase(food->getId());
 }
 
@@ -105,11 +207,16 @@ void Environment::remove(const std::shared_ptr<Food>& food) {
  * @throws std::out_of_range If coordinates are out of bounds.
  */
 void Environment::add(const std::shared_ptr<EnvironmentObject>& object, float x, float y) {
+    touch();
+    if (object->getKind() == ObjectKind::ORGANISM) {
+        add(std::static_pointer_cast<Organism>(object), x, y);
+        return;
+    }
     checkBounds(x, y);
     auto id = object->getId();
     object->setPosition(x, y);
     spatialIndex->insert(id, x, y);
-    objectsMapper.insert({id, object});
+    if (objectsMapper.insert({id, object}).second) stats.onAdded(*object);
 }
 
 /**
@@ -118,10 +225,12 @@ void Environment::add(const std::shared_ptr<EnvironmentObject>& object, float x,
  * @throws std::runtime_error If the object is not found.
  */
 void Environment::remove(const std::shared_ptr<EnvironmentObject>& object) {
+    touch();
     if (objectsMapper.find(object->getId()) == objectsMapper.end()) {
         throw std::runtime_error("Object not found in Environment.");
     }
     spatialIndex->remove(object->getId());
+    stats.onRemoved(*object);
     objectsMapper.erase(object->getId());
 }
 
@@ -129,10 +238,15 @@ void Environment::remove(const std::shared_ptr<EnvironmentObject>& object) {
  * @brief Reset the environment, removing all objects and clearing statistics.
  */
 void Environment::reset() {
+    touch();
+    stats.clear();
     spatialIndex->clear();
     objectsMapper.clear();
+    species.clear();
     deadOrganisms.clear();
     foodConsumption = 0;
+    foodEatenTotal = 0;
+    foodEatenInTick = 0;
 }
 
 /**
@@ -147,40 +261,62 @@ void Environment::reset() {
  */
 void Environment::simulateIteration(int iterations,
                                     std::function<void(const Environment&)> on_each_iteration) {
-    Profiler& profiler = Profiler::getInstance();
-    profiler.reset();
-
-    profiler.start("simulateIteration");
-    for (int i = 0; i < iterations; i++) {
-        if (getAllOrganisms().empty() && getAllFoods().empty()) {
-            break;
-        }
-
-        profiler.start("handleInteractions");
-        handleInteractions();
-        profiler.stop("handleInteractions");
+    ProfileBinding profiling(profileTargets());
+    ProfileSnapshot before;
+    if (verbose) before = profile->zones.snapshot();
+    // Opened per call so they follow whichever thread simulates
+    std::unique_ptr<PerfCounters> counters;
+    if (hardwareCounters) counters = std::make_unique<PerfCounters>();
+    if (counters && !counters->available()) counters.reset();
+    // Only threads started after the counters open inherit them
+    if (counters) reactionWorkers.reset();
+
+    {
+        PROFILE_ZONE(SIMULATE_ITERATION);
+        for (int i = 0; i < iterations; i++) {
+            if (getAllOrganisms().empty() && getAllFoods().empty()) {
+                break;
+            }
+            PROFILE_ZONE(TICK);
+            profile->addTick();
 
-        profiler.start("handleReactions");
-        handleReactions();
-        profiler.stop("handleReactions");
+            {
+                PROFILE_ZONE(HANDLE_INTERACTIONS);
+                CountedZone counted(counters.get(), *profile, ProfileZone::HANDLE_INTERACTIONS);
+                handleInteractions();
+            }
+            {
+                PROFILE_ZONE(HANDLE_REACTIONS);
+                CountedZone counted(counters.get(), *profile, ProfileZone::HANDLE_REACTIONS);
+                handleReactions();
+            }
+            {
+                PROFILE_ZONE(POST_ITERATION);
+                CountedZone counted(counters.get(), *profile, ProfileZone::POST_ITERATION);
+                postIteration();
+            }
 
-        profiler.start("postIteration");
-        postIteration();
-        profiler.stop("postIteration");
+            if (recorder) {
+                recorder->capture(*this, ticks);
+            }
+            if (liveFeed) {
+                liveFeed->publish(*this, ticks);
+            }
 
-        if (on_each_iteration) {
-            on_each_iteration(*this);
+            if (on_each_iteration) {
+                PROFILE_ZONE(ON_EACH_ITERATION);
+                on_each_iteration(*this);
+            }
         }
     }
-    profiler.stop("simulateIteration");
 
-    cleanUp();
+    {
+        CountedZone counted(counters.get(), *profile, ProfileZone::CLEAN_UP);
+        cleanUp();
+    }
 
     if (verbose) {
-        profiler.report("handleInteractions");
-        profiler.report("handleReactions");
-        profiler.report("postIteration");
-        profiler.report("simulateIteration");
+        (profile->zones.snapshot() - before).report(std::cout);
         printf("Index type: %s\n", type.c_str());
         printf("Number of threads: %d\n", numThreads);
         printf("Total food consumption: %lu\n", foodConsumption);
@@ -190,6 +326,244 @@ void Environment::simulateIteration(int iterations,
     }
 }
 
+void Environment::setTracing(std::size_t capacity) {
+    trace = capacity > 0 ? std::make_shared<TraceBuffer>(capacity) : nullptr;
+}
+
+void Environment::dumpTrace(const std::string& path) const {
+    if (!trace) throw std::runtime_error("Tracing is off; call setTracing() first.");
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot create trace file: " + path);
+    trace->writeChromeTrace(out);
+    if (!out.flush()) throw std::runtime_error("Failed to write trace file: " + path);
+}
+
+bool Environment::setHardwareCounters(bool enabled) {
+    hardwareCounters = enabled;
+    return PerfCounters().available();
+}
+
+/**
+ * @brief Snapshot the profile and give each strategy policy its current species id.
+ *
+ * Costs are kept per policy, so they survive species renumbering by
+ * compactSpecies(); policies no species uses any more have no id.
+ */
+SimulationProfile Environment::getProfile() const {
+    SimulationProfile result = profile->snapshot();
+    const auto policies = profile->strategyPolicies();
+    for (auto& strategy : result.strategies) {
+        std::optional<Organism::SpeciesId> id;
+        if (auto policy = policies[strategy.policy].lock()) {
+            id = species.find(static_cast<const Organism::Policy*>(policy.get()));
+        }
+        strategy.hasSpecies = id.has_value();
+        strategy.species = id.value_or(0);
+    }
+    return result;
+}
+
+bool Environment::requiresGil() const {
+    for (const auto& object : objectsMapper) {
+        switch (object.second->getKind()) {
+            case ObjectKind::ORGANISM:
+                if (object.second->as<Organism>()->requiresGil()) return true;
+                break;
+            case ObjectKind::FOOD:
+                break;
+            case ObjectKind::CUSTOM:
+                return true;
+        }
+    }
+    return false;
+}
+
+void Environment::simulateGenerations(int generations, int iterationsPerGeneration,
+                                      const GenerationPolicy& policy,
+                                      std::function<void(const Environment&, int)> on_each_generation) {
+    // Validate every region up front so a bad one does not fail mid-run
+    for (const auto& region : policy.foodRegions) {
+        if (!(region.x0 < region.x1) || !(region.y0 < region.y1)) {
+            throw std::invalid_argument("Food region is empty or inverted.");
+        }
+        checkBounds(region.x0, region.y0);
+        checkBounds(region.x1, region.y1);
+    }
+
+    ProfileBinding profiling(profileTargets());
+    for (int generation = 0; generation < generations; generation++) {
+        if (getAllOrganisms().empty()) {
+            break;
+        }
+        for (const auto& region : policy.foodRegions) {
+            distributeFood(region, policy.foodEnergy);
+        }
+
+        simulateIteration(iterationsPerGeneration);
+
+        if (on_each_generation) {
+            on_each_generation(*this, generation);
+        }
+        if (policy.reproduce) {
+            reproduceOrganisms(policy.reproductionThreshold, policy.maxPopulation);
+        }
+        if (policy.resetFood) {
+            removeAllFoods();
+        }
+    }
+}
+
+void Environment::distributeFood(const FoodRegion& region, int energy) {
+    touch();
+    if (!(region.x0 < region.x1) || !(region.y0 < region.y1)) {
+        throw std::invalid_argument("Food region is empty or inverted.");
+    }
+    checkBounds(region.x0, region.y0);
+    checkBounds(region.x1, region.y1);
+
+    std::uniform_real_distribution<float> xs(region.x0, region.x1);
+    std::uniform_real_distribution<float> ys(region.y0, region.y1);
+    for (std::size_t i = 0; i < region.count; i++) {
+        auto food = std::make_shared<Food>(energy);
+        float x = xs(rng), y = ys(rng);
+        food->setPosition(x, y);
+        spatialIndex->insert(food->getId(), x, y);
+        stats.onAdded(*food);
+        objectsMapper.insert({food->getId(), food});
+    }
+}
+
+std::size_t Environment::reproduceOrganisms(float threshold, std::size_t maxPopulation) {
+    auto organisms = getAllOrganisms();
+    std::size_t population = organisms.size();
+    std::size_t added = 0;
+    for (const auto& organism : organisms) {
+        if (maxPopulation != 0 && population >= maxPopulation) break;
+        if (organism->getLifeSpan() <= threshold) continue;
+
+        auto child = organism->reproduce();
+        Vec2 pos = organism->getPos();
+        add(child, pos.x, pos.y);
+        population++;
+        added++;
+    }
+    return added;
+}
+
+void Environment::removeAllFoods() {
+    touch();
+    for (auto it = objectsMapper.begin(); it != objectsMapper.end();) {
+        if (it->second->getKind() == ObjectKind::FOOD) {
+            if (!it->second->as<Food>()->canBeEaten()) foodConsumption += 1;
+            stats.onRemoved(*it->second);
+            it = objectsMapper.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    rebuildSpatialIndex();
+}
+
+void Environment::addFoods(std::span<const float> xs, std::span<const float> ys,
+                           std::span<const int> energies) {
+    touch();
+    if (xs.size() != ys.size() || (!energies.empty() && energies.size() != xs.size())) {
+        throw std::invalid_argument("addFoods: xs, ys and energies must have the same length.");
+    }
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        checkBounds(xs[i], ys[i]);
+    }
+
+    std::vector<boost::uuids::uuid> ids;
+    std::vector<std::pair<float, float>> positions;
+    ids.reserve(xs.size());
+    positions.reserve(xs.size());
+    objectsMapper.reserve(objectsMapper.size() + xs.size());
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        auto food = energies.empty() ? std::make_shared<Food>()
+                                     : std::make_shared<Food>(energies[i]);
+        food->setPosition(xs[i], ys[i]);
+        ids.push_back(food->getId());
+        positions.emplace_back(xs[i], ys[i]);
+        stats.onAdded(*food);
+        objectsMapper.emplace(food->getId(), std::move(food));
+    }
+    spatialIndex->insertBulk(ids, positions);
+}
+
+void Environment::addOrganisms(std::span<const std::uint8_t> dna, std::span<const float> xs,
+                               std::span<const float> ys,
+                               std::shared_ptr<const Organism::Policy> policy) {
+    touch();
+    if (xs.size() != ys.size() || dna.size() != xs.size() * 4) {
+        throw std::invalid_argument(
+            "addOrganisms: dna must have 4 bytes per organism and xs, ys the same length.");
+    }
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        checkBounds(xs[i], ys[i]);
+    }
+
+    if (!policy) policy = Organism::defaultPolicy();
+    auto speciesId = species.intern(policy);
+
+    std::vector<boost::uuids::uuid> ids;
+    std::vector<std::pair<float, float>> positions;
+    ids.reserve(xs.size());
+    positions.reserve(xs.size());
+    objectsMapper.reserve(objectsMapper.size() + xs.size());
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        const char* row = reinterpret_cast<const char*>(dna.data() + i * 4);
+        auto organism = std::make_shared<Organism>(Genes(row), policy);
+        organism->setSpeciesId(speciesId);
+        organism->setPosition(xs[i], ys[i]);
+        ids.push_back(organism->getId());
+        positions.emplace_back(xs[i], ys[i]);
+        stats.onAdded(*organism);
+        objectsMapper.emplace(organism->getId(), std::move(organism));
+    }
+    spatialIndex->insertBulk(ids, positions);
+}
+
+std::size_t Environment::removeWhere(
+    const std::function<bool(const EnvironmentObject&)>& predicate) {
+    touch();
+    // Decide first, erase after: a throwing predicate leaves the environment untouched
+    std::vector<boost::uuids::uuid> toRemove;
+    for (const auto& object : objectsMapper) {
+        if (predicate(*object.second)) toRemove.push_back(object.first);
+    }
+    if (toRemove.empty()) return 0;
+
+    for (const auto& id : toRemove) {
+        auto it = objectsMapper.find(id);
+        stats.onRemoved(*it->second);
+        objectsMapper.erase(it);
+    }
+    rebuildSpatialIndex();
+    if (species.size() > 1) compactSpecies();
+    return toRemove.size();
+}
+
+std::size_t Environment::removeKind(ObjectKind kind) {
+    return removeWhere([kind](const EnvironmentObject& object) { return object.getKind() == kind; });
+}
+
+void Environment::rebuildSpatialIndex() {
+    ProfileBinding profiling(profileTargets());
+    PROFILE_ZONE(REBUILD_INDEX);
+    std::vector<boost::uuids::uuid> ids;
+    std::vector<std::pair<float, float>> positions;
+    ids.reserve(objectsMapper.size());
+    positions.reserve(objectsMapper.size());
+    for (const auto& object : objectsMapper) {
+        Vec2 pos = object.second->getPos();
+        ids.push_back(object.first);
+        positions.emplace_back(pos.x, pos.y);
+    }
+    spatialIndex->clear();
+    spatialIndex->insertBulk(ids, positions);
+}
+
 /**
  * @brief Remove dead organisms and consumed food from the environment.
  *
@@ -198,23 +572,49 @@ void Environment::simulateIteration(int iterations,
  * to avoid invalidating the iterator during traversal.
  */
 void Environment::cleanUp() {
+    PROFILE_ZONE(CLEAN_UP);
+    touch();
     std::vector<boost::uuids::uuid> toRemove;
     for (const auto& object : objectsMapper) {
-        auto organism = std::dynamic_pointer_cast<Organism>(object.second);
-        auto food = std::dynamic_pointer_cast<Food>(object.second);
-        if (organism && !organism->isAlive()) {
-            deadOrganisms.push_back(organism);
+        const auto kind = object.second->getKind();
+        if (kind == ObjectKind::ORGANISM && !object.second->as<Organism>()->isAlive()) {
+            deadOrganisms.push_back(std::static_pointer_cast<Organism>(object.second));
             toRemove.push_back(object.first);
-        }
-        if (food && !food->canBeEaten()) {
+        } else if (kind == ObjectKind::FOOD && !object.second->as<Food>()->canBeEaten()) {
             foodConsumption += 1;
             toRemove.push_back(object.first);
         }
     }
     for (const auto& id : toRemove) {
         spatialIndex->remove(id);
-        objectsMapper.erase(id);
+        auto it = objectsMapper.find(id);
+        stats.onRemoved(*it->second);
+        objectsMapper.erase(it);
+    }
+
+    profile->addRemoved(toRemove.size());
+
+    if (!toRemove.empty() && species.size() > 1) {
+        compactSpecies();
+    }
+}
+
+/**
+ * @brief Re-intern the policies of living organisms into a fresh species table.
+ *
+ * Organisms created with per-organism strategies would otherwise keep the
+ * table (and the callables it references) growing for the lifetime of the
+ * environment. Ids may change; they are only meaningful within one run.
+ */
+void Environment::compactSpecies() {
+    SpeciesTable compacted;
+    for (const auto& object : objectsMapper) {
+        if (object.second->getKind() == ObjectKind::ORGANISM) {
+            Organism* organism = object.second->as<Organism>();
+            organism->setSpeciesId(compacted.intern(organism->getPolicy()));
+        }
     }
+    species = std::move(compacted);
 }
 
 /** @brief Get the list of organisms that died during the simulation. */
@@ -229,10 +629,45 @@ unsigned long Environment::getFoodConsumptionInIteration() const { return foodCo
  * @brief Run per-object post-iteration logic, then sync positions with the spatial index.
  */
 void Environment::postIteration() {
+    touch();
+    // The per-tick sample is gathered in the same pass that moves objects
+    PopulationStats::TickSample sample;
+    double lifeSpan = 0.0, speed = 0.0, size = 0.0, awareness = 0.0;
+    std::uint64_t eatenPending = 0;
     for (auto& object : objectsMapper) {
         object.second->postIteration();
+        if (object.second->getKind() == ObjectKind::ORGANISM) {
+            const Organism* organism = object.second->as<Organism>();
+            if (!organism->isAlive()) continue;
+            sample.organisms++;
+            lifeSpan += organism->getLifeSpan();
+            speed += organism->getSpeed();
+            size += organism->getSize();
+            awareness += organism->getAwareness();
+        } else if (object.second->getKind() == ObjectKind::FOOD) {
+            if (object.second->as<Food>()->canBeEaten()) {
+                sample.foods++;
+            } else {
+                eatenPending++;
+            }
+        }
     }
     updatePositionsInSpatialIndex();
+
+    // Eaten food stays until cleanUp() counts it, so the total only grows;
+    // removeWhere() and reset() drop eaten food uncounted, hence the clamp
+    const std::uint64_t eatenTotal = foodConsumption + eatenPending;
+    foodEatenInTick = eatenTotal > foodEatenTotal ? eatenTotal - foodEatenTotal : 0;
+    foodEatenTotal = eatenTotal;
+
+    sample.tick = ++ticks;
+    if (sample.organisms > 0) {
+        sample.meanLifeSpan = static_cast<float>(lifeSpan / sample.organisms);
+        sample.meanSpeed = static_cast<float>(speed / sample.organisms);
+        sample.meanSize = static_cast<float>(size / sample.organisms);
+        sample.meanAwareness = static_cast<float>(awareness / sample.organisms);
+    }
+    stats.record(sample);
 }
 
 /**
@@ -241,9 +676,12 @@ void Environment::postIteration() {
  * Clamps organism positions within environment bounds before updating the index.
  */
 void Environment::updatePositionsInSpatialIndex() {
+    PROFILE_ZONE(UPDATE_INDEX);
+    std::uint64_t updates = 0;
     for (auto& object : objectsMapper) {
-        auto organism = std::dynamic_pointer_cast<Organism>(object.second);
-        if (organism && organism->isAlive()) {
+        if (object.second->getKind() != ObjectKind::ORGANISM) continue;
+        Organism* organism = object.second->as<Organism>();
+        if (organism->isAlive()) {
             auto [x, y] = organism->getPosition();
 
             // Clamp organism position within environment bounds
@@ -252,8 +690,66 @@ void Environment::updatePositionsInSpatialIndex() {
 
             organism->setPosition(x, y);
             spatialIndex->update(object.first, x, y);
+            updates++;
         }
     }
+    profile->addIndexUpdates(updates);
+}
+
+/**
+ * @brief Gather the objects within a radius of an organism, excluding itself.
+ * @param organism The querying organism.
+ * @param radius Query radius around the organism's position.
+ * @param out Cleared and filled with the neighbouring objects.
+ */
+void Environment::collectNeighbours(const Organism& organism, float radius,
+                                    std::vector<std::shared_ptr<EnvironmentObject>>& out,
+                                    QueryTally& tally) {
+    out.clear();
+    Vec2 position = organism.getPos();
+    auto ids = spatialIndex->query(position.x, position.y, radius);
+    for (auto& id : ids) {
+        if (id == organism.getId()) continue;
+        auto it = objectsMapper.find(id);
+        if (it != objectsMapper.end()) {
+            out.push_back(it->second);
+        }
+    }
+    tally.add(out.size());
+}
+
+/**
+ * @brief Get the species id of an organism, re-interning it if its policy changed.
+ * @param organism An organism owned by this environment.
+ * @return A valid index into the species table for the organism's current policy.
+ */
+Organism::SpeciesId Environment::resolveSpecies(Organism& organism) {
+    auto id = organism.getSpeciesId();
+    if (id >= species.size() || species.get(id) != organism.getPolicy()) {
+        id = species.intern(organism.getPolicy());
+        organism.setSpeciesId(id);
+    }
+    return id;
+}
+
+/**
+ * @brief Merge a phase's strategy costs into the profile by policy.
+ * @param tally Costs keyed by species ids of the current species table.
+ *
+ * Only reads the species table, so reaction workers may call it concurrently.
+ */
+void Environment::mergeStrategies(const StrategyTally& tally) {
+    profile->merge(tally, [this](std::uint16_t id) {
+        StrategyOwner owner;
+        if (id >= species.size()) return owner;
+        const auto& policy = species.get(id);
+        owner.policy = policy;
+        for (std::size_t call = 0; call < STRATEGY_CALL_COUNT; call++) {
+            owner.implementations[call] =
+                strategyImplementation(*policy, static_cast<StrategyCall>(call));
+        }
+        return owner;
+    });
 }
 
 /**
@@ -264,61 +760,224 @@ void Environment::updatePositionsInSpatialIndex() {
  */
 void Environment::handleInteractions() {
     auto organisms = getAllOrganisms();
+    std::vector<std::shared_ptr<EnvironmentObject>> interactableObjects;
+    QueryTally tally;
+    StrategyTally strategies;
+    StrategyTally::Binding attributing(strategies);
 
     for (auto& organism : organisms) {
         if (organism->isAlive()) {
-            auto position = organism->getPosition();
-            // Query spatial index for objects within this organism's body size radius
-            auto interactables =
-                spatialIndex->query(position.first, position.second, organism->getSize());
-            std::vector<std::shared_ptr<EnvironmentObject>> interactableObjects;
-
-            for (auto& interactable : interactables) {
-                // Exclude self from interaction targets
-                if (interactable != organism->getId()) {
-                    auto it = objectsMapper.find(interactable);
-                    if (it != objectsMapper.end()) {
-                        interactableObjects.push_back(it->second);
-                    }
-                }
-            }
-
+            resolveSpecies(*organism);
+            // Objects within this organism's body size radius
+            collectNeighbours(*organism, organism->getSize(), interactableObjects, tally);
             organism->interact(interactableObjects);
         }
     }
+    profile->merge(tally);
+    mergeStrategies(strategies);
+    profile->addInteracted(tally.queries);
 }
 
 /**
  * @brief Run the reaction phase: organisms decide movement direction.
  *
- * Currently runs single-threaded for GIL safety with Python strategy callbacks.
- * TODO: Re-enable multi-threading for this phase. Each organism only writes to
- * its own movement/reactionCounter fields, so it is inherently parallelizable.
- * Options: (1) detect at runtime if any organism has a custom strategy and only
- * fall back to single-threaded in that case, or (2) use py::gil_scoped_release
- * before spawning worker threads.
+ * Organisms whose species has a BatchReactionStrategy are grouped and handed
+ * to that strategy once per species; everyone else reacts individually.
+ *
+ * Individual reactions only write to each organism's own movement and
+ * reactionCounter fields, so they are split across numThreads workers when
+ * no organism uses a std::function reaction (which may need the Python GIL).
+ * Built-in and native strategies run in parallel, on a WorkerPool the
+ * environment keeps between ticks.
  */
 void Environment::handleReactions() {
     auto organisms = getAllOrganisms();
+    std::vector<std::vector<Organism*>> batchedSpecies(species.size());
+    std::vector<Organism*> individual;
+    individual.reserve(organisms.size());
+    bool callbacksInvolved = false;
 
     for (auto& organism : organisms) {
-        if (organism->isAlive()) {
-            auto position = organism->getPosition();
-            auto reactables = spatialIndex->query(
-                position.first, position.second, organism->getReactionRadius());
-            std::vector<std::shared_ptr<EnvironmentObject>> reactableObjects;
-            for (auto& reactable : reactables) {
-                if (reactable != organism->getId()) {
-                    auto it = objectsMapper.find(reactable);
-                    if (it != objectsMapper.end()) {
-                        reactableObjects.push_back(it->second);
-                    }
+        if (!organism->isAlive()) continue;
+
+        auto id = resolveSpecies(*organism);
+        const auto& policy = *species.get(id);
+        if (policy.batchReactionStrategy) {
+            if (id >= batchedSpecies.size()) batchedSpecies.resize(species.size());
+            batchedSpecies[id].push_back(organism.get());
+            continue;
+        }
+
+        callbacksInvolved = callbacksInvolved || static_cast<bool>(policy.reactionStrategy);
+        individual.push_back(organism.get());
+    }
+
+    auto reactRange = [this, &individual](std::size_t begin, std::size_t end) {
+        ProfileBinding profiling(profileTargets());
+        PROFILE_ZONE(REACTION_WORKER);
+        std::vector<std::shared_ptr<EnvironmentObject>> reactableObjects;
+        QueryTally tally;
+        StrategyTally strategies;
+        StrategyTally::Binding attributing(strategies);
+        for (std::size_t i = begin; i < end; i++) {
+            collectNeighbours(*individual[i], individual[i]->getReactionRadius(),
+                              reactableObjects, tally);
+            individual[i]->react(reactableObjects);
+        }
+        profile->merge(tally);
+        mergeStrategies(strategies);
+        profile->addReacted(end - begin);
+    };
+
+    std::size_t workers = callbacksInvolved ? 1 : static_cast<std::size_t>(std::max(1, numThreads));
+    workers = std::min(workers, individual.size());
+    if (workers <= 1) {
+        reactRange(0, individual.size());
+    } else {
+        // numThreads can change with decodeSnapshot(), so the pool follows it
+        const auto poolSize = static_cast<std::size_t>(numThreads);
+        if (!reactionWorkers || reactionWorkers->size() != poolSize) {
+            reactionWorkers = std::make_unique<WorkerPool>(poolSize);
+        }
+        std::size_t chunk = (individual.size() + workers - 1) / workers;
+        std::size_t chunks = (individual.size() + chunk - 1) / chunk;
+        reactionWorkers->run(chunks, [&](std::size_t c) {
+            reactRange(c * chunk, std::min((c + 1) * chunk, individual.size()));
+        });
+    }
+
+    for (std::size_t id = 0; id < batchedSpecies.size(); id++) {
+        if (!batchedSpecies[id].empty()) {
+            reactInBatch(species.get(id)->batchReactionStrategy, batchedSpecies[id]);
+        }
+    }
+}
+
+/**
+ * @brief Build a ReactionBatch for one species, run its strategy once, apply the results.
+ * @param strategy The species' batched reaction strategy.
+ * @param members Living organisms of the species.
+ *
+ * Each distinct neighbour appears once in the batch's neighbour arrays, no
+ * matter how many members can see it.
+ */
+void Environment::reactInBatch(const Organism::BatchReactionStrategy& strategy,
+                               const std::vector<Organism*>& members) {
+    ReactionBatch& batch = reactionBatch;
+    batch.clear();
+    batch.neighbourOffsets.push_back(0);
+
+    std::unordered_map<const EnvironmentObject*, std::uint32_t> neighbourRows;
+    std::vector<std::shared_ptr<EnvironmentObject>> reactableObjects;
+    QueryTally tally;
+
+    for (Organism* organism : members) {
+        Vec2 position = organism->getPos();
+        batch.positions.insert(batch.positions.end(), {position.x, position.y});
+        batch.traits.insert(batch.traits.end(),
+                            {organism->getSpeed(), organism->getSize(), organism->getAwareness(),
+                             organism->getLifeSpan()});
+
+        collectNeighbours(*organism, organism->getReactionRadius(), reactableObjects, tally);
+        for (const auto& object : reactableObjects) {
+            auto [it, inserted] = neighbourRows.try_emplace(
+                object.get(), static_cast<std::uint32_t>(batch.neighbourKinds.size()));
+            if (inserted) {
+                Vec2 objectPos = object->getPos();
+                ObjectKind kind = object->getKind();
+                float size = 0.0f;
+                bool active = true;
+                if (kind == ObjectKind::ORGANISM) {
+                    size = object->as<Organism>()->getSize();
+                    active = object->as<Organism>()->isAlive();
+                } else if (kind == ObjectKind::FOOD) {
+                    active = object->as<Food>()->canBeEaten();
                 }
+                batch.neighbourPositions.insert(batch.neighbourPositions.end(),
+                                                {objectPos.x, objectPos.y});
+                batch.neighbourSizes.push_back(size);
+                batch.neighbourKinds.push_back(static_cast<std::uint8_t>(kind));
+                batch.neighbourActive.push_back(active ? 1 : 0);
             }
+            batch.neighbourIndices.push_back(it->second);
+        }
+        batch.neighbourOffsets.push_back(static_cast<std::uint32_t>(batch.neighbourIndices.size()));
+    }
 
-            organism->react(reactableObjects);
+    profile->merge(tally);
+    profile->addReacted(members.size());
+
+    std::vector<Vec2> movements(members.size());
+    {
+        StrategyTally strategies;
+        StrategyTally::Binding attributing(strategies);
+        {
+            StrategyScope attributed(members.front()->getSpeciesId(),
+                                     StrategyCall::BATCH_REACTION, batch.neighbourIndices.size());
+            strategy(batch, movements);
         }
+        mergeStrategies(strategies);
     }
+
+    for (std::size_t i = 0; i < members.size(); i++) {
+        members[i]->applyReaction(movements[i]);
+    }
+}
+
+/**
+ * @brief Build (or reuse) the column-oriented snapshot of all objects.
+ *
+ * Rows are grouped organisms, then food, then custom objects, in one pass
+ * per kind over the object map.
+ */
+std::shared_ptr<const EnvironmentState> Environment::getState() const {
+    if (cachedState && cachedState->version == version) {
+        return cachedState;
+    }
+
+    auto state = std::make_shared<EnvironmentState>();
+    state->version = version;
+    const std::size_t n = objectsMapper.size();
+    state->positions.reserve(n * 2);
+    state->kinds.reserve(n);
+    state->alive.reserve(n);
+    state->lifeSpans.reserve(n);
+    state->energies.reserve(n);
+    state->traits.reserve(n * EnvironmentState::TRAIT_COUNT);
+    state->species.reserve(n);
+
+    for (ObjectKind kind : {ObjectKind::ORGANISM, ObjectKind::FOOD, ObjectKind::CUSTOM}) {
+        for (const auto& object : objectsMapper) {
+            const EnvironmentObject& base = *object.second;
+            if (base.getKind() != kind) continue;
+
+            Vec2 pos = base.getPos();
+            state->positions.insert(state->positions.end(), {pos.x, pos.y});
+            state->kinds.push_back(static_cast<std::uint8_t>(kind));
+            if (kind == ObjectKind::ORGANISM) {
+                const Organism* organism = base.as<Organism>();
+                state->alive.push_back(organism->isAlive() ? 1 : 0);
+                state->lifeSpans.push_back(organism->getLifeSpan());
+                state->energies.push_back(0.0f);
+                state->traits.insert(state->traits.end(), {organism->getSpeed(),
+                                                           organism->getSize(),
+                                                           organism->getAwareness()});
+                state->species.push_back(organism->getSpeciesId());
+                state->organismCount++;
+            } else {
+                bool isFood = kind == ObjectKind::FOOD;
+                state->alive.push_back(isFood ? (base.as<Food>()->canBeEaten() ? 1 : 0) : 1);
+                state->lifeSpans.push_back(0.0f);
+                state->energies.push_back(isFood ? base.as<Food>()->getEnergy() : 0.0f);
+                state->traits.insert(state->traits.end(), {0.0f, 0.0f, 0.0f});
+                state->species.push_back(0);
+                if (isFood) state->foodCount++;
+            }
+        }
+    }
+
+    cachedState = std::move(state);
+    return cachedState;
 }
 
 /** @brief Get all objects (organisms and food) in the environment. */
@@ -334,8 +993,8 @@ std::vector<std::shared_ptr<EnvironmentObject>> Environment::getAllObjects() con
 std::vector<std::shared_ptr<Organism>> Environment::getAllOrganisms() const {
     std::vector<std::shared_ptr<Organism>> organisms;
     for (const auto& object : objectsMapper) {
-        if (auto organism = std::dynamic_pointer_cast<Organism>(object.second)) {
-            organisms.push_back(organism);
+        if (object.second->getKind() == ObjectKind::ORGANISM) {
+            organisms.push_back(std::static_pointer_cast<Organism>(object.second));
         }
     }
     return organisms;
@@ -345,8 +1004,8 @@ std::vector<std::shared_ptr<Organism>> Environment::getAllOrganisms() const {
 std::vector<std::shared_ptr<Food>> Environment::getAllFoods() const {
     std::vector<std::shared_ptr<Food>> foods;
     for (const auto& object : objectsMapper) {
-        if (auto food = std::dynamic_pointer_cast<Food>(object.second)) {
-            foods.push_back(food);
+        if (object.second->getKind() == ObjectKind::FOOD) {
+            foods.push_back(std::static_pointer_cast<Food>(object.second));
         }
     }
     return foods;
@@ -0,0 +1,432 @@
+#include <array>
+#include <core/Environment.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Snapshot layout (native byte order, no padding):
+ *
+ *   header    magic[8] "SIMEVOSN", u32 format version, u32 byte-order mark,
+ *             i32 width, i32 height, i32 threads, str index type,
+ *             u64 food consumption, u64 ticks, str RNG state
+ *   organisms living/not yet cleaned up, then dead (two blocks)
+ *   foods
+ *
+ * A block is a u64 count followed by one contiguous column per field, so the
+ * decoder copies whole columns out of the (mapped) buffer. Strings are a u32
+ * length followed by the characters.
+ */
+
+namespace {
+
+constexpr std::array<char, 8> SNAPSHOT_MAGIC = {'S', 'I', 'M', 'E', 'V', 'O', 'S', 'N'};
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+class SnapshotWriter {
+public:
+    template <typename T>
+    void put(const T& value) {
+        append(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void putColumn(const std::vector<T>& column) {
+        append(column.data(), column.size() * sizeof(T));
+    }
+
+    void putString(const std::string& value) {
+        put(static_cast<std::uint32_t>(value.size()));
+        append(value.data(), value.size());
+    }
+
+    std::string bytes;
+
+private:
+    void append(const void* data, std::size_t size) {
+        bytes.append(static_cast<const char*>(data), size);
+    }
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(std::span<const char> bytes) : bytes(bytes) {}
+
+    template <typename T>
+    T get() {
+        T value;
+        copy(&value, 1, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    std::vector<T> getColumn(std::size_t count) {
+        std::vector<T> column(checkedCount(count, sizeof(T)));
+        copy(column.data(), count, sizeof(T));
+        return column;
+    }
+
+    std::string getString() {
+        auto size = get<std::uint32_t>();
+        std::string value(checkedCount(size, 1), '\0');
+        copy(value.data(), size, 1);
+        return value;
+    }
+
+    bool atEnd() const { return offset == bytes.size(); }
+
+private:
+    std::span<const char> bytes;
+    std::size_t offset = 0;
+
+    // Reject counts that cannot fit in the remaining bytes before allocating
+    std::size_t checkedCount(std::size_t count, std::size_t elementSize) const {
+        if (count > (bytes.size() - offset) / elementSize) {
+            throw std::runtime_error("Snapshot is truncated or corrupt.");
+        }
+        return count;
+    }
+
+    void copy(void* out, std::size_t count, std::size_t elementSize) {
+        std::size_t size = checkedCount(count, elementSize) * elementSize;
+        if (size == 0) return;
+        std::memcpy(out, bytes.data() + offset, size);
+        offset += size;
+    }
+};
+
+/** @brief Read-only view of a whole file, memory-mapped where the platform allows. */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open snapshot: " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat snapshot: " + path);
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map snapshot: " + path);
+            }
+            data = static_cast<const char*>(mapped);
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("Cannot open snapshot: " + path);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        buffer = contents.str();
+        data = buffer.data();
+        size = buffer.size();
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data) ::munmap(const_cast<char*>(data), size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const char> bytes() const { return {data, size}; }
+
+private:
+    const char* data = nullptr;
+    std::size_t size = 0;
+#ifdef _WIN32
+    std::string buffer;
+#endif
+};
+
+}  // namespace
+
+/**
+ * @brief Serialise the environment into the columnar snapshot format.
+ *
+ * Organisms are written as two blocks (those in the object map, then the
+ * archived dead ones) sharing one column layout.
+ */
+std::string Environment::encodeSnapshot() const {
+    std::vector<const Organism*> living, dead;
+    std::vector<const Food*> foods;
+    for (const auto& object : objectsMapper) {
+        switch (object.second->getKind()) {
+            case ObjectKind::ORGANISM:
+                living.push_back(object.second->as<Organism>());
+                break;
+            case ObjectKind::FOOD:
+                foods.push_back(object.second->as<Food>());
+                break;
+            case ObjectKind::CUSTOM:
+                throw std::runtime_error("Environments with custom objects cannot be snapshotted.");
+        }
+    }
+    for (const auto& organism : deadOrganisms) dead.push_back(organism.get());
+
+    SnapshotWriter writer;
+    writer.put(SNAPSHOT_MAGIC);
+    writer.put(SNAPSHOT_FORMAT_VERSION);
+    writer.put(BYTE_ORDER_MARK);
+    writer.put(static_cast<std::int32_t>(width));
+    writer.put(static_cast<std::int32_t>(height));
+    writer.put(static_cast<std::int32_t>(numThreads));
+    writer.putString(type);
+    writer.put(static_cast<std::uint64_t>(foodConsumption));
+    writer.put(static_cast<std::uint64_t>(ticks));
+    std::ostringstream rngState;
+    rngState << rng;
+    writer.putString(rngState.str());
+
+    for (const auto* organisms : {&living, &dead}) {
+        const std::size_t n = organisms->size();
+        std::vector<boost::uuids::uuid> ids;
+        std::vector<float> positions, lifeSpans, movements;
+        std::vector<char> dna;
+        std::vector<std::uint8_t> reacted;
+        std::vector<Organism::SpeciesId> speciesIds;
+        ids.reserve(n);
+        positions.reserve(2 * n);
+        lifeSpans.reserve(n);
+        movements.reserve(2 * n);
+        dna.reserve(4 * n);
+        reacted.reserve(n);
+        speciesIds.reserve(n);
+        for (const Organism* organism : *organisms) {
+            ids.push_back(organism->id);
+            positions.insert(positions.end(), {organism->position.x, organism->position.y});
+            lifeSpans.push_back(organism->lifeSpan);
+            movements.insert(movements.end(), {organism->movement.x, organism->movement.y});
+            for (int i = 0; i < 4; i++) dna.push_back(organism->genes.getDNA(i));
+            reacted.push_back(organism->reactionCounter != 0 ? 1 : 0);
+            speciesIds.push_back(organism->speciesId);
+        }
+        writer.put(static_cast<std::uint64_t>(n));
+        writer.putColumn(ids);
+        writer.putColumn(positions);
+        writer.putColumn(dna);
+        writer.putColumn(lifeSpans);
+        writer.putColumn(movements);
+        writer.putColumn(reacted);
+        writer.putColumn(speciesIds);
+    }
+
+    std::vector<boost::uuids::uuid> ids;
+    std::vector<float> positions;
+    std::vector<std::int32_t> energies;
+    std::vector<std::uint8_t> eaten;
+    ids.reserve(foods.size());
+    positions.reserve(2 * foods.size());
+    energies.reserve(foods.size());
+    eaten.reserve(foods.size());
+    for (const Food* food : foods) {
+        ids.push_back(food->id);
+        positions.insert(positions.end(), {food->position.x, food->position.y});
+        energies.push_back(food->getEnergy());
+        eaten.push_back(food->canBeEaten() ? 0 : 1);
+    }
+    writer.put(static_cast<std::uint64_t>(foods.size()));
+    writer.putColumn(ids);
+    writer.putColumn(positions);
+    writer.putColumn(energies);
+    writer.putColumn(eaten);
+
+    return std::move(writer.bytes);
+}
+
+/**
+ * @brief Decode a snapshot into fresh objects, then swap them in.
+ *
+ * Everything that can fail (validation, allocation, building the index)
+ * happens before the first member is assigned, and the swap itself only
+ * moves, so a bad snapshot leaves the environment untouched.
+ */
+void Environment::decodeSnapshot(std::span<const char> bytes, PolicyTable policies) {
+    SnapshotReader reader(bytes);
+    if (reader.get<std::array<char, 8>>() != SNAPSHOT_MAGIC) {
+        throw std::runtime_error("Not a SimEvo snapshot.");
+    }
+    auto formatVersion = reader.get<std::uint32_t>();
+    if (formatVersion != SNAPSHOT_FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot format version " +
+                                 std::to_string(formatVersion) + ".");
+    }
+    if (reader.get<std::uint32_t>() != BYTE_ORDER_MARK) {
+        throw std::runtime_error("Snapshot was written on a machine with another byte order.");
+    }
+    const int newWidth = reader.get<std::int32_t>();
+    const int newHeight = reader.get<std::int32_t>();
+    if (newWidth <= 0 || newHeight <= 0) {
+        throw std::runtime_error("Snapshot is corrupt: the world has no area.");
+    }
+    const int newThreads = reader.get<std::int32_t>();
+    std::string newType = reader.getString();
+    const auto newFoodConsumption = reader.get<std::uint64_t>();
+    const auto newTicks = reader.get<std::uint64_t>();
+    std::mt19937 newRng;
+    std::istringstream rngState(reader.getString());
+    rngState >> newRng;
+    if (rngState.fail()) throw std::runtime_error("Snapshot has an invalid RNG state.");
+
+    std::unique_ptr<ISpatialIndex<boost::uuids::uuid>> newIndex;
+    try {
+        newIndex = createSpatialIndex(newType, newWidth, newHeight);
+    } catch (const std::invalid_argument& error) {
+        throw std::runtime_error(std::string("Snapshot is corrupt: ") + error.what());
+    }
+
+    // Rejects NaN too, which would otherwise only fail inside the index
+    auto checkPosition = [&](float x, float y) {
+        if (!(x >= 0.0f && x <= static_cast<float>(newWidth) && y >= 0.0f &&
+              y <= static_cast<float>(newHeight))) {
+            throw std::runtime_error("Snapshot is corrupt: an object lies outside the world.");
+        }
+    };
+
+    auto policyFor = [&](Organism::SpeciesId id) -> std::shared_ptr<const Organism::Policy> {
+        return id < policies.size() && policies[id] ? policies[id] : Organism::defaultPolicy();
+    };
+
+    auto readOrganisms = [&]() {
+        const auto n = static_cast<std::size_t>(reader.get<std::uint64_t>());
+        auto ids = reader.getColumn<boost::uuids::uuid>(n);
+        auto positions = reader.getColumn<float>(2 * n);
+        auto dna = reader.getColumn<char>(4 * n);
+        auto lifeSpans = reader.getColumn<float>(n);
+        auto movements = reader.getColumn<float>(2 * n);
+        auto reacted = reader.getColumn<std::uint8_t>(n);
+        auto speciesIds = reader.getColumn<Organism::SpeciesId>(n);
+
+        std::vector<std::shared_ptr<Organism>> organisms;
+        organisms.reserve(n);
+        for (std::size_t i = 0; i < n; i++) {
+            auto organism =
+                std::make_shared<Organism>(Genes(&dna[4 * i]), policyFor(speciesIds[i]));
+            organism->id = ids[i];
+            organism->position = Vec2(positions[2 * i], positions[2 * i + 1]);
+            organism->lifeSpan = lifeSpans[i];
+            organism->movement = Vec2(movements[2 * i], movements[2 * i + 1]);
+            organism->reactionCounter = reacted[i];
+            organism->speciesId = speciesIds[i];
+            organisms.push_back(std::move(organism));
+        }
+        return organisms;
+    };
+    auto newLiving = readOrganisms();
+    auto newDead = readOrganisms();
+
+    const auto foodCount = static_cast<std::size_t>(reader.get<std::uint64_t>());
+    auto foodIds = reader.getColumn<boost::uuids::uuid>(foodCount);
+    auto foodPositions = reader.getColumn<float>(2 * foodCount);
+    auto energies = reader.getColumn<std::int32_t>(foodCount);
+    auto eaten = reader.getColumn<std::uint8_t>(foodCount);
+    if (!reader.atEnd()) throw std::runtime_error("Snapshot has trailing bytes.");
+
+    SpeciesTable newSpecies;
+    PopulationStats newStats(stats.getHistoryCapacity());
+    std::unordered_map<boost::uuids::uuid, std::shared_ptr<EnvironmentObject>> newObjects;
+    newObjects.reserve(newLiving.size() + foodCount);
+    std::vector<boost::uuids::uuid> indexIds;
+    std::vector<std::pair<float, float>> indexPositions;
+    indexIds.reserve(newLiving.size() + foodCount);
+    indexPositions.reserve(newLiving.size() + foodCount);
+    std::uint64_t eatenPending = 0;
+    for (const auto& organism : newLiving) {
+        checkPosition(organism->position.x, organism->position.y);
+        indexIds.push_back(organism->id);
+        indexPositions.emplace_back(organism->position.x, organism->position.y);
+        organism->speciesId = newSpecies.intern(organism->getPolicy());
+        newStats.onAdded(*organism);
+        newObjects.emplace(organism->id, organism);
+    }
+    for (std::size_t i = 0; i < foodCount; i++) {
+        checkPosition(foodPositions[2 * i], foodPositions[2 * i + 1]);
+        indexIds.push_back(foodIds[i]);
+        indexPositions.emplace_back(foodPositions[2 * i], foodPositions[2 * i + 1]);
+        auto food = std::make_shared<Food>(energies[i]);
+        food->id = foodIds[i];
+        food->position = Vec2(foodPositions[2 * i], foodPositions[2 * i + 1]);
+        if (eaten[i]) {
+            food->eaten();
+            eatenPending++;
+        }
+        newStats.onAdded(*food);
+        newObjects.emplace(food->id, food);
+    }
+    if (newObjects.size() != newLiving.size() + foodCount) {
+        throw std::runtime_error("Snapshot contains duplicate object ids.");
+    }
+    newIndex->insertBulk(indexIds, indexPositions);
+
+    // Nothing below throws
+    touch();
+    width = newWidth;
+    height = newHeight;
+    numThreads = newThreads;
+    type = std::move(newType);
+    spatialIndex = std::move(newIndex);
+    objectsMapper = std::move(newObjects);
+    species = std::move(newSpecies);
+    deadOrganisms = std::move(newDead);
+    foodConsumption = newFoodConsumption;
+    // As postIteration() leaves them, so the next tick counts only its own food
+    foodEatenTotal = newFoodConsumption + eatenPending;
+    foodEatenInTick = 0;
+    ticks = newTicks;
+    rng = newRng;
+    stats = std::move(newStats);
+}
+
+bool Environment::isSnapshotSelfContained() const {
+    for (const auto& object : objectsMapper) {
+        if (object.second->getKind() != ObjectKind::ORGANISM) continue;
+        const auto* organism = object.second->as<Organism>();
+        if (!organism->isAlive()) continue;
+        if (organism->getPolicy() != Organism::defaultPolicy() ||
+            organism->genes.hasCustomMutation()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write the snapshot next to the destination, then rename it over.
+ *
+ * A crash mid-write therefore never destroys the previous checkpoint.
+ */
+void Environment::saveSnapshot(const std::string& path) const {
+    const std::string bytes = encodeSnapshot();
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!out) throw std::runtime_error("Cannot write snapshot: " + path);
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) throw std::runtime_error("Cannot write snapshot: " + path + ": " + error.message());
+}
+
+void Environment::loadSnapshot(const std::string& path, PolicyTable policies) {
+    MappedFile file(path);
+    decodeSnapshot(file.bytes(), policies);
+}
@@ -6,10 +6,19 @@
 Genes::Genes(const char *dnaStr) : Genes(dnaStr, nullptr) {}
 
 Genes::Genes(const char *dnaStr, MutationFunction customMutationLogic = nullptr)
-    : mutationLogic(customMutationLogic ? customMutationLogic : defaultMutationLogic) {
+    : mutationLogic(customMutationLogic
+                        ? std::make_shared<const MutationFunction>(std::move(customMutationLogic))
+                        : defaultMutation()) {
     std::memcpy(dna, dnaStr, 4);
 }
 
+/** @brief Process-wide shared wrapper around defaultMutationLogic. */
+const std::shared_ptr<const Genes::MutationFunction> &Genes::defaultMutation() {
+    static const std::shared_ptr<const MutationFunction> instance =
+        std::make_shared<const MutationFunction>(defaultMutationLogic);
+    return instance;
+}
+
 /**
  * @brief Default mutation: randomly adjusts each gene by -3 to +3.
  * @param dna Array of 4 gene bytes (each 0-255) to mutate in place.
@@ -29,7 +38,7 @@ void Genes::defaultMutationLogic(char dna[4]) {
 }
 
 /** @brief Apply the mutation function to this organism's DNA. */
-void Genes::mutate() { mutationLogic(dna); }
+void Genes::mutate() { (*mutationLogic)(dna); }
 
 /**
  * @brief Access a specific gene value.
@@ -0,0 +1,153 @@
+#include <atomic>
+#include <core/Environment.hpp>
+#include <core/LiveFeed.hpp>
+#include <cstring>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static_assert(sizeof(LiveFeed::SegmentHeader) == 64, "SegmentHeader layout changed");
+static_assert(sizeof(LiveFeed::BufferHeader) == 64, "BufferHeader layout changed");
+static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free,
+              "Cross-process seqlock needs lock-free 64-bit atomics");
+
+namespace {
+
+constexpr std::size_t ORGANISM_COLUMNS = 6;
+constexpr std::size_t FOOD_COLUMNS = 2;
+
+std::size_t alignTo64(std::size_t bytes) { return (bytes + 63) / 64 * 64; }
+
+}  // namespace
+
+LiveFeed::LiveFeed(const std::string& name, std::uint32_t organismCapacity,
+                   std::uint32_t foodCapacity, std::uint32_t interval)
+    : name(name.empty() || name[0] == '/' ? name : "/" + name),
+      organismCapacity(organismCapacity),
+      foodCapacity(foodCapacity),
+      interval(interval) {
+    if (this->name.size() < 2 || this->name.find('/', 1) != std::string::npos) {
+        throw std::invalid_argument("LiveFeed: invalid shared-memory name '" + name + "'.");
+    }
+    if (interval == 0) throw std::invalid_argument("LiveFeed: interval must be positive.");
+
+    bufferBytes = alignTo64(sizeof(BufferHeader) +
+                            (std::size_t{organismCapacity} * ORGANISM_COLUMNS +
+                             std::size_t{foodCapacity} * FOOD_COLUMNS) *
+                                sizeof(float));
+    size = sizeof(SegmentHeader) + 2 * bufferBytes;
+
+#ifndef _WIN32
+    int fd = ::shm_open(this->name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+    if (fd < 0) throw std::runtime_error("Cannot create shared memory: " + this->name);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        ::shm_unlink(this->name.c_str());
+        throw std::runtime_error("Cannot size shared memory: " + this->name);
+    }
+    void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        ::shm_unlink(this->name.c_str());
+        throw std::runtime_error("Cannot map shared memory: " + this->name);
+    }
+    segment = static_cast<char*>(mapped);
+#else
+    throw std::runtime_error("LiveFeed requires POSIX shared memory.");
+#endif
+
+    // ftruncate zero-fills, so both buffers start empty with an even sequence
+    auto* header = reinterpret_cast<SegmentHeader*>(segment);
+    std::memcpy(header->magic, "SIMEVOLF", sizeof(header->magic));
+    header->version = FORMAT_VERSION;
+    header->interval = interval;
+    header->organismCapacity = organismCapacity;
+    header->foodCapacity = foodCapacity;
+    header->bufferBytes = bufferBytes;
+}
+
+LiveFeed::~LiveFeed() {
+#ifndef _WIN32
+    if (segment) {
+        ::munmap(segment, size);
+        ::shm_unlink(name.c_str());
+    }
+#endif
+}
+
+/**
+ * @brief Fill the inactive buffer under its seqlock, then flip active.
+ *
+ * Rows are written straight into the mapped columns while walking the
+ * objects, so a publication costs one pass over the population and no
+ * allocation.
+ */
+void LiveFeed::publish(const Environment& env, std::uint64_t tick) {
+    eatenSincePublished += env.getFoodEatenInTick();
+    if (tick % interval != 0) return;
+
+    auto* header = reinterpret_cast<SegmentHeader*>(segment);
+    std::atomic_ref<std::uint32_t> active(header->active);
+    const std::uint32_t target = active.load(std::memory_order_relaxed) ^ 1u;
+    char* buffer = segment + sizeof(SegmentHeader) + target * bufferBytes;
+    auto* bufferHeader = reinterpret_cast<BufferHeader*>(buffer);
+
+    std::atomic_ref<std::uint64_t> sequence(bufferHeader->sequence);
+    const std::uint64_t start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto* columns = reinterpret_cast<float*>(buffer + sizeof(BufferHeader));
+    float* xs = columns;
+    float* ys = xs + organismCapacity;
+    float* speeds = ys + organismCapacity;
+    float* sizes = speeds + organismCapacity;
+    float* awareness = sizes + organismCapacity;
+    float* lifeSpans = awareness + organismCapacity;
+    float* foodXs = lifeSpans + organismCapacity;
+    float* foodYs = foodXs + foodCapacity;
+
+    std::uint32_t organisms = 0, foods = 0, organismRows = 0, foodRows = 0;
+    env.forEachObject([&](const EnvironmentObject& object) {
+        if (object.getKind() == ObjectKind::ORGANISM) {
+            const Organism* organism = object.as<Organism>();
+            if (!organism->isAlive()) return;
+            organisms++;
+            if (organismRows == organismCapacity) return;
+            Vec2 pos = organism->getPos();
+            xs[organismRows] = pos.x;
+            ys[organismRows] = pos.y;
+            speeds[organismRows] = organism->getSpeed();
+            sizes[organismRows] = organism->getSize();
+            awareness[organismRows] = organism->getAwareness();
+            lifeSpans[organismRows] = organism->getLifeSpan();
+            organismRows++;
+        } else if (object.getKind() == ObjectKind::FOOD && object.as<Food>()->canBeEaten()) {
+            foods++;
+            if (foodRows == foodCapacity) return;
+            Vec2 pos = object.getPos();
+            foodXs[foodRows] = pos.x;
+            foodYs[foodRows] = pos.y;
+            foodRows++;
+        }
+    });
+
+    bufferHeader->tick = tick;
+    bufferHeader->version = env.getVersion();
+    bufferHeader->organisms = organisms;
+    bufferHeader->foods = foods;
+    bufferHeader->organismRows = organismRows;
+    bufferHeader->foodRows = foodRows;
+    bufferHeader->foodConsumed = static_cast<std::uint32_t>(eatenSincePublished);
+    eatenSincePublished = 0;
+    header->width = static_cast<float>(env.getWidth());
+    header->height = static_cast<float>(env.getHeight());
+
+    sequence.store(start + 2, std::memory_order_release);
+    active.store(target, std::memory_order_release);
+    std::atomic_ref<std::uint64_t>(header->published).store(++published, std::memory_order_release);
+}
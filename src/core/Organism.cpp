@@ -1,72 +1,237 @@
+#include <algorithm>
 #include <core/Food.hpp>
 #include <core/Organism.hpp>
+#include <core/SimulationProfile.hpp>
+#include <limits>
+#include <map>
+#include <mutex>
 #include <random>
+#include <tuple>
+#include <unordered_map>
 
-Organism::Organism() : EnvironmentObject(0, 0), genes("\x14\x14\x14\x14"), lifeSpan(500) {}
+namespace {
 
-Organism::Organism(const Genes& genes) : EnvironmentObject(0, 0), genes(genes), lifeSpan(500) {}
+/** @brief A plain function pointer target outlives every policy, so it is the safest identity. */
+template <typename R, typename... Args>
+const void* callableIdentity(const std::function<R(Args...)>& callable, const void* identity) {
+    if (const auto* function = callable.template target<R (*)(Args...)>()) {
+        return reinterpret_cast<const void*>(*function);
+    }
+    return identity;
+}
 
-Organism::Organism(const Genes& genes, LifeConsumptionCalculator calculator)
-    : EnvironmentObject(0, 0), genes(genes), lifeConsumptionCalculator(calculator), lifeSpan(500) {}
+/// Strategy slot a setter replaces, part of the key of derived policies
+enum class PolicySlot : std::uint8_t {
+    REACTION,
+    INTERACTION,
+    NATIVE_REACTION,
+    NATIVE_INTERACTION,
+    RULES
+};
 
-/// DNA gene ranges: each byte 0-255 is mapped to 0-64 by dividing by 4.
-float Organism::getSpeed() const {
-    return static_cast<float>(static_cast<unsigned char>(genes.getDNA(0))) / 4.0f;
+/**
+ * @brief Copy a policy with one strategy replaced, sharing the copy per callable.
+ *
+ * Organisms of one policy that are given the same callable end up on one
+ * derived policy, so they stay one species. Entries are weak and also
+ * remember their base, so a recycled address never matches a dead policy.
+ */
+std::shared_ptr<const Organism::Policy> derivePolicy(
+    const std::shared_ptr<const Organism::Policy>& base, PolicySlot slot, const void* identity,
+    const std::function<void(Organism::Policy&)>& update) {
+    auto derive = [&]() {
+        Organism::Policy updated = *base;
+        update(updated);
+        return std::make_shared<const Organism::Policy>(std::move(updated));
+    };
+    if (!identity) return derive();
+
+    struct Entry {
+        std::weak_ptr<const Organism::Policy> base;
+        std::weak_ptr<const Organism::Policy> derived;
+    };
+    static std::mutex mutex;
+    static std::map<std::tuple<const void*, PolicySlot, const void*>, Entry> interned;
+    static std::size_t pruneAt = 64;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = interned[{base.get(), slot, identity}];
+    if (entry.base.lock() == base) {
+        if (auto policy = entry.derived.lock()) return policy;
+    }
+    auto policy = derive();
+    entry = Entry{base, policy};
+    if (interned.size() >= pruneAt) {
+        std::erase_if(interned, [](const auto& item) {
+            return item.second.base.expired() || item.second.derived.expired();
+        });
+        pruneAt = std::max<std::size_t>(64, 2 * interned.size());
+    }
+    return policy;
 }
 
-float Organism::getSize() const {
-    return static_cast<float>(static_cast<unsigned char>(genes.getDNA(1))) / 4.0f;
+}  // namespace
+
+Organism::Organism() : Organism(Genes("\x14\x14\x14\x14")) {}
+
+Organism::Organism(const Genes& genes) : Organism(genes, defaultPolicy()) {}
+
+Organism::Organism(const Genes& genes, LifeConsumptionCalculator calculator)
+    : Organism(genes, lifeConsumptionPolicy(std::move(calculator))) {}
+
+Organism::Organism(const Genes& genes, std::shared_ptr<const Policy> policy)
+    : EnvironmentObject(0, 0, KIND),
+      traits(decodeTraits(genes)),
+      genes(genes),
+      policy(policy ? std::move(policy) : defaultPolicy()),
+      lifeSpan(500) {}
+
+/** @brief Process-wide policy with no custom callables. */
+const std::shared_ptr<const Organism::Policy>& Organism::defaultPolicy() {
+    static const std::shared_ptr<const Policy> instance = std::make_shared<const Policy>();
+    return instance;
 }
 
-float Organism::getAwareness() const {
-    return static_cast<float>(static_cast<unsigned char>(genes.getDNA(2))) / 4.0f;
+/**
+ * @brief Intern calculator-only policies so one calculator is one species.
+ *
+ * Entries are weak: a policy dies with its last organism, and expired
+ * entries are pruned whenever the table has doubled since the last pruning.
+ */
+std::shared_ptr<const Organism::Policy> Organism::lifeConsumptionPolicy(
+    LifeConsumptionCalculator calculator, const void* identity) {
+    if (!calculator) return defaultPolicy();
+    identity = callableIdentity(calculator, identity);
+    if (!identity) return std::make_shared<const Policy>(Policy{std::move(calculator), {}, {}, {}});
+
+    static std::mutex mutex;
+    static std::unordered_map<const void*, std::weak_ptr<const Policy>> interned;
+    static std::size_t pruneAt = 64;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = interned[identity];
+    if (auto policy = entry.lock()) return policy;
+    auto policy = std::make_shared<const Policy>(Policy{std::move(calculator), {}, {}, {}});
+    entry = policy;
+    if (interned.size() >= pruneAt) {
+        std::erase_if(interned, [](const auto& item) { return item.second.expired(); });
+        pruneAt = std::max<std::size_t>(64, 2 * interned.size());
+    }
+    return policy;
 }
 
 /**
- * @brief Calculate life consumed per iteration based on organism attributes.
- * @return Life points consumed; higher speed/size/awareness costs more.
+ * @brief Decode trait values and the default life consumption from DNA.
+ * @param genes Genes of the organism being constructed.
+ * @return Cached trait block.
  *
- * Uses a quadratic formula so larger, faster organisms burn energy disproportionately.
+ * DNA gene ranges: each byte 0-255 is mapped to 0-64 by dividing by 4.
+ * The default cost is quadratic so larger, faster organisms burn energy
+ * disproportionately: speed^2 + size^3 + awareness, scaled by 1.3.
+ */
+Organism::Traits Organism::decodeTraits(const Genes& genes) {
+    auto decode = [&genes](int index) {
+        return static_cast<float>(static_cast<unsigned char>(genes.getDNA(index))) / 4.0f;
+    };
+
+    Traits traits;
+    traits.speed = decode(0);
+    traits.size = decode(1);
+    traits.awareness = decode(2);
+    traits.reactionRadius = traits.size + traits.awareness;
+    traits.lifeConsumption =
+        (traits.speed / 10 * traits.speed / 10 +
+         traits.size / 10 * traits.size / 10 * traits.size / 15 + traits.awareness / 10) *
+        1.3;
+    return traits;
+}
+
+/**
+ * @brief Calculate life consumed per iteration based on organism attributes.
+ * @return Life points consumed; the custom calculator if one is set, otherwise
+ *         the default cost cached at construction.
  */
 float Organism::getLifeConsumption() const {
-    if (lifeConsumptionCalculator) {
-        return lifeConsumptionCalculator(*this);
+    if (policy->lifeConsumptionCalculator) {
+        return policy->lifeConsumptionCalculator(*this);
     }
-
-    // Quadratic cost: speed^2 + size^3 + awareness, scaled by 1.3
-    float consumption =
-        (getSpeed() / 10 * getSpeed() / 10 + getSize() / 10 * getSize() / 10 * getSize() / 15 +
-        getAwareness() / 10) * 1.3;
-    return consumption;
+    return traits.lifeConsumption;
 }
 
 float Organism::getLifeSpan() const { return lifeSpan; }
 
-float Organism::getReactionRadius() const { return getSize() + getAwareness(); }
-
 bool Organism::isAlive() const { return lifeSpan > 0; }
 
 bool Organism::canReproduce() const { return lifeSpan > 1000; }
 
 void Organism::addLifeSpan(float amount) { lifeSpan += amount; }
 
-void Organism::setReactionStrategy(ReactionStrategy strategy) {
-    reactionStrategy = std::move(strategy);
+void Organism::setPolicy(std::shared_ptr<const Policy> newPolicy) {
+    policy = newPolicy ? std::move(newPolicy) : defaultPolicy();
+}
+
+// Policies are immutable, so replacing one strategy copies the rest into a derived policy
+void Organism::setReactionStrategy(ReactionStrategy strategy, const void* identity) {
+    identity = strategy ? callableIdentity(strategy, identity) : nullptr;
+    setPolicy(derivePolicy(policy, PolicySlot::REACTION, identity, [&](Policy& updated) {
+        updated.reactionStrategy = std::move(strategy);
+        updated.nativeReaction = nullptr;
+    }));
+}
+
+void Organism::setInteractionStrategy(InteractionStrategy strategy, const void* identity) {
+    identity = strategy ? callableIdentity(strategy, identity) : nullptr;
+    setPolicy(derivePolicy(policy, PolicySlot::INTERACTION, identity, [&](Policy& updated) {
+        updated.interactionStrategy = std::move(strategy);
+        updated.nativeInteraction = nullptr;
+    }));
+}
+
+void Organism::setNativeReactionStrategy(NativeStrategy::ReactionFn strategy) {
+    const auto* identity = reinterpret_cast<const void*>(strategy);
+    setPolicy(derivePolicy(policy, PolicySlot::NATIVE_REACTION, identity, [&](Policy& updated) {
+        updated.reactionStrategy = nullptr;
+        updated.nativeReaction = strategy;
+    }));
+}
+
+void Organism::setNativeInteractionStrategy(NativeStrategy::InteractionFn strategy) {
+    const auto* identity = reinterpret_cast<const void*>(strategy);
+    setPolicy(derivePolicy(policy, PolicySlot::NATIVE_INTERACTION, identity, [&](Policy& updated) {
+        updated.interactionStrategy = nullptr;
+        updated.nativeInteraction = strategy;
+    }));
 }
 
-void Organism::setInteractionStrategy(InteractionStrategy strategy) {
-    interactionStrategy = std::move(strategy);
+void Organism::setRuleBasedStrategy(std::shared_ptr<const RuleBasedStrategy> strategy) {
+    // The derived policy holds the rules, so their address is a safe identity
+    const void* identity = strategy.get();
+    setPolicy(derivePolicy(policy, PolicySlot::RULES, identity, [&](Policy& updated) {
+        updated.reactionStrategy = nullptr;
+        updated.interactionStrategy = nullptr;
+        updated.batchReactionStrategy = nullptr;
+        updated.nativeReaction = nullptr;
+        updated.nativeInteraction = nullptr;
+        updated.rules = std::move(strategy);
+    }));
 }
 
 bool Organism::hasCustomStrategy() const {
-    return static_cast<bool>(reactionStrategy) || static_cast<bool>(interactionStrategy);
+    return static_cast<bool>(policy->reactionStrategy) ||
+           static_cast<bool>(policy->batchReactionStrategy) ||
+           static_cast<bool>(policy->interactionStrategy) || policy->nativeReaction != nullptr ||
+           policy->nativeInteraction != nullptr || policy->rules != nullptr;
+}
+
+bool Organism::requiresGil() const {
+    return static_cast<bool>(policy->reactionStrategy) ||
+           static_cast<bool>(policy->batchReactionStrategy) ||
+           static_cast<bool>(policy->interactionStrategy) ||
+           static_cast<bool>(policy->lifeConsumptionCalculator);
 }
 
-double Organism::calculateDistance(const std::shared_ptr<EnvironmentObject>& object) const {
-    auto pos = getPosition();
-    auto otherPos = object->getPosition();
-    auto dx = pos.first - otherPos.first;
-    auto dy = pos.second - otherPos.second;
+double Organism::calculateDistance(const EnvironmentObject& object) const {
+    auto otherPos = object.getPos();
+    auto dx = position.x - otherPos.x;
+    auto dy = position.y - otherPos.y;
     return std::sqrt(dx * dx + dy * dy);
 }
 
@@ -85,20 +250,26 @@ std::pair<float, float> Organism::defaultReaction(
     Organism& self,
     const std::vector<std::shared_ptr<EnvironmentObject>>& reactableObjects) {
 
-    std::shared_ptr<EnvironmentObject> nearestObject = nullptr;
+    // Raw pointers into the caller's list: no shared_ptr copies on the hot path
+    const EnvironmentObject* nearestObject = nullptr;
     double minDistance = std::numeric_limits<double>::max();
 
     for (const auto& obj : reactableObjects) {
-        if (auto food = std::dynamic_pointer_cast<Food>(obj)) {
-            if (!food->canBeEaten()) continue;
-        } else if (auto organism = std::dynamic_pointer_cast<Organism>(obj)) {
-            if (!organism->isAlive()) continue;
+        switch (obj->getKind()) {
+            case ObjectKind::FOOD:
+                if (!obj->as<Food>()->canBeEaten()) continue;
+                break;
+            case ObjectKind::ORGANISM:
+                if (!obj->as<Organism>()->isAlive()) continue;
+                break;
+            case ObjectKind::CUSTOM:
+                break;
         }
 
-        double distance = self.calculateDistance(obj);
+        double distance = self.calculateDistance(*obj);
         if (distance < minDistance) {
             minDistance = distance;
-            nearestObject = obj;
+            nearestObject = obj.get();
         }
     }
 
@@ -106,20 +277,19 @@ std::pair<float, float> Organism::defaultReaction(
         return {0.0f, 0.0f};
     }
 
-    auto myPos = self.getPosition();
+    Vec2 myPos = self.getPos();
+    Vec2 otherPos = nearestObject->getPos();
 
-    if (auto otherOrganism = std::dynamic_pointer_cast<Organism>(nearestObject)) {
-        auto otherPos = otherOrganism->getPosition();
+    if (nearestObject->getKind() == ObjectKind::ORGANISM) {
+        const Organism* otherOrganism = nearestObject->as<Organism>();
         if (self.getSize() * 1.5 < otherOrganism->getSize()) {
-            return {myPos.first - otherPos.first, myPos.second - otherPos.second};
+            return myPos - otherPos;
         } else if (self.getSize() > 1.5 * otherOrganism->getSize()) {
-            return {otherPos.first - myPos.first, otherPos.second - myPos.second};
-        }
-    } else if (auto food = std::dynamic_pointer_cast<Food>(nearestObject)) {
-        if (food->canBeEaten()) {
-            auto foodPos = food->getPosition();
-            return {foodPos.first - myPos.first, foodPos.second - myPos.second};
+            return otherPos - myPos;
         }
+    } else if (nearestObject->getKind() == ObjectKind::FOOD) {
+        // Nearest food was filtered for edibility above
+        return otherPos - myPos;
     }
 
     return {0.0f, 0.0f};
@@ -138,13 +308,13 @@ void Organism::defaultInteraction(
     const std::vector<std::shared_ptr<EnvironmentObject>>& interactableObjects) {
 
     for (const auto& object : interactableObjects) {
-        if (auto food = std::dynamic_pointer_cast<Food>(object)) {
+        if (object->getKind() == ObjectKind::FOOD) {
+            Food* food = object->as<Food>();
             if (!food->canBeEaten()) continue;
             self.addLifeSpan(food->getEnergy());
             food->eaten();
-        }
-
-        if (auto organism = std::dynamic_pointer_cast<Organism>(object)) {
+        } else if (object->getKind() == ObjectKind::ORGANISM) {
+            Organism* organism = object->as<Organism>();
             if (self.getSize() > 1.5 * organism->getSize() && organism->isAlive()) {
                 self.addLifeSpan(organism->getLifeSpan());
                 organism->killed();
@@ -153,6 +323,86 @@ void Organism::defaultInteraction(
     }
 }
 
+// --- Native strategy adapters ---
+
+/**
+ * @brief Fill the flat self/neighbour arrays described in NativeStrategy.hpp.
+ *
+ * The buffers are thread_local in the callers, so packing allocates only
+ * when a neighbourhood is larger than any seen before on that thread.
+ */
+void Organism::packNativeViews(const Organism& self,
+                               const std::vector<std::shared_ptr<EnvironmentObject>>& objects,
+                               std::vector<float>& selfView, std::vector<float>& neighbourView) {
+    Vec2 pos = self.getPos();
+    selfView.assign({pos.x, pos.y, self.getSpeed(), self.getSize(), self.getAwareness(),
+                     self.getLifeSpan()});
+
+    neighbourView.clear();
+    for (const auto& object : objects) {
+        Vec2 objectPos = object->getPos();
+        float size = 0.0f, active = 1.0f, value = 0.0f;
+        if (object->getKind() == ObjectKind::ORGANISM) {
+            const Organism* organism = object->as<Organism>();
+            size = organism->getSize();
+            active = organism->isAlive() ? 1.0f : 0.0f;
+            value = organism->getLifeSpan();
+        } else if (object->getKind() == ObjectKind::FOOD) {
+            const Food* food = object->as<Food>();
+            active = food->canBeEaten() ? 1.0f : 0.0f;
+            value = static_cast<float>(food->getEnergy());
+        }
+        neighbourView.insert(neighbourView.end(),
+                             {objectPos.x, objectPos.y, static_cast<float>(object->getKind()),
+                              size, active, value});
+    }
+}
+
+std::pair<float, float> Organism::nativeReaction(
+    Organism& self, const std::vector<std::shared_ptr<EnvironmentObject>>& reactableObjects) {
+    static thread_local std::vector<float> selfView, neighbourView;
+    packNativeViews(self, reactableObjects, selfView, neighbourView);
+
+    float direction[2] = {0.0f, 0.0f};
+    self.policy->nativeReaction(selfView.data(), neighbourView.data(),
+                                static_cast<std::int32_t>(reactableObjects.size()), direction);
+    return {direction[0], direction[1]};
+}
+
+/**
+ * @brief Run a native interaction and apply the consume flags it returns.
+ *
+ * Consuming mirrors defaultInteraction(): edible food grants its energy,
+ * living organisms are killed and their life-span absorbed.
+ */
+void Organism::nativeInteraction(
+    Organism& self, const std::vector<std::shared_ptr<EnvironmentObject>>& interactableObjects) {
+    static thread_local std::vector<float> selfView, neighbourView;
+    static thread_local std::vector<std::uint8_t> consume;
+    packNativeViews(self, interactableObjects, selfView, neighbourView);
+    consume.assign(interactableObjects.size(), 0);
+
+    self.policy->nativeInteraction(selfView.data(), neighbourView.data(),
+                                   static_cast<std::int32_t>(interactableObjects.size()),
+                                   consume.data());
+
+    for (std::size_t i = 0; i < interactableObjects.size(); i++) {
+        if (!consume[i]) continue;
+        const auto& object = interactableObjects[i];
+        if (object->getKind() == ObjectKind::FOOD) {
+            Food* food = object->as<Food>();
+            if (!food->canBeEaten()) continue;
+            self.addLifeSpan(food->getEnergy());
+            food->eaten();
+        } else if (object->getKind() == ObjectKind::ORGANISM) {
+            Organism* organism = object->as<Organism>();
+            if (!organism->isAlive()) continue;
+            self.addLifeSpan(organism->getLifeSpan());
+            organism->killed();
+        }
+    }
+}
+
 // --- Public action methods ---
 
 void Organism::react(const std::vector<std::shared_ptr<EnvironmentObject>>& reactableObjects) {
@@ -160,21 +410,36 @@ void Organism::react(const std::vector<std::shared_ptr<EnvironmentObject>>& reac
     if (reactionCounter != 0) return;
 
     std::pair<float, float> result;
-    if (reactionStrategy) {
-        result = reactionStrategy(*this, reactableObjects);
-    } else {
-        result = defaultReaction(*this, reactableObjects);
+    {
+        StrategyScope attributed(speciesId, StrategyCall::REACTION, reactableObjects.size());
+        if (policy->reactionStrategy) {
+            result = policy->reactionStrategy(*this, reactableObjects);
+        } else if (policy->nativeReaction) {
+            result = nativeReaction(*this, reactableObjects);
+        } else if (policy->rules) {
+            result = policy->rules->react(*this, reactableObjects);
+        } else {
+            result = defaultReaction(*this, reactableObjects);
+        }
     }
 
-    if (result.first != 0.0f || result.second != 0.0f) {
-        movement = Vec2(result.first, result.second);
-        reactionCounter++;
-    }
+    applyReaction(result);
+}
+
+void Organism::applyReaction(Vec2 direction) {
+    if (reactionCounter != 0 || direction.isZero()) return;
+    movement = direction;
+    reactionCounter++;
 }
 
 void Organism::interact(const std::vector<std::shared_ptr<EnvironmentObject>>& interactableObjects) {
-    if (interactionStrategy) {
-        interactionStrategy(*this, interactableObjects);
+    StrategyScope attributed(speciesId, StrategyCall::INTERACTION, interactableObjects.size());
+    if (policy->interactionStrategy) {
+        policy->interactionStrategy(*this, interactableObjects);
+    } else if (policy->nativeInteraction) {
+        nativeInteraction(*this, interactableObjects);
+    } else if (policy->rules) {
+        policy->rules->interact(*this, interactableObjects);
     } else {
         defaultInteraction(*this, interactableObjects);
     }
@@ -183,15 +448,14 @@ void Organism::interact(const std::vector<std::shared_ptr<EnvironmentObject>>& i
 /**
  * @brief Create a mutated offspring and halve this organism's life-span.
  *
- * The child inherits the parent's genes (with mutation), life-consumption
- * calculator, and any custom reaction/interaction strategies.
+ * The child inherits the parent's genes (with mutation) and shares the
+ * parent's policy, so only a pointer and the species id are copied.
  */
 std::shared_ptr<Organism> Organism::reproduce() {
     Genes newGenes = genes;
     newGenes.mutate();
-    auto newOrganism = std::make_shared<Organism>(newGenes, lifeConsumptionCalculator);
-    if (reactionStrategy) newOrganism->setReactionStrategy(reactionStrategy);
-    if (interactionStrategy) newOrganism->setInteractionStrategy(interactionStrategy);
+    auto newOrganism = std::make_shared<Organism>(newGenes, policy);
+    newOrganism->speciesId = speciesId;
     newOrganism->setPosition(getPosition().first + 2, getPosition().second + 2);
     lifeSpan /= 2;
     return newOrganism;
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <core/Organism.hpp>
+#include <core/PopulationStats.hpp>
+#include <stdexcept>
+
+PopulationStats::PopulationStats(std::size_t historyCapacity) {
+    setHistoryCapacity(historyCapacity);
+}
+
+static std::array<float, PopulationStats::TRAIT_COUNT> traitsOf(const Organism &organism) {
+    return {organism.getSpeed(), organism.getSize(), organism.getAwareness()};
+}
+
+int PopulationStats::binOf(float value) {
+    int bin = static_cast<int>(value / TRAIT_MAX * HISTOGRAM_BINS);
+    return std::clamp(bin, 0, HISTOGRAM_BINS - 1);
+}
+
+/**
+ * @brief Welford update for a new organism.
+ *
+ * Food only changes the food counter; custom objects are not tracked.
+ */
+void PopulationStats::onAdded(const EnvironmentObject &object) {
+    if (object.getKind() == ObjectKind::FOOD) {
+        foods++;
+        return;
+    }
+    if (object.getKind() != ObjectKind::ORGANISM) return;
+
+    organisms++;
+    auto traits = traitsOf(*object.as<Organism>());
+    for (int t = 0; t < TRAIT_COUNT; t++) {
+        double delta = traits[t] - means[t];
+        means[t] += delta / organisms;
+        m2[t] += delta * (traits[t] - means[t]);
+        histograms[t][binOf(traits[t])]++;
+    }
+}
+
+/**
+ * @brief Inverse Welford update for a departing organism.
+ *
+ * Removing the last organism resets the accumulators exactly, which also
+ * discards any rounding drift collected along the way.
+ */
+void PopulationStats::onRemoved(const EnvironmentObject &object) {
+    if (object.getKind() == ObjectKind::FOOD) {
+        if (foods > 0) foods--;
+        return;
+    }
+    if (object.getKind() != ObjectKind::ORGANISM || organisms == 0) return;
+
+    auto traits = traitsOf(*object.as<Organism>());
+    organisms--;
+    for (int t = 0; t < TRAIT_COUNT; t++) {
+        auto &bin = histograms[t][binOf(traits[t])];
+        if (bin > 0) bin--;
+        if (organisms == 0) {
+            means[t] = 0.0;
+            m2[t] = 0.0;
+            continue;
+        }
+        double oldMean = means[t];
+        means[t] = (oldMean * (organisms + 1) - traits[t]) / organisms;
+        m2[t] = std::max(0.0, m2[t] - (traits[t] - oldMean) * (traits[t] - means[t]));
+    }
+}
+
+void PopulationStats::clear() {
+    organisms = 0;
+    foods = 0;
+    means.fill(0.0);
+    m2.fill(0.0);
+    for (auto &histogram : histograms) histogram.fill(0);
+}
+
+double PopulationStats::getVariance(Trait trait) const {
+    return organisms > 1 ? m2[trait] / organisms : 0.0;
+}
+
+void PopulationStats::record(const TickSample &sample) {
+    history[historyNext] = sample;
+    historyNext = (historyNext + 1) % history.size();
+    historySize = std::min(historySize + 1, history.size());
+}
+
+std::vector<PopulationStats::TickSample> PopulationStats::getHistory() const {
+    std::vector<TickSample> ordered;
+    ordered.reserve(historySize);
+    std::size_t start = (historyNext + history.size() - historySize) % history.size();
+    for (std::size_t i = 0; i < historySize; i++) {
+        ordered.push_back(history[(start + i) % history.size()]);
+    }
+    return ordered;
+}
+
+void PopulationStats::setHistoryCapacity(std::size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("History capacity must be positive.");
+    }
+    history.assign(capacity, TickSample{});
+    historyNext = 0;
+    historySize = 0;
+}
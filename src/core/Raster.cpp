@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <core/Environment.hpp>
+#include <core/Raster.hpp>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/** @brief What render() needs of one object, gathered before drawing. */
+struct Mark {
+    float x, y;
+    float size;       ///< Body radius; 0 for food
+    float awareness;  ///< Reaction radius; 0 for food
+    bool food;
+};
+
+/**
+ * @brief Add 1 to every pixel of rows [rowBegin, rowEnd) inside an ellipse.
+ *
+ * Discs smaller than a pixel still mark the pixel holding their centre, so
+ * small organisms do not vanish at low resolutions.
+ */
+void fillDisc(float* plane, int width, int rowBegin, int rowEnd, float cx, float cy, float rx,
+              float ry) {
+    int top = std::max(rowBegin, static_cast<int>(std::floor(cy - ry)));
+    int bottom = std::min(rowEnd - 1, static_cast<int>(std::floor(cy + ry)));
+    // Zero radii (size or awareness genes of 0) would divide 0 by 0 below
+    if (!(rx > 0.0f && ry > 0.0f)) bottom = top - 1;
+    bool marked = false;
+    for (int row = top; row <= bottom; row++) {
+        float dy = (row + 0.5f - cy) / ry;
+        if (dy * dy > 1.0f) continue;
+        float dx = rx * std::sqrt(1.0f - dy * dy);
+        int left = std::max(0, static_cast<int>(std::ceil(cx - dx - 0.5f)));
+        int right = std::min(width - 1, static_cast<int>(std::floor(cx + dx - 0.5f)));
+        float* pixels = plane + static_cast<std::size_t>(row) * width;
+        for (int col = left; col <= right; col++) pixels[col] += 1.0f;
+        marked = marked || left <= right;
+    }
+    int row = static_cast<int>(cy), col = static_cast<int>(cx);
+    if (!marked && row >= rowBegin && row < rowEnd && col >= 0 && col < width) {
+        plane[static_cast<std::size_t>(row) * width + col] += 1.0f;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Gather positions and radii once, then draw row bands in parallel.
+ */
+Raster Environment::render(int widthPx, int heightPx, const std::vector<RenderLayer>& layers,
+                           int numThreads) const {
+    if (widthPx <= 0 || heightPx <= 0) {
+        throw std::invalid_argument("render: image dimensions must be positive.");
+    }
+    if (layers.empty()) {
+        throw std::invalid_argument("render: at least one layer is required.");
+    }
+
+    std::vector<Mark> marks;
+    marks.reserve(objectsMapper.size());
+    forEachObject([&](const EnvironmentObject& object) {
+        Vec2 pos = object.getPos();
+        if (object.getKind() == ObjectKind::ORGANISM) {
+            const Organism* organism = object.as<Organism>();
+            if (organism->isAlive()) {
+                marks.push_back({pos.x, pos.y, organism->getSize(),
+                                 organism->getReactionRadius(), false});
+            }
+        } else if (object.getKind() == ObjectKind::FOOD && object.as<Food>()->canBeEaten()) {
+            marks.push_back({pos.x, pos.y, 0.0f, 0.0f, true});
+        }
+    });
+
+    Raster raster;
+    raster.width = widthPx;
+    raster.height = heightPx;
+    raster.layers = layers;
+    raster.data.assign(layers.size() * widthPx * heightPx, 0.0f);
+    const float scaleX = static_cast<float>(widthPx) / width;
+    const float scaleY = static_cast<float>(heightPx) / height;
+
+    auto drawBand = [&](int rowBegin, int rowEnd) {
+        for (std::size_t l = 0; l < layers.size(); l++) {
+            float* plane = raster.plane(l);
+            for (const Mark& mark : marks) {
+                float cx = mark.x * scaleX, cy = mark.y * scaleY;
+                switch (layers[l]) {
+                    case RenderLayer::ORGANISMS:
+                    case RenderLayer::FOOD: {
+                        if (mark.food != (layers[l] == RenderLayer::FOOD)) break;
+                        int row = std::min(heightPx - 1, static_cast<int>(cy));
+                        int col = std::min(widthPx - 1, static_cast<int>(cx));
+                        if (row >= rowBegin && row < rowEnd && col >= 0) {
+                            plane[static_cast<std::size_t>(row) * widthPx + col] += 1.0f;
+                        }
+                        break;
+                    }
+                    case RenderLayer::SIZE:
+                    case RenderLayer::AWARENESS: {
+                        if (mark.food) break;
+                        float radius =
+                            layers[l] == RenderLayer::SIZE ? mark.size : mark.awareness;
+                        fillDisc(plane, widthPx, rowBegin, rowEnd, cx, cy, radius * scaleX,
+                                 radius * scaleY);
+                        break;
+                    }
+                }
+            }
+        }
+    };
+
+    int threads = numThreads > 0 ? numThreads
+                                 : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads = std::min(threads, heightPx);
+    const int rowsPerBand = (heightPx + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (int band = 1; band < threads; band++) {
+        int begin = band * rowsPerBand;
+        if (begin >= heightPx) break;
+        workers.emplace_back(drawBand, begin, std::min(heightPx, begin + rowsPerBand));
+    }
+    drawBand(0, std::min(heightPx, rowsPerBand));
+    for (auto& worker : workers) worker.join();
+    return raster;
+}
+
+std::vector<std::uint8_t> Raster::toRGBA() const {
+    const std::size_t pixels = static_cast<std::size_t>(width) * height;
+    std::vector<float> rgb(pixels * 3, 0.0f), alpha(pixels, 0.0f);
+    for (std::size_t l = 0; l < layers.size(); l++) {
+        const float* values = plane(l);
+        float maximum = *std::max_element(values, values + pixels);
+        if (maximum <= 0.0f) continue;
+        int channel = layers[l] == RenderLayer::FOOD ? 1 : layers[l] == RenderLayer::AWARENESS ? 0 : 2;
+        for (std::size_t p = 0; p < pixels; p++) {
+            float intensity = values[p] / maximum;
+            rgb[p * 3 + channel] += intensity;
+            alpha[p] = std::max(alpha[p], intensity);
+        }
+    }
+
+    std::vector<std::uint8_t> rgba(pixels * 4);
+    auto toByte = [](float value) {
+        return static_cast<std::uint8_t>(std::lround(std::min(value, 1.0f) * 255.0f));
+    };
+    for (std::size_t p = 0; p < pixels; p++) {
+        for (int c = 0; c < 3; c++) rgba[p * 4 + c] = toByte(rgb[p * 3 + c]);
+        rgba[p * 4 + 3] = toByte(alpha[p]);
+    }
+    return rgba;
+}
@@ -0,0 +1,92 @@
+#include <cmath>
+#include <core/Food.hpp>
+#include <core/Organism.hpp>
+#include <core/RuleBasedStrategy.hpp>
+#include <stdexcept>
+
+RuleBasedStrategy::RuleBasedStrategy(std::vector<Rule> rules) : rules(std::move(rules)) {
+    for (const auto &rule : this->rules) {
+        if (!(rule.minSizeRatio < rule.maxSizeRatio)) {
+            throw std::invalid_argument("Rule size-ratio interval is empty.");
+        }
+        if (!(rule.range > 0.0f)) {
+            throw std::invalid_argument("Rule range must be positive.");
+        }
+        if (!std::isfinite(rule.weight)) {
+            throw std::invalid_argument("Rule weight must be finite.");
+        }
+    }
+}
+
+/**
+ * @brief Check whether a neighbour falls under a rule.
+ *
+ * Eaten food and dead organisms never match. The size ratio only applies to
+ * organisms, since food and custom objects have no size.
+ */
+bool RuleBasedStrategy::matches(const Rule &rule, const Organism &self,
+                                const EnvironmentObject &object) {
+    if (object.getKind() != rule.target) return false;
+
+    switch (object.getKind()) {
+        case ObjectKind::FOOD:
+            return object.as<Food>()->canBeEaten();
+        case ObjectKind::ORGANISM: {
+            const Organism *other = object.as<Organism>();
+            if (!other->isAlive() || other == &self) return false;
+            float ratio = other->getSize() / self.getSize();
+            return ratio >= rule.minSizeRatio && ratio < rule.maxSizeRatio;
+        }
+        case ObjectKind::CUSTOM:
+            return true;
+    }
+    return false;
+}
+
+std::pair<float, float> RuleBasedStrategy::react(
+    const Organism &self, const std::vector<std::shared_ptr<EnvironmentObject>> &objects) const {
+    Vec2 myPos = self.getPos();
+    Vec2 direction;
+
+    for (const auto &rule : rules) {
+        const EnvironmentObject *nearest = nullptr;
+        float minDistance = rule.range;
+        for (const auto &object : objects) {
+            if (!matches(rule, self, *object)) continue;
+            float distance = (object->getPos() - myPos).length();
+            if (distance < minDistance) {
+                minDistance = distance;
+                nearest = object.get();
+            }
+        }
+
+        // Objects exactly on top of us give no direction
+        if (nearest && minDistance > 0.0f) {
+            Vec2 towards = nearest->getPos() - myPos;
+            direction = direction + towards * (rule.weight / minDistance);
+        }
+    }
+
+    return {direction.x, direction.y};
+}
+
+void RuleBasedStrategy::interact(
+    Organism &self, const std::vector<std::shared_ptr<EnvironmentObject>> &objects) const {
+    for (const auto &object : objects) {
+        for (const auto &rule : rules) {
+            if (!matches(rule, self, *object)) continue;
+            if (rule.consume) {
+                if (object->getKind() == ObjectKind::FOOD) {
+                    Food *food = object->as<Food>();
+                    self.addLifeSpan(food->getEnergy());
+                    food->eaten();
+                } else if (object->getKind() == ObjectKind::ORGANISM) {
+                    Organism *organism = object->as<Organism>();
+                    self.addLifeSpan(organism->getLifeSpan());
+                    organism->killed();
+                }
+            }
+            break;
+        }
+    }
+}
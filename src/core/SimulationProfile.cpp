@@ -0,0 +1,111 @@
+#include <core/SimulationProfile.hpp>
+
+void ProfileCounters::merge(const QueryTally& tally) {
+    if (tally.queries == 0) return;
+    queries.fetch_add(tally.queries, std::memory_order_relaxed);
+    neighbours.fetch_add(tally.neighbours, std::memory_order_relaxed);
+    for (std::size_t b = 0; b < QueryTally::BUCKETS; b++) {
+        if (tally.perQuery[b] > 0) perQuery[b].fetch_add(tally.perQuery[b], std::memory_order_relaxed);
+    }
+}
+
+void ProfileCounters::merge(const StrategyTally& tally,
+                            const std::function<StrategyOwner(std::uint16_t)>& owner) {
+    const auto& costs = tally.getCosts();
+    if (costs.empty()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t species = 0; species * STRATEGY_CALL_COUNT < costs.size(); species++) {
+        const std::size_t first = species * STRATEGY_CALL_COUNT;
+        const std::size_t last = std::min(costs.size(), first + STRATEGY_CALL_COUNT);
+        bool ran = false;
+        for (std::size_t i = first; i < last; i++) ran = ran || costs[i].calls > 0;
+        if (!ran) continue;
+
+        StrategyOwner resolved = owner(static_cast<std::uint16_t>(species));
+        std::weak_ptr<const void> key = resolved.policy;
+        auto [it, inserted] =
+            policySerials.try_emplace(key, static_cast<std::uint32_t>(strategies.size()));
+        if (inserted) strategies.push_back({key, resolved.implementations, {}});
+        PolicyCosts& entry = strategies[it->second];
+        for (std::size_t i = first; i < last; i++) entry.costs[i - first] += costs[i];
+    }
+}
+
+void ProfileCounters::addCounters(ProfileZone zone, const PerfReading& delta) {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters[static_cast<std::size_t>(zone)] += delta;
+}
+
+SimulationProfile ProfileCounters::snapshot() const {
+    SimulationProfile profile;
+    profile.ticks = ticks.load(std::memory_order_relaxed);
+    // One ratio for every conversion, so quantiles never overtake the maximum
+    const double msPerTick = Profiler::nanosecondsPerTick() / 1e6;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t z = 0; z < PROFILE_ZONE_COUNT; z++) {
+        const auto zone = static_cast<ProfileZone>(z);
+        const LatencyHistogram& histogram = zones.histogram(zone);
+        // Counters are kept even when the zones are compiled out
+        if (histogram.getCount() == 0 && counters[z].empty()) continue;
+        ZoneProfile entry;
+        entry.name = profileZoneName(zone);
+        entry.count = histogram.getCount();
+        entry.totalMs = static_cast<double>(zones.ticks(zone)) * msPerTick;
+        entry.meanMs = entry.count ? entry.totalMs / static_cast<double>(entry.count) : 0.0;
+        entry.p50Ms = static_cast<double>(histogram.quantileTicks(0.50)) * msPerTick;
+        entry.p95Ms = static_cast<double>(histogram.quantileTicks(0.95)) * msPerTick;
+        entry.p99Ms = static_cast<double>(histogram.quantileTicks(0.99)) * msPerTick;
+        entry.maxMs = static_cast<double>(histogram.maxTicks()) * msPerTick;
+        entry.counters = counters[z];
+        profile.zones.push_back(std::move(entry));
+    }
+
+    profile.queries = queries.load(std::memory_order_relaxed);
+    profile.neighbours = neighbours.load(std::memory_order_relaxed);
+    for (std::size_t b = 0; b < QueryTally::BUCKETS; b++) {
+        profile.neighboursPerQuery[b] = perQuery[b].load(std::memory_order_relaxed);
+    }
+    profile.organismsInteracted = interacted.load(std::memory_order_relaxed);
+    profile.organismsReacted = reacted.load(std::memory_order_relaxed);
+    profile.indexUpdates = indexUpdates.load(std::memory_order_relaxed);
+    profile.objectsRemoved = removed.load(std::memory_order_relaxed);
+
+    for (std::size_t serial = 0; serial < strategies.size(); serial++) {
+        for (std::size_t call = 0; call < STRATEGY_CALL_COUNT; call++) {
+            const StrategyCost& cost = strategies[serial].costs[call];
+            if (cost.calls == 0) continue;
+            StrategyProfile entry;
+            entry.policy = static_cast<std::uint32_t>(serial);
+            entry.call = static_cast<StrategyCall>(call);
+            entry.implementation = strategies[serial].implementations[call];
+            entry.calls = cost.calls;
+            entry.neighbours = cost.neighbours;
+            entry.totalMs = static_cast<double>(cost.ticks) * msPerTick;
+            entry.meanUs = entry.totalMs * 1e3 / static_cast<double>(cost.calls);
+            entry.gilWaitMs = static_cast<double>(cost.gilTicks) * msPerTick;
+            profile.strategies.push_back(entry);
+        }
+    }
+    return profile;
+}
+
+std::vector<std::weak_ptr<const void>> ProfileCounters::strategyPolicies() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<std::weak_ptr<const void>> policies;
+    policies.reserve(strategies.size());
+    for (const auto& entry : strategies) policies.push_back(entry.policy);
+    return policies;
+}
+
+void ProfileCounters::clear() {
+    zones.clear();
+    for (auto* counter : {&ticks, &queries, &neighbours, &interacted, &reacted, &indexUpdates,
+                          &removed}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    for (auto& bucket : perQuery) bucket.store(0, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex);
+    strategies.clear();
+    policySerials.clear();
+    counters.fill(PerfReading{});
+}
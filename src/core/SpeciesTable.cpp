@@ -0,0 +1,34 @@
+#include <core/SpeciesTable.hpp>
+#include <limits>
+#include <stdexcept>
+
+SpeciesTable::SpeciesTable() { clear(); }
+
+/**
+ * @brief Look up a policy by identity, registering it on first sight.
+ * @param policy Shared policy pointer.
+ * @return The id assigned to the policy.
+ * @throws std::length_error If the table is full.
+ */
+SpeciesTable::SpeciesId SpeciesTable::intern(
+    const std::shared_ptr<const Organism::Policy> &policy) {
+    auto it = ids.find(policy.get());
+    if (it != ids.end()) {
+        return it->second;
+    }
+    if (policies.size() > std::numeric_limits<SpeciesId>::max()) {
+        throw std::length_error("Too many distinct organism policies in one Environment.");
+    }
+    auto id = static_cast<SpeciesId>(policies.size());
+    policies.push_back(policy);
+    ids.emplace(policy.get(), id);
+    return id;
+}
+
+/** @brief Reset the table to contain only the default policy. */
+void SpeciesTable::clear() {
+    policies.clear();
+    ids.clear();
+    policies.push_back(Organism::defaultPolicy());
+    ids.emplace(Organism::defaultPolicy().get(), DEFAULT_SPECIES);
+}
@@ -0,0 +1,257 @@
+#include <core/Environment.hpp>
+#include <core/TrajectoryRecorder.hpp>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::uint64_t NEVER = std::numeric_limits<std::uint64_t>::max();
+
+template <typename T>
+void writeColumn(std::ofstream& out, const std::vector<T>& column) {
+    out.write(reinterpret_cast<const char*>(column.data()),
+              static_cast<std::streamsize>(column.size() * sizeof(T)));
+}
+
+}  // namespace
+
+TrajectoryRecorder::TrajectoryRecorder(const std::string& path, float width, float height,
+                                       std::uint32_t interval, std::uint32_t chunkFrames,
+                                       std::size_t maxPendingFrames)
+    : interval(interval), chunkFrames(chunkFrames), maxPendingFrames(maxPendingFrames) {
+    if (interval == 0 || chunkFrames == 0 || maxPendingFrames == 0) {
+        throw std::invalid_argument(
+            "TrajectoryRecorder: interval, chunk_frames and max_pending_frames must be positive.");
+    }
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot create trajectory file: " + path);
+
+    FileHeader header{};
+    std::memcpy(header.magic, "SIMEVOTJ", sizeof(header.magic));
+    header.version = FORMAT_VERSION;
+    header.interval = interval;
+    header.width = width;
+    header.height = height;
+    header.chunkFrames = chunkFrames;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    writer = std::thread(&TrajectoryRecorder::writerLoop, this);
+}
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; close() reports errors to callers that ask
+    }
+}
+
+/**
+ * @brief Copy one frame and hand it to the writer.
+ *
+ * Diffing against the previous frame happens here, on the simulation
+ * thread, because it needs the live objects: new organisms and every
+ * organism in a keyframe are "introduced" with their traits, food is only
+ * listed when it appears or disappears. The copy is plain column pushes,
+ * so the cost stays proportional to the population.
+ */
+void TrajectoryRecorder::capture(const Environment& env, std::uint64_t tick) {
+    if (tick % interval != 0) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closing) throw std::runtime_error("TrajectoryRecorder is closed.");
+    }
+    rethrowWriteError();
+
+    const std::uint64_t frameIndex = framesCaptured;
+    const std::uint64_t chunkIndex = frameIndex / chunkFrames;
+    const bool keyframe = frameIndex % chunkFrames == 0;
+
+    Frame frame;
+    frame.tick = tick;
+    frame.ids.reserve(previousOrganisms);
+    frame.xs.reserve(previousOrganisms);
+    frame.ys.reserve(previousOrganisms);
+    frame.lifeSpans.reserve(previousOrganisms);
+
+    env.forEachObject([&](const EnvironmentObject& object) {
+        if (object.getKind() == ObjectKind::ORGANISM) {
+            const Organism* organism = object.as<Organism>();
+            if (!organism->isAlive()) return;
+            auto [it, inserted] =
+                organisms.try_emplace(organism->getId(), Tracked{nextId, frameIndex, NEVER});
+            if (inserted) {
+                nextId++;
+                if (frameIndex > 0) frame.births++;
+            }
+            Tracked& tracked = it->second;
+            tracked.lastSeen = frameIndex;
+            Vec2 pos = organism->getPos();
+            frame.ids.push_back(tracked.id);
+            frame.xs.push_back(pos.x);
+            frame.ys.push_back(pos.y);
+            frame.lifeSpans.push_back(organism->getLifeSpan());
+            if (tracked.lastChunk != chunkIndex) {
+                tracked.lastChunk = chunkIndex;
+                frame.introducedIds.push_back(tracked.id);
+                frame.speeds.push_back(organism->getSpeed());
+                frame.sizes.push_back(organism->getSize());
+                frame.awareness.push_back(organism->getAwareness());
+            }
+        } else if (object.getKind() == ObjectKind::FOOD) {
+            auto it = foods.find(object.getId());
+            if (!object.as<Food>()->canBeEaten()) {
+                // Left untouched, so the sweep below reports it as removed
+                if (it != foods.end()) frame.eaten++;
+                return;
+            }
+            if (it == foods.end()) {
+                it = foods.emplace(object.getId(), Tracked{nextId++, frameIndex, NEVER}).first;
+            }
+            Tracked& tracked = it->second;
+            tracked.lastSeen = frameIndex;
+            if (tracked.lastChunk != chunkIndex) {
+                tracked.lastChunk = chunkIndex;
+                Vec2 pos = object.getPos();
+                frame.foodAddedIds.push_back(tracked.id);
+                frame.foodXs.push_back(pos.x);
+                frame.foodYs.push_back(pos.y);
+            }
+        }
+    });
+
+    // Forget objects that disappeared; the reader resets its food set on keyframes
+    for (auto it = organisms.begin(); it != organisms.end();) {
+        it = it->second.lastSeen == frameIndex ? std::next(it) : organisms.erase(it);
+    }
+    for (auto it = foods.begin(); it != foods.end();) {
+        if (it->second.lastSeen == frameIndex) {
+            ++it;
+            continue;
+        }
+        if (!keyframe) frame.foodRemovedIds.push_back(it->second.id);
+        it = foods.erase(it);
+    }
+
+    const auto count = static_cast<std::uint32_t>(frame.ids.size());
+    frame.deaths = frameIndex > 0 ? previousOrganisms + frame.births - count : 0;
+    previousOrganisms = count;
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        spaceAvailable.wait(lock,
+                            [&] { return pending.size() < maxPendingFrames || writeError; });
+        if (writeError) std::rethrow_exception(writeError);
+        pending.push_back(std::move(frame));
+    }
+    framesAvailable.notify_one();
+    framesCaptured++;
+}
+
+void TrajectoryRecorder::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closing) return;
+        closing = true;
+    }
+    framesAvailable.notify_all();
+    if (writer.joinable()) writer.join();
+    out.close();
+    rethrowWriteError();
+}
+
+void TrajectoryRecorder::rethrowWriteError() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (writeError) std::rethrow_exception(writeError);
+}
+
+/**
+ * @brief Drain the queue into chunks until close() is called.
+ *
+ * On a write error the loop stops and stores the exception; capture() and
+ * close() rethrow it, and pending frames are dropped so capture never
+ * blocks on a dead writer.
+ */
+void TrajectoryRecorder::writerLoop() {
+    try {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex);
+            framesAvailable.wait(lock, [&] { return !pending.empty() || closing; });
+            if (pending.empty()) break;
+            chunk.push_back(std::move(pending.front()));
+            pending.pop_front();
+            lock.unlock();
+            spaceAvailable.notify_one();
+
+            if (chunk.size() == chunkFrames) writeChunk();
+        }
+        if (!chunk.empty()) writeChunk();
+        out.flush();
+        if (!out) throw std::runtime_error("Failed to write trajectory file.");
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        writeError = std::current_exception();
+        pending.clear();
+        spaceAvailable.notify_all();
+    }
+}
+
+/** @brief Concatenate the buffered frames column by column and write them out. */
+void TrajectoryRecorder::writeChunk() {
+    ChunkHeader header{};
+    std::memcpy(header.magic, "CHNK", sizeof(header.magic));
+    header.frames = static_cast<std::uint32_t>(chunk.size());
+
+    std::vector<std::uint64_t> ticks;
+    std::vector<std::uint32_t> organismCounts, introducedCounts, addedCounts, removedCounts,
+        births, deaths, eaten;
+    for (const Frame& frame : chunk) {
+        ticks.push_back(frame.tick);
+        organismCounts.push_back(static_cast<std::uint32_t>(frame.ids.size()));
+        introducedCounts.push_back(static_cast<std::uint32_t>(frame.introducedIds.size()));
+        addedCounts.push_back(static_cast<std::uint32_t>(frame.foodAddedIds.size()));
+        removedCounts.push_back(static_cast<std::uint32_t>(frame.foodRemovedIds.size()));
+        births.push_back(frame.births);
+        deaths.push_back(frame.deaths);
+        eaten.push_back(frame.eaten);
+        header.organismRows += organismCounts.back();
+        header.introducedRows += introducedCounts.back();
+        header.foodAddedRows += addedCounts.back();
+        header.foodRemovedRows += removedCounts.back();
+    }
+
+    const std::uint64_t columnBytes =
+        std::uint64_t{header.frames} * (sizeof(std::uint64_t) + 7 * sizeof(std::uint32_t)) +
+        std::uint64_t{header.organismRows} * 16 + std::uint64_t{header.introducedRows} * 16 +
+        std::uint64_t{header.foodAddedRows} * 12 + std::uint64_t{header.foodRemovedRows} * 4;
+    header.payloadBytes = (columnBytes + 7) / 8 * 8;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    writeColumn(out, ticks);
+    for (const auto* column : {&organismCounts, &introducedCounts, &addedCounts, &removedCounts,
+                               &births, &deaths, &eaten}) {
+        writeColumn(out, *column);
+    }
+    // Row columns: one field across all frames of the chunk at a time
+    auto writeField = [&](auto member) {
+        for (const Frame& frame : chunk) writeColumn(out, frame.*member);
+    };
+    writeField(&Frame::ids);
+    writeField(&Frame::xs);
+    writeField(&Frame::ys);
+    writeField(&Frame::lifeSpans);
+    writeField(&Frame::introducedIds);
+    writeField(&Frame::speeds);
+    writeField(&Frame::sizes);
+    writeField(&Frame::awareness);
+    writeField(&Frame::foodAddedIds);
+    writeField(&Frame::foodXs);
+    writeField(&Frame::foodYs);
+    writeField(&Frame::foodRemovedIds);
+    const char padding[8] = {};
+    out.write(padding, static_cast<std::streamsize>(header.payloadBytes - columnBytes));
+
+    chunk.clear();
+    if (!out) throw std::runtime_error("Failed to write trajectory file.");
+}
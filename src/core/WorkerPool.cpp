@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <core/WorkerPool.hpp>
+#include <utility>
+
+WorkerPool::WorkerPool(std::size_t threads) {
+    const std::size_t own = std::max<std::size_t>(threads, 1) - 1;
+    this->threads.reserve(own);
+    for (std::size_t i = 0; i < own; i++) {
+        this->threads.emplace_back(&WorkerPool::threadLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for (auto& thread : threads) thread.join();
+}
+
+void WorkerPool::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        this->count = count;
+        next = 0;
+        active = size();
+        error = nullptr;
+        generation++;
+    }
+    started.notify_all();
+    work();
+
+    std::exception_ptr failure;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return active == 0; });
+        this->task = nullptr;
+        failure = std::exchange(error, nullptr);
+    }
+    if (failure) std::rethrow_exception(failure);
+}
+
+void WorkerPool::threadLoop() {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        work();
+    }
+}
+
+/**
+ * @brief Take indices until none are left, then leave the run.
+ *
+ * Runs hand out a few coarse chunks, so one lock per index is negligible.
+ */
+void WorkerPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (next < count) {
+        const std::size_t index = next++;
+        lock.unlock();
+        try {
+            (*task)(index);
+        } catch (...) {
+            lock.lock();
+            if (!error) error = std::current_exception();
+            continue;
+        }
+        lock.lock();
+    }
+    if (--active == 0) finished.notify_one();
+}
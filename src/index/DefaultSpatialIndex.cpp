@@ -24,6 +24,21 @@ void DefaultSpatialIndex<T>::insert(const T &object, float x, float y) {
     spatialObjects.push_back(SpatialObject<T>(object, x, y));
 }
 
+/**
+ * @brief Inserts many objects with a single reallocation.
+ *
+ * @param objects The objects to insert.
+ * @param positions The position of each object.
+ */
+template <typename T>
+void DefaultSpatialIndex<T>::insertBulk(const std::vector<T> &objects,
+                                        const std::vector<std::pair<float, float>> &positions) {
+    spatialObjects.reserve(spatialObjects.size() + objects.size());
+    for (std::size_t i = 0; i < objects.size(); i++) {
+        spatialObjects.emplace_back(objects[i], positions[i].first, positions[i].second);
+    }
+}
+
 /**
  * @brief Queries the spatial index for objects within a specified range.
  *
@@ -104,6 +119,14 @@ typename std::vector<SpatialObject<T>>::iterator DefaultSpatialIndex<T>::findObj
                         [&object](const SpatialObject<T> &o) { return o.getObject() == object; });
 }
 
+/**
+ * @brief Copy the index; the object list is copied as one block.
+ */
+template <typename T>
+std::unique_ptr<ISpatialIndex<T>> DefaultSpatialIndex<T>::clone() const {
+    return std::make_unique<DefaultSpatialIndex<T>>(*this);
+}
+
 // Instantiate the template class for required types
 template class DefaultSpatialIndex<int>;
 template class DefaultSpatialIndex<float>;
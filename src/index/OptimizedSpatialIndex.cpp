@@ -312,6 +312,26 @@ OptimizedSpatialIndex<T>* OptimizedSpatialIndex<T>::_findLeaf(float x, float y)
     return this;
 }
 
+/**
+ * @brief Copy the quadtree node by node, keeping its subdivisions.
+ */
+template <typename T>
+std::unique_ptr<ISpatialIndex<T>> OptimizedSpatialIndex<T>::clone() const {
+    return cloneNode();
+}
+
+template <typename T>
+std::unique_ptr<OptimizedSpatialIndex<T>> OptimizedSpatialIndex<T>::cloneNode() const {
+    auto copy = std::make_unique<OptimizedSpatialIndex<T>>(size);
+    copy->spatialObjects = spatialObjects;
+    copy->isSubdivided = isSubdivided;
+    copy->offset = offset;
+    for (int i = 0; i < 4; i++) {
+        if (children[i]) copy->children[i] = children[i]->cloneNode();
+    }
+    return copy;
+}
+
 // make sure to instantiate the template class
 template class OptimizedSpatialIndex<int>;
 template class OptimizedSpatialIndex<float>;
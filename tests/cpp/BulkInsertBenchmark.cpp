@@ -0,0 +1,63 @@
+#include <chrono>
+#include <core/Environment.hpp>
+#include <core/Food.hpp>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static const int WORLD_SIZE = 4000;
+
+static double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// One generation's worth of food churn: add N foods, then remove them all,
+// once through the per-object API and once through the bulk API.
+static void runFoodChurn(const std::string& type, int count) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> posDist(0.0f, WORLD_SIZE - 1.0f);
+    std::vector<float> xs(count), ys(count);
+    for (int i = 0; i < count; i++) {
+        xs[i] = posDist(rng);
+        ys[i] = posDist(rng);
+    }
+
+    Environment perObject(WORLD_SIZE, WORLD_SIZE, type);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        perObject.add(std::make_shared<Food>(), xs[i], ys[i]);
+    }
+    double addMs = millisSince(start);
+    start = std::chrono::steady_clock::now();
+    for (const auto& food : perObject.getAllFoods()) {
+        perObject.remove(food);
+    }
+    double removeMs = millisSince(start);
+
+    Environment bulk(WORLD_SIZE, WORLD_SIZE, type);
+    start = std::chrono::steady_clock::now();
+    bulk.addFoods(xs, ys);
+    double bulkAddMs = millisSince(start);
+    start = std::chrono::steady_clock::now();
+    bulk.removeKind(ObjectKind::FOOD);
+    double bulkRemoveMs = millisSince(start);
+
+    printf("%-9s %6d foods | add: %8.2f ms per-object, %8.2f ms bulk | remove: %8.2f ms "
+           "per-object, %8.2f ms bulk\n",
+           type.c_str(), count, addMs, bulkAddMs, removeMs, bulkRemoveMs);
+    EXPECT_TRUE(perObject.getAllFoods().empty());
+    EXPECT_TRUE(bulk.getAllFoods().empty());
+}
+
+TEST(BulkInsertBenchmark, FoodChurnDefaultIndex) {
+    for (int count : {400, 4000}) runFoodChurn("default", count);
+}
+
+TEST(BulkInsertBenchmark, FoodChurnOptimizedIndex) {
+    for (int count : {400, 4000}) runFoodChurn("optimized", count);
+}
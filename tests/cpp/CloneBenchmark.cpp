@@ -0,0 +1,65 @@
+#include <chrono>
+#include <core/Environment.hpp>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static const int WORLD_SIZE = 4000;
+static const int OBJECT_COUNT = 100000;
+
+static double millisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Fork a 100k-object environment (half organisms, half food) three ways:
+// clone(), rebuilding it through the bulk add APIs, and a snapshot round trip.
+static void runFork(const std::string& type) {
+    const int half = OBJECT_COUNT / 2;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> posDist(0.0f, WORLD_SIZE - 1.0f);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::vector<float> xs(half), ys(half), foodXs(half), foodYs(half);
+    std::vector<std::uint8_t> dna(4 * half);
+    for (int i = 0; i < half; i++) {
+        xs[i] = posDist(rng);
+        ys[i] = posDist(rng);
+        foodXs[i] = posDist(rng);
+        foodYs[i] = posDist(rng);
+    }
+    for (auto& byte : dna) byte = static_cast<std::uint8_t>(byteDist(rng));
+
+    Environment source(WORLD_SIZE, WORLD_SIZE, type);
+    source.addOrganisms(dna, xs, ys);
+    source.addFoods(foodXs, foodYs);
+
+    auto start = std::chrono::steady_clock::now();
+    auto forked = source.clone();
+    double cloneMs = millisSince(start);
+
+    start = std::chrono::steady_clock::now();
+    Environment rebuilt(WORLD_SIZE, WORLD_SIZE, type);
+    rebuilt.addOrganisms(dna, xs, ys);
+    rebuilt.addFoods(foodXs, foodYs);
+    double rebuildMs = millisSince(start);
+
+    start = std::chrono::steady_clock::now();
+    Environment restored(1, 1);
+    restored.decodeSnapshot(source.encodeSnapshot());
+    double snapshotMs = millisSince(start);
+
+    printf("%-9s %6d objects | clone: %8.2f ms | bulk rebuild: %8.2f ms | snapshot round "
+           "trip: %8.2f ms\n",
+           type.c_str(), OBJECT_COUNT, cloneMs, rebuildMs, snapshotMs);
+    EXPECT_EQ(source.getAllObjects().size(), forked->getAllObjects().size());
+    EXPECT_EQ(source.getAllObjects().size(), rebuilt.getAllObjects().size());
+    EXPECT_EQ(source.getAllObjects().size(), restored.getAllObjects().size());
+}
+
+TEST(CloneBenchmark, ForkDefaultIndex) { runFork("default"); }
+
+TEST(CloneBenchmark, ForkOptimizedIndex) { runFork("optimized"); }
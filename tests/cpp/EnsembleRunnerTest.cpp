@@ -0,0 +1,54 @@
+#include <core/EnsembleRunner.hpp>
+#include <memory>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+static std::shared_ptr<Environment> makeScenario(int organisms, int foods) {
+    auto env = std::make_shared<Environment>(500, 500);
+    for (int i = 0; i < organisms; i++) {
+        env->add(std::make_shared<Organism>(), 10.0f + (i * 37) % 480, 10.0f + (i * 91) % 480);
+    }
+    for (int i = 0; i < foods; i++) {
+        env->add(std::make_shared<Food>(), 10.0f + (i * 53) % 480, 10.0f + (i * 17) % 480);
+    }
+    return env;
+}
+
+TEST(EnsembleRunnerTest, RunsEveryEnvironmentAndSummarisesInOrder) {
+    EnsembleRunner runner(3);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(static_cast<std::size_t>(i), runner.add(makeScenario(10 + i, 50)));
+    }
+
+    auto summaries = runner.run(20);
+    ASSERT_EQ(5u, summaries.size());
+    for (std::size_t i = 0; i < summaries.size(); i++) {
+        const auto& env = *runner.get(i);
+        EXPECT_EQ(env.getAllOrganisms().size(), summaries[i].organisms);
+        EXPECT_EQ(env.getAllFoods().size(), summaries[i].foods);
+        EXPECT_EQ(env.getFoodConsumptionInIteration(), summaries[i].foodConsumption);
+        EXPECT_EQ(10u + i, summaries[i].organisms + summaries[i].deadOrganisms);
+        if (summaries[i].organisms > 0) {
+            EXPECT_FLOAT_EQ(5.0f, summaries[i].meanSpeed);
+        }
+        EXPECT_GE(summaries[i].elapsedMs, 0.0);
+    }
+}
+
+TEST(EnsembleRunnerTest, RethrowsFailuresAfterAllRunsFinish) {
+    EnsembleRunner runner(2);
+    auto failing = makeScenario(1, 0);
+    auto organism = failing->getAllOrganisms().front();
+    organism->setReactionStrategy(
+        [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&)
+            -> std::pair<float, float> { throw std::runtime_error("strategy failed"); });
+    failing->add(std::make_shared<Food>(), organism->getPos().x + 1.0f, organism->getPos().y);
+    auto healthy = makeScenario(5, 5);
+
+    runner.add(failing);
+    runner.add(healthy);
+    EXPECT_THROW(runner.run(5), std::runtime_error);
+    EXPECT_THROW(runner.get(2), std::out_of_range);
+    EXPECT_THROW(runner.add(nullptr), std::invalid_argument);
+}
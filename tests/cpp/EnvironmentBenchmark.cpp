@@ -0,0 +1,313 @@
+// End-to-end throughput of Environment::simulateIteration across population
+// sizes, food layouts, index types and thread counts.
+//
+// Unlike the other benchmarks this is a standalone program, so sweeps too
+// large for ctest can be run by hand and tracked across commits:
+//
+//   benchmark_environment --populations 1000,10000,100000,1000000 \
+//       --foods uniform,oasis --indexes default,optimized --threads 1,8 \
+//       --json results.json
+//
+// Worlds grow with the population to keep the density constant, so
+// organism-ticks per second are comparable across sizes. The brute-force
+// index is skipped above --max-brute-force organisms.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <core/Environment.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<long> populations{1000, 10000, 100000};
+    std::vector<std::string> foods{"uniform", "oasis"};
+    std::vector<std::string> indexes{"default", "optimized"};
+    std::vector<long> threads{
+        1, static_cast<long>(std::max(1u, std::thread::hardware_concurrency()))};
+    long ticks = 20;
+    long warmup = 2;
+    long repetitions = 1;
+    long maxBruteForce = 20000;
+    std::uint32_t seed = 42;
+    double areaPerOrganism = 400.0;  // One organism per 20 x 20 units
+    std::string json;
+    std::string label;
+};
+
+struct Scenario {
+    long population;
+    std::string food;
+    std::string index;
+    long threads;
+
+    std::string name() const {
+        return "n=" + std::to_string(population) + "/food=" + food + "/index=" + index +
+               "/threads=" + std::to_string(threads);
+    }
+};
+
+struct Result {
+    Scenario scenario;
+    int worldSize = 0;
+    std::size_t foods = 0;
+    std::vector<double> seconds;                 // One per repetition
+    std::vector<std::uint64_t> organismTicks;    // Living organisms summed over measured ticks
+    std::vector<double> throughput;              // organismTicks / seconds
+
+    double median() const {
+        std::vector<double> sorted = throughput;
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t n = sorted.size();
+        return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+    }
+};
+
+const char* USAGE =
+    "usage: benchmark_environment [--populations N,...] [--foods uniform,oasis]\n"
+    "           [--indexes default,optimized] [--threads T,...] [--ticks N] [--warmup N]\n"
+    "           [--repetitions N] [--max-brute-force N] [--seed S] [--json PATH|-]\n"
+    "           [--label TEXT]\n";
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    if (items.empty()) throw std::invalid_argument("empty list: " + text);
+    return items;
+}
+
+long parsePositive(const std::string& text) {
+    std::size_t used = 0;
+    long value = std::stol(text, &used);
+    if (used != text.size() || value <= 0) {
+        throw std::invalid_argument("not a positive number: " + text);
+    }
+    return value;
+}
+
+std::vector<long> parseNumbers(const std::string& text) {
+    std::vector<long> values;
+    for (const auto& item : splitList(text)) values.push_back(parsePositive(item));
+    return values;
+}
+
+std::vector<std::string> parseChoices(const std::string& text,
+                                      const std::vector<std::string>& allowed) {
+    auto items = splitList(text);
+    for (const auto& item : items) {
+        if (std::find(allowed.begin(), allowed.end(), item) == allowed.end()) {
+            throw std::invalid_argument("unknown value: " + item);
+        }
+    }
+    return items;
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--help" || flag == "-h") {
+            std::cout << USAGE;
+            std::exit(0);
+        }
+        if (i + 1 >= argc) throw std::invalid_argument("missing value for " + flag);
+        std::string value = argv[++i];
+        if (flag == "--populations") options.populations = parseNumbers(value);
+        else if (flag == "--foods") options.foods = parseChoices(value, {"uniform", "oasis"});
+        else if (flag == "--indexes")
+            options.indexes = parseChoices(value, {"default", "optimized"});
+        else if (flag == "--threads") options.threads = parseNumbers(value);
+        else if (flag == "--ticks") options.ticks = parsePositive(value);
+        else if (flag == "--warmup") options.warmup = value == "0" ? 0 : parsePositive(value);
+        else if (flag == "--repetitions") options.repetitions = parsePositive(value);
+        else if (flag == "--max-brute-force") options.maxBruteForce = parsePositive(value);
+        else if (flag == "--seed") options.seed = static_cast<std::uint32_t>(parsePositive(value));
+        else if (flag == "--json") options.json = value;
+        else if (flag == "--label") options.label = value;
+        else throw std::invalid_argument("unknown option " + flag);
+    }
+    return options;
+}
+
+// Food layout of examples/oasis.py scaled to the world: a third in a central
+// oasis, a third in a wider ring around it, a third anywhere
+void placeFood(const std::string& layout, int worldSize, std::size_t count, std::mt19937& rng,
+               std::vector<float>& xs, std::vector<float>& ys) {
+    auto place = [&](std::size_t n, float low, float high) {
+        std::uniform_real_distribution<float> dist(low * (worldSize - 1), high * (worldSize - 1));
+        for (std::size_t i = 0; i < n; i++) {
+            xs.push_back(dist(rng));
+            ys.push_back(dist(rng));
+        }
+    };
+    if (layout == "oasis") {
+        place(count / 3, 0.4f, 0.6f);
+        place(count / 3, 0.2f, 0.85f);
+        place(count - 2 * (count / 3), 0.0f, 1.0f);
+    } else {
+        place(count, 0.0f, 1.0f);
+    }
+}
+
+// Same seed, same world: organisms with random traits, half as much food.
+// Sizes stay within 2/3 of each other so nobody preys and the population
+// holds steady over the run.
+std::unique_ptr<Environment> buildEnvironment(const Scenario& scenario, const Options& options,
+                                              int worldSize) {
+    auto env = std::make_unique<Environment>(worldSize, worldSize, scenario.index,
+                                             static_cast<int>(scenario.threads));
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> pos(0.0f, static_cast<float>(worldSize - 1));
+    std::uniform_int_distribution<int> speed(16, 48), size(24, 32), awareness(16, 64);
+
+    const auto n = static_cast<std::size_t>(scenario.population);
+    std::vector<std::uint8_t> dna(n * 4);
+    std::vector<float> xs(n), ys(n);
+    for (std::size_t i = 0; i < n; i++) {
+        dna[i * 4] = static_cast<std::uint8_t>(speed(rng));
+        dna[i * 4 + 1] = static_cast<std::uint8_t>(size(rng));
+        dna[i * 4 + 2] = static_cast<std::uint8_t>(awareness(rng));
+        dna[i * 4 + 3] = 0;
+        xs[i] = pos(rng);
+        ys[i] = pos(rng);
+    }
+    env->addOrganisms(dna, xs, ys);
+
+    std::vector<float> foodXs, foodYs;
+    placeFood(scenario.food, worldSize, n / 2, rng, foodXs, foodYs);
+    env->addFoods(foodXs, foodYs);
+    return env;
+}
+
+Result run(const Scenario& scenario, const Options& options) {
+    Result result;
+    result.scenario = scenario;
+    result.worldSize =
+        static_cast<int>(std::ceil(std::sqrt(scenario.population * options.areaPerOrganism)));
+
+    for (long r = 0; r < options.repetitions; r++) {
+        auto env = buildEnvironment(scenario, options, result.worldSize);
+        result.foods = env->getStats().getFoodCount();
+        if (options.warmup > 0) env->simulateIteration(static_cast<int>(options.warmup));
+        env->resetProfile();
+
+        auto start = std::chrono::steady_clock::now();
+        env->simulateIteration(static_cast<int>(options.ticks));
+        double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Every living organism reacts once per tick
+        std::uint64_t organismTicks = env->getProfile().organismsReacted;
+        result.seconds.push_back(seconds);
+        result.organismTicks.push_back(organismTicks);
+        result.throughput.push_back(seconds > 0 ? organismTicks / seconds : 0.0);
+    }
+    return result;
+}
+
+template <typename T>
+void writeArray(std::ostream& out, const std::vector<T>& values) {
+    out << '[';
+    for (std::size_t i = 0; i < values.size(); i++) out << (i ? ", " : "") << values[i];
+    out << ']';
+}
+
+std::string escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+    }
+    return escaped;
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results) {
+    out.precision(9);
+    out << "{\n  \"benchmark\": \"environment\",\n";
+    if (!options.label.empty()) out << "  \"label\": \"" << escape(options.label) << "\",\n";
+    out << "  \"unit\": \"organism_ticks_per_second\",\n"
+        << "  \"ticks\": " << options.ticks << ",\n"
+        << "  \"warmup\": " << options.warmup << ",\n"
+        << "  \"seed\": " << options.seed << ",\n"
+        << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n"
+        << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        out << (i ? "," : "") << "\n    {\"name\": \"" << r.scenario.name() << "\""
+            << ", \"population\": " << r.scenario.population << ", \"food\": \""
+            << r.scenario.food << "\", \"index\": \"" << r.scenario.index
+            << "\", \"threads\": " << r.scenario.threads << ", \"world_size\": " << r.worldSize
+            << ", \"foods\": " << r.foods << ",\n     \"seconds\": ";
+        writeArray(out, r.seconds);
+        out << ", \"organism_ticks\": ";
+        writeArray(out, r.organismTicks);
+        out << ",\n     \"organism_ticks_per_second\": ";
+        writeArray(out, r.throughput);
+        out << ", \"median\": " << r.median() << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "benchmark_environment: " << e.what() << "\n" << USAGE;
+        return 2;
+    }
+    // With the JSON on stdout, the table goes to stderr
+    FILE* table = options.json == "-" ? stderr : stdout;
+
+    std::vector<Result> results;
+    std::fprintf(table, "%-52s %10s %12s %16s\n", "Scenario", "World", "ms/tick", "org*ticks/s");
+    for (long population : options.populations) {
+        for (const auto& food : options.foods) {
+            for (const auto& index : options.indexes) {
+                if (index == "default" && population > options.maxBruteForce) {
+                    std::fprintf(table, "%-52s skipped: brute force above %ld organisms\n",
+                                 Scenario{population, food, index, 1}.name().c_str(),
+                                 options.maxBruteForce);
+                    continue;
+                }
+                for (long threads : options.threads) {
+                    Scenario scenario{population, food, index, threads};
+                    results.push_back(run(scenario, options));
+                    const Result& r = results.back();
+                    double ms = r.seconds.front() * 1e3 / static_cast<double>(options.ticks);
+                    std::fprintf(table, "%-52s %10d %12.3f %16.0f\n", scenario.name().c_str(),
+                                 r.worldSize, ms, r.median());
+                    std::fflush(table);
+                }
+            }
+        }
+    }
+
+    if (options.json == "-") {
+        writeJson(std::cout, options, results);
+    } else if (!options.json.empty()) {
+        std::ofstream out(options.json, std::ios::trunc);
+        writeJson(out, options, results);
+        if (!out.flush()) {
+            std::cerr << "benchmark_environment: cannot write " << options.json << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
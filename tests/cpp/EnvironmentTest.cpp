@@ -0,0 +1,430 @@
+#include <algorithm>
+#include <atomic>
+#include <core/Environment.hpp>
+#include <core/Food.hpp>
+#include <core/Organism.hpp>
+#include <core/WorkerPool.hpp>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+static std::shared_ptr<const Organism::Policy> makePolicy(
+    Organism::BatchReactionStrategy batchReaction) {
+    Organism::Policy policy;
+    policy.lifeConsumptionCalculator = [](const Organism&) { return 0u; };
+    policy.batchReactionStrategy = std::move(batchReaction);
+    return std::make_shared<const Organism::Policy>(std::move(policy));
+}
+
+TEST(EnvironmentTest, BatchReactionRunsOncePerSpeciesPerTick) {
+    Environment env(1000, 1000);
+    int calls = 0;
+    std::size_t lastBatchSize = 0;
+    auto policy = makePolicy([&](const ReactionBatch& batch, std::vector<Vec2>& movements) {
+        calls++;
+        lastBatchSize = batch.size();
+        for (auto& movement : movements) movement = Vec2(1.0f, 0.0f);
+    });
+
+    for (int i = 0; i < 8; i++) {
+        env.add(std::make_shared<Organism>(Genes("\x28\x28\x28\x00"), policy), 100.0f,
+                100.0f + i * 50.0f);
+    }
+    env.simulateIteration(3);
+
+    EXPECT_EQ(3, calls);
+    EXPECT_EQ(8u, lastBatchSize);
+    EXPECT_EQ(2u, env.getSpeciesCount());
+    for (const auto& organism : env.getAllOrganisms()) {
+        EXPECT_GT(organism->getPos().x, 100.0f);
+    }
+}
+
+TEST(EnvironmentTest, BatchReactionSeesDistinctNeighboursInCsrForm) {
+    Environment env(1000, 1000);
+    ReactionBatch seen;
+    auto policy = makePolicy(
+        [&](const ReactionBatch& batch, std::vector<Vec2>&) { seen = batch; });
+
+    // Two organisms that can both see one food item and each other
+    env.add(std::make_shared<Organism>(Genes("\x04\x28\x50\x00"), policy), 100.0f, 100.0f);
+    env.add(std::make_shared<Organism>(Genes("\x04\x28\x50\x00"), policy), 110.0f, 100.0f);
+    env.add(std::make_shared<Food>(), 105.0f, 120.0f);
+    env.simulateIteration(1);
+
+    ASSERT_EQ(2u, seen.size());
+    ASSERT_EQ(3u, seen.neighbourOffsets.size());
+    EXPECT_EQ(2u, seen.neighbourOffsets[1]);
+    EXPECT_EQ(4u, seen.neighbourOffsets[2]);
+    // Each organism sees the other and the food; the food appears once
+    EXPECT_EQ(3u, seen.neighbourCount());
+    int foods = 0;
+    for (auto kind : seen.neighbourKinds) {
+        if (kind == static_cast<std::uint8_t>(ObjectKind::FOOD)) foods++;
+    }
+    EXPECT_EQ(1, foods);
+}
+
+// Native interaction: consume every edible neighbour
+static void consumeAll(const float*, const float* neighbours, std::int32_t count,
+                       std::uint8_t* consume) {
+    for (std::int32_t i = 0; i < count; i++) {
+        consume[i] = neighbours[i * NativeStrategy::NEIGHBOUR_STRIDE + 4] > 0.0f;
+    }
+}
+
+TEST(EnvironmentTest, NativeInteractionConsumesFood) {
+    Environment env(1000, 1000);
+    auto organism = std::make_shared<Organism>(Genes("\x00\x50\x00\x00"));
+    organism->setNativeInteractionStrategy(consumeAll);
+    env.add(organism, 500.0f, 500.0f);
+    env.add(std::make_shared<Food>(300), 505.0f, 505.0f);
+    env.add(std::make_shared<Food>(300), 495.0f, 500.0f);
+
+    float lifeBefore = organism->getLifeSpan();
+    env.simulateIteration(1);
+
+    EXPECT_EQ(2u, env.getFoodConsumptionInIteration());
+    EXPECT_GT(organism->getLifeSpan(), lifeBefore + 500.0f);
+}
+
+TEST(EnvironmentTest, MultiThreadedReactionsChaseFood) {
+    Environment env(1000, 1000, "optimized", 4);
+    std::vector<std::shared_ptr<Organism>> organisms;
+    for (int i = 0; i < 64; i++) {
+        auto organism = std::make_shared<Organism>(Genes("\x10\x10\x80\x00"));
+        float x = 50.0f + (i % 8) * 100.0f, y = 50.0f + (i / 8) * 100.0f;
+        env.add(organism, x, y);
+        // Food to the right, inside the reaction radius but out of reach this tick
+        env.add(std::make_shared<Food>(), x + 20.0f, y);
+        organisms.push_back(organism);
+    }
+
+    env.simulateIteration(1);
+
+    // Every organism reacted to its food and moved right at full speed (4)
+    for (const auto& organism : organisms) {
+        int column = static_cast<int>((organism->getPos().x - 50.0f + 10.0f) / 100.0f);
+        EXPECT_FLOAT_EQ(50.0f + column * 100.0f + 4.0f, organism->getPos().x);
+    }
+}
+
+TEST(EnvironmentTest, WorkerPoolRunsEveryIndexOnReusedThreads) {
+    WorkerPool pool(3);
+    EXPECT_EQ(3u, pool.size());
+    std::vector<std::atomic<int>> runs(50);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    for (int round = 0; round < 20; round++) {
+        pool.run(runs.size(), [&](std::size_t i) {
+            runs[i]++;
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+    }
+    for (const auto& count : runs) EXPECT_EQ(20, count.load());
+    EXPECT_LE(threads.size(), 3u);
+
+    // Every index still runs when one throws; the error reaches the caller
+    std::atomic<int> ran{0};
+    EXPECT_THROW(pool.run(10,
+                          [&](std::size_t i) {
+                              ran++;
+                              if (i == 4) throw std::runtime_error("task failed");
+                          }),
+                 std::runtime_error);
+    EXPECT_EQ(10, ran.load());
+    pool.run(0, [](std::size_t) { FAIL(); });
+}
+
+TEST(EnvironmentTest, RequiresGilOnlyForCallbacksAndCustomObjects) {
+    Environment env(1000, 1000);
+    env.add(std::make_shared<Organism>(), 100.0f, 100.0f);
+    env.add(std::make_shared<Food>(), 200.0f, 200.0f);
+    auto native = std::make_shared<Organism>();
+    native->setNativeInteractionStrategy(consumeAll);
+    env.add(native, 300.0f, 300.0f);
+    EXPECT_FALSE(env.requiresGil());
+
+    auto callback = std::make_shared<Organism>();
+    callback->setReactionStrategy(
+        [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&) {
+            return std::make_pair(0.0f, 0.0f);
+        });
+    env.add(callback, 400.0f, 400.0f);
+    EXPECT_TRUE(env.requiresGil());
+
+    env.remove(callback);
+    EXPECT_FALSE(env.requiresGil());
+    env.add(std::make_shared<EnvironmentObject>(0.0f, 0.0f), 500.0f, 500.0f);
+    EXPECT_TRUE(env.requiresGil());
+}
+
+TEST(EnvironmentTest, SimulateGenerationsSpawnsFoodReproducesAndResets) {
+    Environment env(1000, 1000);
+    env.setSeed(42);
+    // Immortal, motionless organisms that reproduce every generation
+    auto policy = std::make_shared<const Organism::Policy>(
+        Organism::Policy{[](const Organism&) { return 0u; }, {}, {}, {}});
+    for (int i = 0; i < 4; i++) {
+        auto organism = std::make_shared<Organism>(Genes("\x01\x28\x01\x01"), policy);
+        organism->addLifeSpan(5000);
+        env.add(organism, 900.0f, 100.0f + i * 200.0f);
+    }
+
+    GenerationPolicy generation;
+    generation.foodRegions.push_back({0.0f, 0.0f, 100.0f, 100.0f, 30});
+    generation.foodRegions.push_back({200.0f, 200.0f, 300.0f, 300.0f, 20});
+    generation.maxPopulation = 10;
+
+    std::vector<std::size_t> foodsSeen;
+    env.simulateGenerations(3, 2, generation, [&](const Environment& e, int) {
+        foodsSeen.push_back(e.getAllFoods().size());
+        for (const auto& food : e.getAllFoods()) {
+            Vec2 pos = food->getPos();
+            bool inFirst = pos.x < 100.0f && pos.y < 100.0f;
+            bool inSecond = pos.x >= 200.0f && pos.x < 300.0f && pos.y >= 200.0f && pos.y < 300.0f;
+            EXPECT_TRUE(inFirst || inSecond);
+        }
+    });
+
+    EXPECT_EQ((std::vector<std::size_t>{50, 50, 50}), foodsSeen);
+    EXPECT_TRUE(env.getAllFoods().empty());
+    // 4 -> 8 -> 10 (capped) -> 10
+    EXPECT_EQ(10u, env.getAllOrganisms().size());
+}
+
+TEST(EnvironmentTest, SimulateGenerationsRejectsBadRegions) {
+    Environment env(100, 100);
+    env.add(std::make_shared<Organism>(), 50.0f, 50.0f);
+    GenerationPolicy generation;
+    generation.foodRegions.push_back({10.0f, 10.0f, 5.0f, 20.0f, 1});
+    EXPECT_THROW(env.simulateGenerations(1, 1, generation), std::invalid_argument);
+    generation.foodRegions = {{10.0f, 10.0f, 500.0f, 20.0f, 1}};
+    EXPECT_THROW(env.simulateGenerations(1, 1, generation), std::out_of_range);
+}
+
+TEST(EnvironmentTest, BulkAddAndRemove) {
+    Environment env(1000, 1000, "optimized");
+    std::vector<float> xs = {10.0f, 20.0f, 30.0f}, ys = {10.0f, 20.0f, 30.0f};
+    std::vector<int> energies = {100, 200, 300};
+    env.addFoods(xs, ys, energies);
+    std::vector<std::uint8_t> dna = {40, 40, 40, 0, 80, 80, 80, 0};
+    env.addOrganisms(dna, std::vector<float>{500.0f, 600.0f}, std::vector<float>{500.0f, 600.0f});
+
+    ASSERT_EQ(3u, env.getAllFoods().size());
+    ASSERT_EQ(2u, env.getAllOrganisms().size());
+    int totalEnergy = 0;
+    for (const auto& food : env.getAllFoods()) totalEnergy += food->getEnergy();
+    EXPECT_EQ(600, totalEnergy);
+
+    // Nothing is added when any position is out of bounds
+    std::vector<float> bad = {10.0f, 5000.0f};
+    EXPECT_THROW(env.addFoods(bad, bad), std::out_of_range);
+    EXPECT_THROW(env.addFoods(xs, bad), std::invalid_argument);
+    EXPECT_EQ(3u, env.getAllFoods().size());
+
+    EXPECT_EQ(1u, env.removeWhere([](const EnvironmentObject& object) {
+        return object.getKind() == ObjectKind::ORGANISM && object.getPos().x > 550.0f;
+    }));
+    EXPECT_EQ(3u, env.removeKind(ObjectKind::FOOD));
+    EXPECT_TRUE(env.getAllFoods().empty());
+    ASSERT_EQ(1u, env.getAllOrganisms().size());
+    EXPECT_FLOAT_EQ(10.0f, env.getAllOrganisms().front()->getSpeed());
+
+    // The rebuilt index still answers queries: the survivor finds new food
+    env.addFoods(std::vector<float>{505.0f}, std::vector<float>{500.0f});
+    env.simulateIteration(1);
+    EXPECT_EQ(1u, env.getFoodConsumptionInIteration());
+}
+
+TEST(EnvironmentTest, StateIsColumnarAndCachedUntilMutation) {
+    Environment env(1000, 1000);
+    env.add(std::make_shared<Food>(300), 10.0f, 20.0f);
+    env.add(std::make_shared<Organism>(Genes("\x28\x50\xC8\x00")), 100.0f, 200.0f);
+    env.add(std::make_shared<EnvironmentObject>(0.0f, 0.0f), 500.0f, 500.0f);
+
+    auto state = env.getState();
+    ASSERT_EQ(3u, state->size());
+    EXPECT_EQ(1u, state->organismCount);
+    EXPECT_EQ(1u, state->foodCount);
+    // Organisms first, then food, then custom objects
+    EXPECT_EQ(static_cast<std::uint8_t>(ObjectKind::ORGANISM), state->kinds[0]);
+    EXPECT_EQ(static_cast<std::uint8_t>(ObjectKind::FOOD), state->kinds[1]);
+    EXPECT_EQ(static_cast<std::uint8_t>(ObjectKind::CUSTOM), state->kinds[2]);
+    EXPECT_FLOAT_EQ(100.0f, state->positions[0]);
+    EXPECT_FLOAT_EQ(20.0f, state->positions[3]);
+    EXPECT_FLOAT_EQ(500.0f, state->lifeSpans[0]);
+    EXPECT_FLOAT_EQ(300.0f, state->energies[1]);
+    EXPECT_FLOAT_EQ(20.0f, state->traits[1]);
+    EXPECT_EQ(1, state->alive[1]);
+
+    EXPECT_EQ(state, env.getState());
+    env.simulateIteration(1);
+    auto next = env.getState();
+    EXPECT_NE(state, next);
+    EXPECT_GT(next->version, state->version);
+    // The old snapshot stays valid and unchanged
+    EXPECT_FLOAT_EQ(100.0f, state->positions[0]);
+}
+
+TEST(EnvironmentTest, StatsFollowAddsRemovesAndDeaths) {
+    Environment env(1000, 1000);
+    auto slow = std::make_shared<Organism>(Genes("\x28\x50\xC8\x00"));
+    auto fast = std::make_shared<Organism>(Genes("\x78\x28\x28\x00"));
+    env.add(slow, 100.0f, 100.0f);
+    env.add(fast, 800.0f, 800.0f);
+    env.add(std::make_shared<Food>(), 400.0f, 400.0f);
+
+    const auto& stats = env.getStats();
+    EXPECT_EQ(2u, stats.getOrganismCount());
+    EXPECT_EQ(1u, stats.getFoodCount());
+    EXPECT_DOUBLE_EQ(20.0, stats.getMean(PopulationStats::SPEED));
+    EXPECT_DOUBLE_EQ(100.0, stats.getVariance(PopulationStats::SPEED));
+    EXPECT_EQ(1u, stats.getHistogram(PopulationStats::SIZE)[PopulationStats::binOf(20.0f)]);
+
+    // Removal is exact: the statistics equal those of the survivor alone
+    env.remove(slow);
+    EXPECT_EQ(1u, stats.getOrganismCount());
+    EXPECT_DOUBLE_EQ(30.0, stats.getMean(PopulationStats::SPEED));
+    EXPECT_DOUBLE_EQ(0.0, stats.getVariance(PopulationStats::SPEED));
+    EXPECT_EQ(0u, stats.getHistogram(PopulationStats::SIZE)[PopulationStats::binOf(20.0f)]);
+
+    // Deaths leave the statistics when the iteration cleans them up
+    env.addFoods(std::vector<float>{10.0f, 20.0f}, std::vector<float>{10.0f, 20.0f});
+    env.simulateIteration(600);
+    EXPECT_EQ(0u, stats.getOrganismCount());
+    EXPECT_EQ(env.getAllFoods().size(), stats.getFoodCount());
+
+    auto history = stats.getHistory();
+    ASSERT_EQ(600u, history.size());
+    EXPECT_EQ(1u, history.front().tick);
+    EXPECT_EQ(1u, history.front().organisms);
+    EXPECT_FLOAT_EQ(30.0f, history.front().meanSpeed);
+    EXPECT_EQ(0u, history.back().organisms);
+    EXPECT_EQ(600u, env.getTickCount());
+}
+
+TEST(EnvironmentTest, StatsHistoryIsABoundedRingBuffer) {
+    Environment env(100, 100);
+    env.add(std::make_shared<Food>(), 50.0f, 50.0f);
+    env.setStatsHistoryCapacity(4);
+    env.simulateIteration(10);
+    auto history = env.getStats().getHistory();
+    ASSERT_EQ(4u, history.size());
+    EXPECT_EQ(7u, history.front().tick);
+    EXPECT_EQ(10u, history.back().tick);
+    EXPECT_THROW(env.setStatsHistoryCapacity(0), std::invalid_argument);
+}
+
+TEST(EnvironmentTest, CloneIsIndependentAndKeepsTheIndex) {
+    for (const char* type : {"default", "optimized"}) {
+        Environment env(1000, 1000, type);
+        auto organism = std::make_shared<Organism>(Genes("\x28\x50\xC8\x00"));
+        env.add(organism, 100.0f, 100.0f);
+        env.add(std::make_shared<Food>(200), 900.0f, 900.0f);
+        env.addFoods(std::vector<float>{105.0f}, std::vector<float>{100.0f});
+
+        auto copy = env.clone();
+        EXPECT_EQ(env.getStats().getOrganismCount(), copy->getStats().getOrganismCount());
+        ASSERT_EQ(1u, copy->getAllOrganisms().size());
+        auto copied = copy->getAllOrganisms().front();
+        EXPECT_NE(organism.get(), copied.get());
+        EXPECT_EQ(organism->getId(), copied->getId());
+        EXPECT_EQ(organism->getPolicy(), copied->getPolicy());
+
+        // The copied index finds the nearby food; the original is unaffected
+        copy->simulateIteration(1);
+        EXPECT_EQ(1u, copy->getFoodConsumptionInIteration());
+        EXPECT_FLOAT_EQ(1000.0f - copied->getLifeConsumption(), copied->getLifeSpan());
+        EXPECT_EQ(0u, env.getFoodConsumptionInIteration());
+        EXPECT_FLOAT_EQ(500.0f, organism->getLifeSpan());
+        EXPECT_EQ(2u, env.getAllFoods().size());
+    }
+}
+
+TEST(EnvironmentTest, RenderCountsObjectsAndCoversDiscs) {
+    Environment env(400, 400);
+    auto organism = std::make_shared<Organism>(Genes("\x28\x50\xC8\x00"));
+    env.add(organism, 200.0f, 200.0f);
+    env.add(std::make_shared<Food>(), 40.0f, 360.0f);
+    env.add(std::make_shared<Food>(), 44.0f, 364.0f);
+
+    // 40 x 20 pixels: each pixel spans 10 x 20 units
+    std::vector<RenderLayer> layers{RenderLayer::ORGANISMS, RenderLayer::FOOD,
+                                    RenderLayer::SIZE, RenderLayer::AWARENESS};
+    Raster raster = env.render(40, 20, layers);
+    const std::size_t pixels = 40 * 20;
+    ASSERT_EQ(4 * pixels, raster.data.size());
+    EXPECT_FLOAT_EQ(1.0f, raster.plane(0)[10 * 40 + 20]);
+    EXPECT_FLOAT_EQ(2.0f, raster.plane(1)[18 * 40 + 4]);
+    EXPECT_FLOAT_EQ(2.0f, std::accumulate(raster.plane(1), raster.plane(1) + pixels, 0.0f));
+
+    // Covered pixels approximate the disc areas in pixels
+    auto covered = [&](std::size_t l) {
+        return std::count(raster.plane(l), raster.plane(l) + pixels, 1.0f);
+    };
+    auto expected = [](float radius) { return 3.14159265f * radius * radius / (10.0f * 20.0f); };
+    float body = expected(organism->getSize()), reach = expected(organism->getReactionRadius());
+    EXPECT_NEAR(body, covered(2), 2.0f + body * 0.3f);
+    EXPECT_NEAR(reach, covered(3), 2.0f + reach * 0.3f);
+
+    // Row bands drawn by several threads produce the same image
+    EXPECT_EQ(raster.data, env.render(40, 20, layers, 4).data);
+
+    auto rgba = raster.toRGBA();
+    ASSERT_EQ(pixels * 4, rgba.size());
+    EXPECT_EQ(255, rgba[(18 * 40 + 4) * 4 + 1]);  // Densest food pixel is full green
+    for (std::size_t p = 0; p < pixels; p++) {
+        bool empty = raster.plane(0)[p] + raster.plane(1)[p] + raster.plane(2)[p] +
+                         raster.plane(3)[p] == 0.0f;
+        EXPECT_EQ(empty, rgba[p * 4 + 3] == 0);  // Only empty pixels stay transparent
+    }
+
+    EXPECT_THROW(env.render(0, 10, layers), std::invalid_argument);
+    EXPECT_THROW(env.render(10, 10, {}), std::invalid_argument);
+}
+
+TEST(EnvironmentTest, RenderMarksZeroRadiusOrganismsAtTheirCentre) {
+    Environment env(40, 40);
+    // Size and awareness genes of 0, centred exactly on a pixel centre
+    env.add(std::make_shared<Organism>(Genes("\x28\x00\x00\x00")), 15.0f, 25.0f);
+    Raster raster = env.render(4, 4, {RenderLayer::SIZE, RenderLayer::AWARENESS});
+    EXPECT_FLOAT_EQ(1.0f, raster.plane(0)[2 * 4 + 1]);
+    EXPECT_FLOAT_EQ(1.0f, std::accumulate(raster.plane(0), raster.plane(0) + 16, 0.0f));
+    EXPECT_FLOAT_EQ(1.0f, std::accumulate(raster.plane(1), raster.plane(1) + 16, 0.0f));
+}
+
+TEST(EnvironmentTest, DistinctLivePoliciesAreCappedBySpeciesId) {
+    Environment env(100, 100);
+    const std::size_t limit = std::numeric_limits<Organism::SpeciesId>::max() + std::size_t{1};
+    for (std::size_t i = 1; i < limit; i++) {
+        env.add(std::make_shared<Organism>(Genes("\x14\x14\x14\x14"),
+                                           std::make_shared<const Organism::Policy>()),
+                50.0f, 50.0f);
+    }
+    EXPECT_EQ(limit, env.getSpeciesCount());
+
+    // One policy more does not fit; the environment is left as it was
+    auto extra = std::make_shared<Organism>(Genes("\x14\x14\x14\x14"),
+                                            std::make_shared<const Organism::Policy>());
+    EXPECT_THROW(env.add(extra, 50.0f, 50.0f), std::length_error);
+    EXPECT_EQ(limit - 1, env.getAllOrganisms().size());
+}
+
+static std::uint32_t noDrain(const Organism&) { return 0; }
+
+TEST(EnvironmentTest, OrganismsOfOneCalculatorFunctionAreOneSpecies) {
+    Environment env(100, 100);
+    const std::size_t count = std::numeric_limits<Organism::SpeciesId>::max() + std::size_t{100};
+    for (std::size_t i = 0; i < count; i++) {
+        env.add(std::make_shared<Organism>(Genes("\x14\x14\x14\x14"), noDrain), 50.0f, 50.0f);
+    }
+    EXPECT_EQ(2u, env.getSpeciesCount());
+}
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <atomic>
+#include <core/Environment.hpp>
+#include <core/LiveFeed.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+std::string uniqueName(const char* test) {
+    return "/simevo_test_" + std::to_string(::getpid()) + "_" + test;
+}
+
+// Read-only mapping of a feed segment, as an observer process would hold it
+struct Observer {
+    const char* segment = nullptr;
+    std::size_t size = 0;
+
+    explicit Observer(const LiveFeed& feed) : size(feed.getSize()) {
+        int fd = ::shm_open(feed.getName().c_str(), O_RDONLY, 0);
+        EXPECT_GE(fd, 0);
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        segment = static_cast<const char*>(mapped);
+    }
+    ~Observer() { ::munmap(const_cast<char*>(segment), size); }
+
+    const LiveFeed::SegmentHeader& header() const {
+        return *reinterpret_cast<const LiveFeed::SegmentHeader*>(segment);
+    }
+
+    // Seqlock read of the active buffer: header plus the x column
+    bool read(LiveFeed::BufferHeader& out, std::vector<float>& xs) const {
+        auto& h = header();
+        std::uint32_t active = std::atomic_ref<std::uint32_t>(
+                                   const_cast<std::uint32_t&>(h.active))
+                                   .load(std::memory_order_acquire);
+        const char* buffer = segment + sizeof(LiveFeed::SegmentHeader) + active * h.bufferBytes;
+        auto& sequence = const_cast<std::uint64_t&>(
+            reinterpret_cast<const LiveFeed::BufferHeader*>(buffer)->sequence);
+        std::uint64_t before = std::atomic_ref<std::uint64_t>(sequence).load(std::memory_order_acquire);
+        if (before % 2 == 1) return false;
+        std::memcpy(&out, buffer, sizeof(out));
+        const float* column = reinterpret_cast<const float*>(buffer + sizeof(LiveFeed::BufferHeader));
+        xs.assign(column, column + std::min(out.organismRows, h.organismCapacity));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return std::atomic_ref<std::uint64_t>(sequence).load(std::memory_order_relaxed) == before;
+    }
+};
+
+}  // namespace
+
+TEST(LiveFeedTest, PublishesEveryIntervalWithinCapacity) {
+    Environment env(500, 500);
+    for (int i = 0; i < 3; i++) env.add(std::make_shared<Organism>(), 100.0f * (i + 1), 50.0f);
+    for (int i = 0; i < 5; i++) env.add(std::make_shared<Food>(), 400.0f, 80.0f * (i + 1));
+
+    std::string name = uniqueName("capacity");
+    auto feed = std::make_shared<LiveFeed>(name.substr(1), 2, 10, 2);  // '/' is optional
+    EXPECT_EQ(name, feed->getName());
+    env.setLiveFeed(feed);
+    Observer observer(*feed);
+    EXPECT_EQ(0, std::memcmp(observer.header().magic, "SIMEVOLF", 8));
+    EXPECT_EQ(LiveFeed::FORMAT_VERSION, observer.header().version);
+
+    env.simulateIteration(5);
+    EXPECT_EQ(2u, feed->getPublishedCount());
+    EXPECT_EQ(2u, observer.header().published);
+    EXPECT_FLOAT_EQ(500.0f, observer.header().width);
+
+    LiveFeed::BufferHeader latest;
+    std::vector<float> xs;
+    ASSERT_TRUE(observer.read(latest, xs));
+    EXPECT_EQ(4u, latest.tick);
+    EXPECT_EQ(0u, latest.sequence % 2);
+    EXPECT_EQ(3u, latest.organisms);
+    EXPECT_EQ(2u, latest.organismRows);  // Truncated to the capacity
+    EXPECT_EQ(latest.foods, latest.foodRows);
+    ASSERT_EQ(2u, xs.size());
+    EXPECT_GT(xs[0], 0.0f);
+
+    env.setLiveFeed(nullptr);
+    env.simulateIteration(2);
+    EXPECT_EQ(2u, feed->getPublishedCount());
+}
+
+TEST(LiveFeedTest, CountsFoodEatenSinceThePreviousPublication) {
+    Environment env(100, 100);
+    env.add(std::make_shared<Organism>(), 50.0f, 50.0f);
+    env.add(std::make_shared<Food>(), 50.0f, 50.0f);
+    auto feed = std::make_shared<LiveFeed>(uniqueName("eaten"), 4, 4, 2);
+    env.setLiveFeed(feed);
+    Observer observer(*feed);
+    LiveFeed::BufferHeader latest;
+    std::vector<float> xs;
+
+    // Eaten in the first tick, published with the second
+    env.simulateIteration(3);
+    ASSERT_EQ(1u, env.getFoodConsumptionInIteration());
+    ASSERT_TRUE(observer.read(latest, xs));
+    EXPECT_EQ(2u, latest.tick);
+    EXPECT_EQ(1u, latest.foodConsumed);
+
+    // The running total stays 1; nothing was eaten since
+    env.simulateIteration(2);
+    ASSERT_TRUE(observer.read(latest, xs));
+    EXPECT_EQ(4u, latest.tick);
+    EXPECT_EQ(0u, latest.foodConsumed);
+    EXPECT_EQ(0u, env.getFoodEatenInTick());
+}
+
+TEST(LiveFeedTest, RestoredSnapshotsDoNotRecountEatenFood) {
+    Environment env(100, 100);
+    env.add(std::make_shared<Organism>(), 50.0f, 50.0f);
+    env.add(std::make_shared<Food>(), 50.0f, 50.0f);
+    env.simulateIteration(1);
+    ASSERT_EQ(1u, env.getFoodConsumptionInIteration());
+    // Taken before clean-up, so the second food is still awaiting removal
+    auto organism = env.getAllOrganisms().front();
+    env.add(std::make_shared<Food>(), organism->getPos().x, organism->getPos().y);
+    std::string bytes;
+    env.simulateIteration(1, [&](const Environment& e) { bytes = e.encodeSnapshot(); });
+    ASSERT_EQ(2u, env.getFoodConsumptionInIteration());
+
+    Environment restored(1, 1);
+    restored.decodeSnapshot(bytes);
+    EXPECT_EQ(0u, restored.getFoodEatenInTick());
+    auto feed = std::make_shared<LiveFeed>(uniqueName("restored"), 4, 4, 1);
+    restored.setLiveFeed(feed);
+    Observer observer(*feed);
+    LiveFeed::BufferHeader latest;
+    std::vector<float> xs;
+
+    // Only the third food is new in the first tick after the restore
+    organism = restored.getAllOrganisms().front();
+    restored.add(std::make_shared<Food>(), organism->getPos().x, organism->getPos().y);
+    restored.simulateIteration(1);
+    EXPECT_EQ(1u, restored.getFoodEatenInTick());
+    ASSERT_TRUE(observer.read(latest, xs));
+    EXPECT_EQ(1u, latest.foodConsumed);
+}
+
+TEST(LiveFeedTest, ConcurrentObserverOnlySeesCompleteBuffers) {
+    Environment env(1000, 1000);
+    for (int i = 0; i < 200; i++) env.add(std::make_shared<Organism>(), 5.0f * i, 5.0f * i);
+    auto feed = std::make_shared<LiveFeed>(uniqueName("concurrent"), 256, 16);
+    env.setLiveFeed(feed);
+    Observer observer(*feed);
+
+    std::atomic<bool> done{false};
+    std::size_t consistentReads = 0;
+    std::uint64_t lastTick = 0;
+    bool ordered = true, complete = true;
+    std::thread reader([&] {
+        LiveFeed::BufferHeader latest;
+        std::vector<float> xs;
+        while (!done.load()) {
+            std::this_thread::yield();
+            if (!observer.read(latest, xs) || latest.tick == 0) continue;
+            consistentReads++;
+            ordered = ordered && latest.tick >= lastTick;
+            lastTick = latest.tick;
+            complete = complete && latest.organismRows == latest.organisms &&
+                       xs.size() == latest.organisms;
+        }
+    });
+    env.simulateIteration(300);
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(300u, feed->getPublishedCount());
+    EXPECT_GT(consistentReads, 0u);
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(complete);
+}
+
+TEST(LiveFeedTest, RejectsBadArgumentsAndUnlinksOnDestruction) {
+    EXPECT_THROW(LiveFeed("", 1, 1), std::invalid_argument);
+    EXPECT_THROW(LiveFeed("a/b", 1, 1), std::invalid_argument);
+    EXPECT_THROW(LiveFeed(uniqueName("interval"), 1, 1, 0), std::invalid_argument);
+
+    std::string name = uniqueName("unlink");
+    { LiveFeed feed(name, 4, 4); }
+    EXPECT_LT(::shm_open(name.c_str(), O_RDONLY, 0), 0);
+}
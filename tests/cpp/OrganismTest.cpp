@@ -0,0 +1,215 @@
+#include <core/Food.hpp>
+#include <core/Organism.hpp>
+#include <memory>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+TEST(OrganismTest, DecodesTraitsFromGenes) {
+    Organism organism(Genes("\x28\x50\xC8\x00"));
+    EXPECT_FLOAT_EQ(10.0f, organism.getSpeed());
+    EXPECT_FLOAT_EQ(20.0f, organism.getSize());
+    EXPECT_FLOAT_EQ(50.0f, organism.getAwareness());
+    EXPECT_FLOAT_EQ(70.0f, organism.getReactionRadius());
+}
+
+TEST(OrganismTest, DefaultLifeConsumptionMatchesFormula) {
+    Organism organism(Genes("\x28\x50\xC8\x00"));
+    float speed = 10.0f, size = 20.0f, awareness = 50.0f;
+    float expected = (speed / 10 * speed / 10 + size / 10 * size / 10 * size / 15 +
+                      awareness / 10) * 1.3;
+    EXPECT_FLOAT_EQ(expected, organism.getLifeConsumption());
+}
+
+TEST(OrganismTest, CustomLifeConsumptionCalculatorOverridesDefault) {
+    Organism organism(Genes("\x28\x50\xC8\x00"),
+                      [](const Organism& self) { return static_cast<uint32_t>(self.getSize()); });
+    EXPECT_FLOAT_EQ(20.0f, organism.getLifeConsumption());
+}
+
+TEST(OrganismTest, OffspringDecodesItsOwnGenes) {
+    Genes genes("\x28\x50\xC8\x00", [](char dna[4]) { dna[1] += 4; });
+    Organism parent(genes);
+    auto child = parent.reproduce();
+    EXPECT_FLOAT_EQ(20.0f, parent.getSize());
+    EXPECT_FLOAT_EQ(21.0f, child->getSize());
+    EXPECT_FLOAT_EQ(71.0f, child->getReactionRadius());
+}
+
+TEST(OrganismTest, CarriesKindTag) {
+    std::shared_ptr<EnvironmentObject> organism = std::make_shared<Organism>();
+    std::shared_ptr<EnvironmentObject> food = std::make_shared<Food>();
+    EnvironmentObject custom(0, 0);
+    EXPECT_EQ(ObjectKind::ORGANISM, organism->getKind());
+    EXPECT_EQ(ObjectKind::FOOD, food->getKind());
+    EXPECT_EQ(ObjectKind::CUSTOM, custom.getKind());
+    EXPECT_EQ(organism.get(), organism->as<Organism>());
+}
+
+TEST(OrganismTest, OffspringSharesParentPolicy) {
+    auto policy = std::make_shared<const Organism::Policy>(
+        Organism::Policy{[](const Organism&) { return 0u; }, {}, {}, {}});
+    Organism parent(Genes("\x28\x50\xC8\x00"), policy);
+    parent.setSpeciesId(3);
+    auto child = parent.reproduce();
+    EXPECT_EQ(policy, child->getPolicy());
+    EXPECT_EQ(3, child->getSpeciesId());
+}
+
+TEST(OrganismTest, SettingStrategyCreatesNewPolicy) {
+    Organism organism;
+    EXPECT_EQ(Organism::defaultPolicy(), organism.getPolicy());
+    EXPECT_FALSE(organism.hasCustomStrategy());
+    organism.setReactionStrategy(
+        [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&) {
+            return std::make_pair(1.0f, 0.0f);
+        });
+    EXPECT_NE(Organism::defaultPolicy(), organism.getPolicy());
+    EXPECT_TRUE(organism.hasCustomStrategy());
+}
+
+static std::uint32_t drainBySize(const Organism& self) {
+    return static_cast<std::uint32_t>(self.getSize());
+}
+
+TEST(OrganismTest, OneCalculatorFunctionIsOnePolicy) {
+    Organism first(Genes("\x28\x50\xC8\x00"), drainBySize);
+    Organism second(Genes("\x14\x14\x14\x14"), drainBySize);
+    EXPECT_EQ(first.getPolicy(), second.getPolicy());
+    EXPECT_NE(Organism::defaultPolicy(), first.getPolicy());
+    EXPECT_FLOAT_EQ(20.0f, first.getLifeConsumption());
+
+    // Lambdas have no identity to share by; the caller's identity stands in
+    auto lambda = [](const Organism&) { return 1u; };
+    EXPECT_NE(Organism(Genes("\x14\x14\x14\x14"), lambda).getPolicy(),
+              Organism(Genes("\x14\x14\x14\x14"), lambda).getPolicy());
+    int identity = 0;
+    EXPECT_EQ(Organism::lifeConsumptionPolicy(lambda, &identity),
+              Organism::lifeConsumptionPolicy(lambda, &identity));
+    EXPECT_EQ(Organism::defaultPolicy(), Organism::lifeConsumptionPolicy(nullptr, &identity));
+}
+
+static std::pair<float, float> drift(Organism&,
+                                     const std::vector<std::shared_ptr<EnvironmentObject>>&) {
+    return {1.0f, 0.0f};
+}
+
+TEST(OrganismTest, OneStrategyCallableIsOnePolicy) {
+    Organism first, second, other(Genes("\x14\x14\x14\x14"), drainBySize);
+    first.setReactionStrategy(drift);
+    second.setReactionStrategy(drift);
+    EXPECT_EQ(first.getPolicy(), second.getPolicy());
+    EXPECT_NE(Organism::defaultPolicy(), first.getPolicy());
+
+    // The derived policy depends on what it was derived from
+    other.setReactionStrategy(drift);
+    EXPECT_NE(first.getPolicy(), other.getPolicy());
+    EXPECT_TRUE(static_cast<bool>(other.getPolicy()->lifeConsumptionCalculator));
+
+    // Lambdas share by the caller's identity, or not at all
+    auto interact = [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&) {};
+    int identity = 0;
+    first.setInteractionStrategy(interact, &identity);
+    second.setInteractionStrategy(interact, &identity);
+    EXPECT_EQ(first.getPolicy(), second.getPolicy());
+    second.setInteractionStrategy(interact);
+    EXPECT_NE(first.getPolicy(), second.getPolicy());
+}
+
+// Native reaction: head towards the first neighbour
+static void towardsFirst(const float* self, const float* neighbours, std::int32_t count,
+                         float* direction) {
+    if (count == 0) return;
+    direction[0] = neighbours[0] - self[0];
+    direction[1] = neighbours[1] - self[1];
+}
+
+TEST(OrganismTest, NativeStrategiesDoNotRequireGil) {
+    Organism organism;
+    organism.setNativeReactionStrategy(towardsFirst);
+    EXPECT_TRUE(organism.hasCustomStrategy());
+    EXPECT_FALSE(organism.requiresGil());
+
+    organism.setInteractionStrategy(
+        [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&) {});
+    EXPECT_TRUE(organism.requiresGil());
+}
+
+TEST(OrganismTest, NativeReactionSetsMovement) {
+    Organism organism(Genes("\x28\x28\x28\x00"));
+    organism.setNativeReactionStrategy(towardsFirst);
+    organism.setPosition(100, 100);
+    auto food = std::make_shared<Food>();
+    food->setPosition(103, 104);
+
+    organism.react({food});
+    organism.postIteration();
+
+    // Direction (3, 4) has length 5, below the speed of 10, so it is applied as is
+    EXPECT_FLOAT_EQ(103.0f, organism.getPos().x);
+    EXPECT_FLOAT_EQ(104.0f, organism.getPos().y);
+}
+
+// Herbivore: flee anything at least as big within 20, otherwise seek food and eat it
+static std::shared_ptr<const RuleBasedStrategy> herbivoreRules() {
+    RuleBasedStrategy::Rule flee;
+    flee.target = ObjectKind::ORGANISM;
+    flee.minSizeRatio = 1.0f;
+    flee.range = 20.0f;
+    flee.weight = -10.0f;
+    RuleBasedStrategy::Rule seek;
+    seek.consume = true;
+    return std::make_shared<const RuleBasedStrategy>(
+        std::vector<RuleBasedStrategy::Rule>{flee, seek});
+}
+
+TEST(OrganismTest, RuleBasedReactionWeighsNearestMatches) {
+    Organism herbivore(Genes("\x28\x28\x28\x00"));
+    herbivore.setRuleBasedStrategy(herbivoreRules());
+    EXPECT_TRUE(herbivore.hasCustomStrategy());
+    EXPECT_FALSE(herbivore.requiresGil());
+    herbivore.setPosition(100, 100);
+
+    auto food = std::make_shared<Food>();
+    food->setPosition(110, 100);
+    auto predator = std::make_shared<Organism>(Genes("\x28\x50\x28\x00"));
+    predator->setPosition(100, 90);
+
+    // Repulsion of 10 from the predator dominates attraction of 1 to the food
+    auto direction = herbivore.getPolicy()->rules->react(herbivore, {food, predator});
+    EXPECT_FLOAT_EQ(1.0f, direction.first);
+    EXPECT_FLOAT_EQ(10.0f, direction.second);
+
+    // Out of the flee range only the food attracts
+    predator->setPosition(100, 70);
+    direction = herbivore.getPolicy()->rules->react(herbivore, {food, predator});
+    EXPECT_FLOAT_EQ(1.0f, direction.first);
+    EXPECT_FLOAT_EQ(0.0f, direction.second);
+}
+
+TEST(OrganismTest, RuleBasedInteractionConsumesFirstMatch) {
+    RuleBasedStrategy::Rule prey;
+    prey.target = ObjectKind::ORGANISM;
+    prey.maxSizeRatio = 1.0f / 1.2f;
+    prey.consume = true;
+    Organism predator(Genes("\x28\x50\x28\x00"));
+    predator.setRuleBasedStrategy(std::make_shared<const RuleBasedStrategy>(
+        std::vector<RuleBasedStrategy::Rule>{prey}));
+
+    auto small = std::make_shared<Organism>(Genes("\x28\x28\x28\x00"));
+    auto big = std::make_shared<Organism>(Genes("\x28\x50\x28\x00"));
+    auto food = std::make_shared<Food>();
+    predator.interact({small, big, food});
+
+    EXPECT_FALSE(small->isAlive());
+    EXPECT_TRUE(big->isAlive());
+    EXPECT_TRUE(food->canBeEaten());
+    EXPECT_FLOAT_EQ(1000.0f, predator.getLifeSpan());
+}
+
+TEST(OrganismTest, RuleBasedStrategyRejectsInvalidRules) {
+    RuleBasedStrategy::Rule rule;
+    rule.minSizeRatio = 2.0f;
+    rule.maxSizeRatio = 1.0f;
+    EXPECT_THROW(RuleBasedStrategy({rule}), std::invalid_argument);
+}
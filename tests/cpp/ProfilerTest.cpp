@@ -0,0 +1,352 @@
+#include <algorithm>
+#include <chrono>
+#include <core/Environment.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utils/perf_counters.hpp>
+#include <utils/profiler.hpp>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+void spin(std::chrono::microseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+}  // namespace
+
+#ifdef SIMEVO_DISABLE_PROFILING
+#define SKIP_IF_COMPILED_OUT() GTEST_SKIP() << "Built with SIMEVO_PROFILING=OFF"
+#else
+#define SKIP_IF_COMPILED_OUT() ((void)0)
+#endif
+
+TEST(ProfilerTest, ZonesHaveDistinctNames) {
+    for (std::size_t a = 0; a < PROFILE_ZONE_COUNT; a++) {
+        for (std::size_t b = a + 1; b < PROFILE_ZONE_COUNT; b++) {
+            EXPECT_NE(std::string(profileZoneName(static_cast<ProfileZone>(a))),
+                      profileZoneName(static_cast<ProfileZone>(b)));
+        }
+    }
+}
+
+TEST(ProfilerTest, ScopesOnManyThreadsAreSummedAndOutliveTheirThreads) {
+    SKIP_IF_COMPILED_OUT();
+    ProfileSnapshot before = Profiler::snapshot();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10; i++) {
+                PROFILE_ZONE(REBUILD_INDEX);
+                spin(std::chrono::microseconds(200));
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    ProfileSnapshot delta = Profiler::snapshot() - before;
+
+    const ZoneTotals& totals = delta[ProfileZone::REBUILD_INDEX];
+    EXPECT_EQ(40u, totals.count);
+    // 40 scopes of at least 200 us each, measured in nanoseconds
+    EXPECT_GE(totals.ns, 40u * 190'000u);
+    EXPECT_GE(totals.maxNs, 190'000u);
+    EXPECT_LE(totals.maxNs, totals.ns);
+}
+
+TEST(ProfilerTest, SimulationPhasesAreRecordedAndNeverReset) {
+    SKIP_IF_COMPILED_OUT();
+    Environment env(200, 200);
+    env.add(std::make_shared<Organism>(), 100.0f, 100.0f);
+    env.add(std::make_shared<Food>(), 50.0f, 50.0f);
+
+    ProfileSnapshot before = Profiler::snapshot();
+    env.simulateIteration(5);
+    env.simulateIteration(5);
+    ProfileSnapshot delta = Profiler::snapshot() - before;
+
+    EXPECT_EQ(2u, delta[ProfileZone::SIMULATE_ITERATION].count);
+    EXPECT_EQ(10u, delta[ProfileZone::HANDLE_REACTIONS].count);
+    EXPECT_EQ(10u, delta[ProfileZone::UPDATE_INDEX].count);
+    EXPECT_EQ(2u, delta[ProfileZone::CLEAN_UP].count);
+    EXPECT_GE(delta[ProfileZone::SIMULATE_ITERATION].ns, delta[ProfileZone::POST_ITERATION].ns);
+}
+
+TEST(ProfilerTest, TraceBufferKeepsTheNewestSpans) {
+    TraceBuffer trace(3);
+    for (std::uint64_t i = 0; i < 5; i++) trace.push(ProfileZone::TICK, i * 10, i * 10 + 5);
+    auto spans = trace.spans();
+    ASSERT_EQ(3u, spans.size());
+    EXPECT_EQ(20u, spans.front().start);
+    EXPECT_EQ(45u, spans.back().end);
+    EXPECT_EQ(5u, trace.getRecorded());
+    EXPECT_EQ(Profiler::threadIndex(), spans.front().thread);
+    EXPECT_THROW(TraceBuffer(0), std::invalid_argument);
+}
+
+TEST(ProfilerTest, EnvironmentTraceCoversTicksPhasesAndWorkers) {
+    SKIP_IF_COMPILED_OUT();
+    Environment env(500, 500, "default", 2);
+    for (int i = 0; i < 20; i++) env.add(std::make_shared<Organism>(), 20.0f * i + 10, 250.0f);
+    env.add(std::make_shared<Food>(), 250.0f, 100.0f);
+    EXPECT_THROW(env.dumpTrace("unused.json"), std::runtime_error);
+
+    env.setTracing(1024);
+    env.simulateIteration(3, [](const Environment&) {});
+    std::size_t ticks = 0, workers = 0, callbacks = 0;
+    for (const TraceSpan& span : env.getTrace()->spans()) {
+        EXPECT_LE(span.start, span.end);
+        ticks += span.zone == ProfileZone::TICK;
+        callbacks += span.zone == ProfileZone::ON_EACH_ITERATION;
+        workers += span.zone == ProfileZone::REACTION_WORKER;
+    }
+    EXPECT_EQ(3u, ticks);
+    EXPECT_EQ(3u, callbacks);
+    EXPECT_EQ(6u, workers);  // Two workers per tick
+
+    std::ostringstream json;
+    env.getTrace()->writeChromeTrace(json);
+    EXPECT_NE(std::string::npos, json.str().find("\"name\":\"handleReactions\""));
+    EXPECT_NE(std::string::npos, json.str().find("\"ph\":\"X\""));
+
+    env.setTracing(0);
+    EXPECT_EQ(nullptr, env.getTrace());
+}
+
+TEST(ProfilerTest, LatencyHistogramQuantilesAreBoundedAndErrOnTheSlowSide) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(0u, histogram.quantileTicks(0.5));
+    for (std::uint64_t ticks = 1; ticks <= 1000; ticks++) histogram.record(ticks * 1000);
+    EXPECT_EQ(1000u, histogram.getCount());
+    EXPECT_EQ(1000000u, histogram.maxTicks());
+
+    for (double q : {0.5, 0.95, 0.99}) {
+        const double exact = q * 1000 * 1000;
+        EXPECT_GE(histogram.quantileTicks(q), exact);
+        EXPECT_LE(histogram.quantileTicks(q), exact * 1.25);
+    }
+    EXPECT_EQ(histogram.maxTicks(), histogram.quantileTicks(1.0));
+
+    histogram.clear();
+    EXPECT_EQ(0u, histogram.getCount());
+    EXPECT_EQ(0u, histogram.maxTicks());
+}
+
+TEST(ProfilerTest, EnvironmentProfileAccumulatesAcrossCalls) {
+    SKIP_IF_COMPILED_OUT();
+    Environment env(500, 500, "default", 2);
+    for (int i = 0; i < 10; i++) env.add(std::make_shared<Organism>(), 20.0f * i + 10, 250.0f);
+    env.add(std::make_shared<Food>(), 250.0f, 100.0f);
+
+    env.simulateIteration(3);
+    env.simulateIteration(2);
+    SimulationProfile profile = env.getProfile();
+    EXPECT_EQ(5u, profile.ticks);
+    // Each living organism queries once to interact and once to react per tick
+    EXPECT_EQ(profile.organismsInteracted + profile.organismsReacted, profile.queries);
+    EXPECT_EQ(50u, profile.organismsReacted);
+    std::uint64_t bucketed = 0;
+    for (auto count : profile.neighboursPerQuery) bucketed += count;
+    EXPECT_EQ(profile.queries, bucketed);
+    EXPECT_EQ(50u, profile.indexUpdates);
+
+    auto tick = std::find_if(profile.zones.begin(), profile.zones.end(),
+                             [](const ZoneProfile& zone) { return zone.name == "tick"; });
+    ASSERT_NE(profile.zones.end(), tick);
+    EXPECT_EQ(5u, tick->count);
+    EXPECT_LE(tick->p50Ms, tick->p99Ms);
+    EXPECT_LE(tick->p99Ms, tick->maxMs);
+    EXPECT_GT(tick->totalMs, 0.0);
+
+    // A clone starts with an empty profile; resetting zeroes this one
+    EXPECT_EQ(0u, env.clone()->getProfile().ticks);
+    env.resetProfile();
+    EXPECT_EQ(0u, env.getProfile().ticks);
+    EXPECT_TRUE(env.getProfile().zones.empty());
+}
+
+TEST(ProfilerTest, VerboseReportCoversOnlyThisEnvironmentsCall) {
+    SKIP_IF_COMPILED_OUT();
+    Environment env(100, 100), other(100, 100);
+    env.add(std::make_shared<Organism>(), 50.0f, 50.0f);
+    other.add(std::make_shared<Organism>(), 50.0f, 50.0f);
+    env.simulateIteration(2);
+
+    // Another environment ticking during the call stays out of the report
+    env.setVerbose(true);
+    testing::internal::CaptureStdout();
+    env.simulateIteration(3, [&](const Environment&) { other.simulateIteration(4); });
+    std::string output = testing::internal::GetCapturedStdout();
+    std::size_t tick = output.find("\ntick: ");
+    ASSERT_NE(std::string::npos, tick) << output;
+    std::string line = output.substr(tick + 1, output.find('\n', tick + 1) - tick - 1);
+    EXPECT_NE(std::string::npos, line.find(" ms total, 3 times, ")) << line;
+}
+
+TEST(ProfilerTest, StrategyCostsAreAttributedPerSpeciesAndCall) {
+    SKIP_IF_COMPILED_OUT();
+    Environment env(500, 500, "default", 2);
+    auto slow = std::make_shared<Organism::Policy>();
+    slow->reactionStrategy = [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        return std::make_pair(1.0f, 0.0f);
+    };
+    auto batched = std::make_shared<Organism::Policy>();
+    batched->batchReactionStrategy = [](const ReactionBatch&, std::vector<Vec2>&) {};
+    for (int i = 0; i < 4; i++) {
+        env.add(std::make_shared<Organism>(), 200.0f + 3 * i, 250.0f);
+        env.add(std::make_shared<Organism>(Genes("\x14\x14\x14\x14"), slow), 200.0f + 3 * i, 253.0f);
+        env.add(std::make_shared<Organism>(Genes("\x14\x14\x14\x14"), batched), 200.0f + 3 * i, 247.0f);
+    }
+
+    env.simulateIteration(3);
+    SimulationProfile profile = env.getProfile();
+    auto find = [&](Organism::SpeciesId species, StrategyCall call) {
+        auto it = std::find_if(profile.strategies.begin(), profile.strategies.end(),
+                               [&](const StrategyProfile& s) {
+                                   return s.species == species && s.call == call;
+                               });
+        EXPECT_NE(profile.strategies.end(), it);
+        return it == profile.strategies.end() ? StrategyProfile{} : *it;
+    };
+    Organism::SpeciesId slowSpecies = 0, batchedSpecies = 0;
+    for (const auto& organism : env.getAllOrganisms()) {
+        if (organism->getPolicy() == slow) slowSpecies = organism->getSpeciesId();
+        if (organism->getPolicy() == batched) batchedSpecies = organism->getSpeciesId();
+    }
+
+    StrategyProfile builtIn = find(SpeciesTable::DEFAULT_SPECIES, StrategyCall::REACTION);
+    StrategyProfile callback = find(slowSpecies, StrategyCall::REACTION);
+    StrategyProfile batch = find(batchedSpecies, StrategyCall::BATCH_REACTION);
+    EXPECT_EQ(StrategyImplementation::DEFAULT, builtIn.implementation);
+    EXPECT_EQ(StrategyImplementation::CALLBACK, callback.implementation);
+    EXPECT_EQ(StrategyImplementation::CALLBACK, batch.implementation);
+    EXPECT_EQ(12u, callback.calls);
+    EXPECT_GT(callback.neighbours, 0u);
+    EXPECT_EQ(3u, batch.calls);
+    EXPECT_GE(callback.totalMs, 12 * 0.2);
+    EXPECT_GT(callback.meanUs, builtIn.meanUs);
+    EXPECT_EQ(0.0, callback.gilWaitMs);
+
+    // Every species interacts through the default strategy
+    EXPECT_EQ(12u, find(slowSpecies, StrategyCall::INTERACTION).calls);
+}
+
+TEST(ProfilerTest, StrategyCostsSurviveSpeciesRenumbering) {
+    SKIP_IF_COMPILED_OUT();
+    Environment env(500, 500);
+    auto first = std::make_shared<Organism::Policy>();
+    first->reactionStrategy = [](Organism&, const std::vector<std::shared_ptr<EnvironmentObject>>&) {
+        return std::make_pair(1.0f, 0.0f);
+    };
+    auto second = std::make_shared<Organism::Policy>(*first);
+    std::vector<std::shared_ptr<Organism>> doomed;
+    for (int i = 0; i < 2; i++) {
+        doomed.push_back(std::make_shared<Organism>(Genes("\x14\x14\x14\x14"), first));
+        env.add(doomed.back(), 100.0f + 3 * i, 100.0f);
+    }
+    for (int i = 0; i < 5; i++) {
+        env.add(std::make_shared<Organism>(Genes("\x14\x14\x14\x14"), second), 100.0f + 3 * i,
+                300.0f);
+    }
+    env.simulateIteration(3);
+
+    // Clean-up compacts the species table: the second policy takes the first one's id
+    for (auto& organism : doomed) organism->killed();
+    env.simulateIteration(2);
+
+    SimulationProfile profile = env.getProfile();
+    const Organism::SpeciesId secondId = env.getAllOrganisms().front()->getSpeciesId();
+    std::uint64_t firstCalls = 0, secondCalls = 0;
+    for (const auto& strategy : profile.strategies) {
+        if (strategy.call != StrategyCall::REACTION) continue;
+        EXPECT_EQ(StrategyImplementation::CALLBACK, strategy.implementation);
+        if (strategy.hasSpecies) {
+            EXPECT_EQ(secondId, strategy.species);
+            secondCalls += strategy.calls;
+        } else {
+            firstCalls += strategy.calls;
+        }
+    }
+    EXPECT_EQ(2u * 3, firstCalls);
+    EXPECT_EQ(5u * 5, secondCalls);
+}
+
+TEST(ProfilerTest, GilWaitsAreChargedToTheRunningStrategy) {
+    SKIP_IF_COMPILED_OUT();
+    StrategyTally::addGilWait(100);  // Unbound: ignored
+    StrategyTally tally;
+    {
+        StrategyTally::Binding attributing(tally);
+        StrategyTally::addGilWait(100);  // No strategy running: ignored
+        StrategyScope attributed(2, StrategyCall::INTERACTION, 5);
+        StrategyTally::addGilWait(40);
+    }
+    EXPECT_EQ(nullptr, StrategyTally::current());
+
+    const auto& costs = tally.getCosts();
+    ASSERT_EQ(2 * STRATEGY_CALL_COUNT + 3, costs.size());
+    const StrategyCost& cost = costs[2 * STRATEGY_CALL_COUNT + 2];
+    EXPECT_EQ(1u, cost.calls);
+    EXPECT_EQ(5u, cost.neighbours);
+    EXPECT_EQ(40u, cost.gilTicks);
+}
+
+TEST(ProfilerTest, PerfReadingsKeepMissingEventsApart) {
+    PerfReading before, after;
+    before.values = {100, 300, 10, 1, 5};
+    before.validMask = 0b00111;
+    after.values = {300, 700, 40, 9, 9};
+    after.validMask = 0b10111;
+
+    PerfReading delta = after - before;
+    EXPECT_TRUE(delta.has(PerfEvent::CYCLES));
+    EXPECT_FALSE(delta.has(PerfEvent::BRANCH_MISSES));  // Missing from the start
+    EXPECT_EQ(200u, delta[PerfEvent::CYCLES]);
+    EXPECT_EQ(30u, delta[PerfEvent::L1D_MISSES]);
+    EXPECT_DOUBLE_EQ(2.0, delta.ipc());
+
+    PerfReading total;
+    EXPECT_TRUE(total.empty());
+    total += delta;
+    total += delta;
+    EXPECT_EQ(400u, total[PerfEvent::CYCLES]);
+    EXPECT_EQ(delta.validMask, total.validMask);
+
+    std::ostringstream report;
+    total.report(report);
+    EXPECT_NE(std::string::npos, report.str().find("cycles=400"));
+    EXPECT_NE(std::string::npos, report.str().find("branchMisses=n/a"));
+    EXPECT_NE(std::string::npos, report.str().find("ipc=2.00"));
+}
+
+TEST(ProfilerTest, HardwareCountersFallBackWhenUnavailable) {
+    PerfCounters counters;
+    PerfReading start = counters.read();
+    spin(std::chrono::microseconds(500));
+    PerfReading delta = counters.read() - start;
+    if (!counters.available()) {
+        EXPECT_FALSE(counters.getError().empty());
+        EXPECT_TRUE(delta.empty());
+    } else if (counters.has(PerfEvent::INSTRUCTIONS)) {
+        EXPECT_GT(delta[PerfEvent::INSTRUCTIONS], 0u);
+    }
+
+    // Environments run the same either way; phases carry counters only when available
+    Environment env(500, 500);
+    for (int i = 0; i < 10; i++) env.add(std::make_shared<Organism>(), 20.0f * i + 10, 250.0f);
+    bool available = env.setHardwareCounters(true);
+    EXPECT_EQ(counters.available(), available);
+    env.simulateIteration(3);
+    EXPECT_EQ(3u, env.getProfile().ticks);
+    for (const auto& zone : env.getProfile().zones) {
+        bool counted = zone.name == "handleInteractions" || zone.name == "handleReactions" ||
+                       zone.name == "postIteration" || zone.name == "cleanUp";
+        EXPECT_EQ(available && counted, !zone.counters.empty()) << zone.name;
+    }
+}
@@ -0,0 +1,108 @@
+#include <chrono>
+#include <core/Environment.hpp>
+#include <core/Food.hpp>
+#include <core/Organism.hpp>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utils/profiler.hpp>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static const int WORLD_SIZE = 1000;
+
+// Populate an environment with organisms and food that never starve, so every
+// tick exercises the full reaction phase.
+static void populate(Environment& env, int organismCount, int foodCount, std::mt19937& rng) {
+    std::uniform_real_distribution<float> posDist(0.0f, WORLD_SIZE - 1.0f);
+    std::uniform_int_distribution<int> geneDist(20, 120);
+    auto noCost = [](const Organism&) { return 0u; };
+
+    for (int i = 0; i < organismCount; i++) {
+        char dna[4] = {static_cast<char>(geneDist(rng)), static_cast<char>(geneDist(rng)),
+                       static_cast<char>(geneDist(rng)), 0};
+        env.add(std::make_shared<Organism>(Genes(dna), noCost), posDist(rng), posDist(rng));
+    }
+    for (int i = 0; i < foodCount; i++) {
+        env.add(std::make_shared<Food>(), posDist(rng), posDist(rng));
+    }
+}
+
+// Reference classifier matching the pre-tag implementation: one RTTI cast per
+// neighbour, each producing a temporary shared_ptr.
+static int classifyWithRtti(const std::vector<std::shared_ptr<EnvironmentObject>>& objects) {
+    int actionable = 0;
+    for (const auto& obj : objects) {
+        if (auto food = std::dynamic_pointer_cast<Food>(obj)) {
+            if (food->canBeEaten()) actionable++;
+        } else if (auto organism = std::dynamic_pointer_cast<Organism>(obj)) {
+            if (organism->isAlive()) actionable++;
+        }
+    }
+    return actionable;
+}
+
+static int classifyWithKindTag(const std::vector<std::shared_ptr<EnvironmentObject>>& objects) {
+    int actionable = 0;
+    for (const auto& obj : objects) {
+        if (obj->getKind() == ObjectKind::FOOD) {
+            if (obj->as<Food>()->canBeEaten()) actionable++;
+        } else if (obj->getKind() == ObjectKind::ORGANISM) {
+            if (obj->as<Organism>()->isAlive()) actionable++;
+        }
+    }
+    return actionable;
+}
+
+// Neighbour classification in isolation: RTTI casts vs the kind tag
+TEST(ReactionBenchmark, NeighbourClassification) {
+    const int N = 20000;
+    const int ROUNDS = 200;
+    std::vector<std::shared_ptr<EnvironmentObject>> objects;
+    objects.reserve(N);
+    for (int i = 0; i < N; i++) {
+        if (i % 2 == 0) {
+            objects.push_back(std::make_shared<Food>());
+        } else {
+            objects.push_back(std::make_shared<Organism>());
+        }
+    }
+
+    auto time = [&](auto classify) {
+        volatile int sink = 0;
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < ROUNDS; r++) {
+            sink = sink + classify(objects);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(t1 - t0).count();
+    };
+
+    ASSERT_EQ(classifyWithRtti(objects), classifyWithKindTag(objects));
+    double rttiMs = time(classifyWithRtti);
+    double tagMs = time(classifyWithKindTag);
+
+    printf("\n=== Classify %d neighbours x %d rounds ===\n", N, ROUNDS);
+    printf("RTTI:     %.2f ms\n", rttiMs);
+    printf("Kind tag: %.2f ms\n", tagMs);
+    printf("Speedup:  %.2fx\n", rttiMs / tagMs);
+}
+
+// Time spent in Environment::handleReactions across a short run
+TEST(ReactionBenchmark, ReactionPhase_2000organisms) {
+    const int TICKS = 20;
+    std::mt19937 rng(42);
+    Environment env(WORLD_SIZE, WORLD_SIZE, "optimized");
+    populate(env, 2000, 2000, rng);
+
+    ProfileSnapshot before = Profiler::snapshot();
+    env.simulateIteration(TICKS);
+    ProfileSnapshot run = Profiler::snapshot() - before;
+
+    double reactionMs = run[ProfileZone::HANDLE_REACTIONS].ms();
+    double interactionMs = run[ProfileZone::HANDLE_INTERACTIONS].ms();
+    printf("\n=== Reaction phase, 2000 organisms, 2000 food, %d ticks ===\n", TICKS);
+    printf("handleReactions:    %.2f ms (%.3f ms/tick)\n", reactionMs, reactionMs / TICKS);
+    printf("handleInteractions: %.2f ms (%.3f ms/tick)\n", interactionMs, interactionMs / TICKS);
+}
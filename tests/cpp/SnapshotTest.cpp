@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <core/Environment.hpp>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static std::unique_ptr<Environment> makeScenario() {
+    auto env = std::make_unique<Environment>(300, 200, "optimized");
+    env->setSeed(7);
+    for (int i = 0; i < 20; i++) {
+        env->add(std::make_shared<Organism>(), 10.0f + i * 13, 10.0f + i * 9);
+    }
+    env->distributeFood(FoodRegion{0, 0, 300, 200, 60}, 300);
+    env->simulateIteration(30);
+    return env;
+}
+
+// Per-object fingerprint that does not depend on map iteration order
+static std::vector<std::string> fingerprint(const Environment& env) {
+    std::vector<std::string> rows;
+    for (const auto& organism : env.getAllOrganisms()) {
+        auto pos = organism->getPos();
+        rows.push_back("o" + std::to_string(pos.x) + "," + std::to_string(pos.y) + "," +
+                       std::to_string(organism->getLifeSpan()) + "," +
+                       std::to_string(organism->getSpeed()));
+    }
+    for (const auto& food : env.getAllFoods()) {
+        auto pos = food->getPos();
+        rows.push_back("f" + std::to_string(pos.x) + "," + std::to_string(pos.y) + "," +
+                       std::to_string(food->getEnergy()) + "," +
+                       std::to_string(food->canBeEaten()));
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+TEST(SnapshotTest, RoundTripsObjectsCountersAndRng) {
+    auto env = makeScenario();
+    std::string bytes = env->encodeSnapshot();
+
+    Environment restored(1, 1);
+    restored.decodeSnapshot(bytes);
+    EXPECT_EQ(300, restored.getWidth());
+    EXPECT_EQ(200, restored.getHeight());
+    EXPECT_EQ(fingerprint(*env), fingerprint(restored));
+    EXPECT_EQ(env->getFoodConsumptionInIteration(), restored.getFoodConsumptionInIteration());
+    EXPECT_EQ(env->getDeadOrganisms().size(), restored.getDeadOrganisms().size());
+    EXPECT_EQ(env->getTickCount(), restored.getTickCount());
+    EXPECT_EQ(env->getStats().getOrganismCount(), restored.getStats().getOrganismCount());
+    EXPECT_DOUBLE_EQ(env->getStats().getMean(PopulationStats::SPEED),
+                     restored.getStats().getMean(PopulationStats::SPEED));
+
+    // Ids survive, and the restored index answers queries
+    auto organism = env->getAllOrganisms().front();
+    auto restoredObjects = restored.getAllObjects();
+    EXPECT_TRUE(std::any_of(restoredObjects.begin(), restoredObjects.end(),
+                            [&](const auto& object) { return object->getId() == organism->getId(); }));
+
+    // The food placement RNG continues where the original left off
+    env->removeAllFoods();
+    restored.removeAllFoods();
+    env->distributeFood(FoodRegion{0, 0, 300, 200, 10});
+    restored.distributeFood(FoodRegion{0, 0, 300, 200, 10});
+    EXPECT_EQ(fingerprint(*env), fingerprint(restored));
+    restored.simulateIteration(5);
+}
+
+TEST(SnapshotTest, FileRoundTripReattachesPolicies) {
+    Environment env(100, 100);
+    Organism::Policy custom;
+    custom.lifeConsumptionCalculator = [](const Organism&) { return 0u; };
+    auto policy = std::make_shared<const Organism::Policy>(std::move(custom));
+    auto organism = std::make_shared<Organism>(Genes("\x28\x28\x28\x00"), policy);
+    env.add(organism, 50.0f, 50.0f);
+    env.add(std::make_shared<Organism>(), 20.0f, 20.0f);
+    ASSERT_EQ(1, organism->getSpeciesId());
+
+    const std::string path = ::testing::TempDir() + "simevo_snapshot.bin";
+    env.saveSnapshot(path);
+
+    std::vector<std::shared_ptr<const Organism::Policy>> policies{nullptr, policy};
+    Environment restored(1, 1);
+    restored.loadSnapshot(path, policies);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(2u, restored.getAllOrganisms().size());
+    EXPECT_EQ(2u, restored.getSpeciesCount());
+    for (const auto& restoredOrganism : restored.getAllOrganisms()) {
+        bool isCustom = restoredOrganism->getId() == organism->getId();
+        EXPECT_EQ(isCustom ? policy : Organism::defaultPolicy(), restoredOrganism->getPolicy());
+    }
+}
+
+TEST(SnapshotTest, ReportsWhetherBehaviourSurvivesWithoutPolicies) {
+    Environment env(100, 100);
+    env.add(std::make_shared<Organism>(), 20.0f, 20.0f);
+    EXPECT_TRUE(env.isSnapshotSelfContained());
+
+    auto mutating = std::make_shared<Organism>(Genes("\x28\x28\x28\x00", [](char[4]) {}));
+    env.add(mutating, 30.0f, 30.0f);
+    EXPECT_FALSE(env.isSnapshotSelfContained());
+    env.remove(mutating);
+
+    Organism::Policy custom;
+    custom.lifeConsumptionCalculator = [](const Organism&) { return 0u; };
+    env.add(std::make_shared<Organism>(Genes("\x28\x28\x28\x00"),
+                                       std::make_shared<const Organism::Policy>(custom)),
+            40.0f, 40.0f);
+    EXPECT_FALSE(env.isSnapshotSelfContained());
+}
+
+TEST(SnapshotTest, RejectsInvalidInputWithoutChangingTheEnvironment) {
+    auto env = makeScenario();
+    std::string bytes = env->encodeSnapshot();
+
+    Environment target(50, 50);
+    target.add(std::make_shared<Food>(), 5.0f, 5.0f);
+    EXPECT_THROW(target.decodeSnapshot(std::span<const char>(bytes.data(), bytes.size() - 3)),
+                 std::runtime_error);
+    std::string badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_THROW(target.decodeSnapshot(badMagic), std::runtime_error);
+    std::string newerFormat = bytes;
+    newerFormat[8] = 99;
+    EXPECT_THROW(target.decodeSnapshot(newerFormat), std::runtime_error);
+    std::string noArea = bytes;
+    const std::int32_t zero = 0;
+    std::memcpy(&noArea[16], &zero, sizeof(zero));  // Width, after magic, version and BOM
+    EXPECT_THROW(target.decodeSnapshot(noArea), std::runtime_error);
+    EXPECT_EQ(50, target.getWidth());
+    EXPECT_EQ(1u, target.getAllFoods().size());
+
+    EXPECT_THROW(target.loadSnapshot(::testing::TempDir() + "missing.bin"), std::runtime_error);
+
+    target.add(std::make_shared<EnvironmentObject>(0.0f, 0.0f), 1.0f, 1.0f);
+    EXPECT_THROW(target.encodeSnapshot(), std::runtime_error);
+}
+
+TEST(SnapshotTest, RejectsPositionsOutsideTheWorldBeforeSwapping) {
+    Environment source(100, 100, "optimized");
+    source.add(std::make_shared<Food>(), 12.5f, 37.25f);
+    const std::string bytes = source.encodeSnapshot();
+    const float stored[2] = {12.5f, 37.25f};
+    const auto at = bytes.find(std::string(reinterpret_cast<const char*>(stored), sizeof(stored)));
+    ASSERT_NE(std::string::npos, at);
+
+    Environment target(50, 50, "optimized");
+    target.add(std::make_shared<Food>(), 5.0f, 5.0f);
+    for (float bad : {std::numeric_limits<float>::quiet_NaN(), 1e6f, -1.0f}) {
+        std::string corrupt = bytes;
+        std::memcpy(&corrupt[at], &bad, sizeof(bad));
+        EXPECT_THROW(target.decodeSnapshot(corrupt), std::runtime_error);
+    }
+    EXPECT_EQ(50, target.getWidth());
+    ASSERT_EQ(1u, target.getAllFoods().size());
+    EXPECT_EQ(5.0f, target.getAllFoods().front()->getPos().x);
+    EXPECT_NO_THROW(target.simulateIteration(1));
+}
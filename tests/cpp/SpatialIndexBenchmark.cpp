@@ -1,11 +1,17 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_hash.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <functional>
 #include <index/DefaultSpatialIndex.hpp>
 #include <index/OptimizedSpatialIndex.hpp>
+#include <memory>
 #include <random>
+#include <string>
+#include <utils/perf_counters.hpp>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -17,6 +23,11 @@ struct BenchmarkResult {
     double queryMs;
     double updateMs;
     double removeMs;
+    // Hardware counters per operation; empty when the system provides none
+    PerfReading insertCounters;
+    PerfReading queryCounters;
+    PerfReading updateCounters;
+    PerfReading removeCounters;
 };
 
 static const float WORLD_SIZE = 4000.0f;
@@ -46,13 +57,16 @@ BenchmarkResult runBenchmark(IndexFactory factory, int objectCount, int queryCou
     std::uniform_real_distribution<float> posDist(0.0f, WORLD_SIZE - 1.0f);
     std::uniform_real_distribution<float> moveDist(-5.0f, 5.0f);
     BenchmarkResult result{};
+    PerfCounters counters;
 
     // Benchmark insert
+    PerfReading c0 = counters.read();
     auto t0 = std::chrono::high_resolution_clock::now();
     for (auto& obj : objects) {
         index->insert(obj.id, obj.x, obj.y);
     }
     auto t1 = std::chrono::high_resolution_clock::now();
+    result.insertCounters = counters.read() - c0;
     result.insertMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
     // Benchmark query - simulate each organism querying its neighbors
@@ -62,6 +76,7 @@ BenchmarkResult runBenchmark(IndexFactory factory, int objectCount, int queryCou
         queryYs[i] = posDist(rng);
     }
 
+    c0 = counters.read();
     t0 = std::chrono::high_resolution_clock::now();
     volatile size_t totalResults = 0;  // prevent optimization
     for (int i = 0; i < queryCount; i++) {
@@ -69,9 +84,11 @@ BenchmarkResult runBenchmark(IndexFactory factory, int objectCount, int queryCou
         totalResults += results.size();
     }
     t1 = std::chrono::high_resolution_clock::now();
+    result.queryCounters = counters.read() - c0;
     result.queryMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
     // Benchmark update - simulate all organisms moving slightly each frame
+    c0 = counters.read();
     t0 = std::chrono::high_resolution_clock::now();
     for (auto& obj : objects) {
         float newX = std::max(0.0f, std::min(WORLD_SIZE - 1.0f, obj.x + moveDist(rng)));
@@ -81,19 +98,34 @@ BenchmarkResult runBenchmark(IndexFactory factory, int objectCount, int queryCou
         obj.y = newY;
     }
     t1 = std::chrono::high_resolution_clock::now();
+    result.updateCounters = counters.read() - c0;
     result.updateMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
     // Benchmark remove
+    c0 = counters.read();
     t0 = std::chrono::high_resolution_clock::now();
     for (auto& obj : objects) {
         index->remove(obj.id);
     }
     t1 = std::chrono::high_resolution_clock::now();
+    result.removeCounters = counters.read() - c0;
     result.removeMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
 
     return result;
 }
 
+// Hardware counters of one operation for both indexes, one row per event
+static void printCounters(const char* operation, const PerfReading& def, const PerfReading& opt) {
+    for (std::size_t e = 0; e < PERF_EVENT_COUNT; e++) {
+        const auto event = static_cast<PerfEvent>(e);
+        if (!def.has(event) || !opt.has(event)) continue;
+        printf("%-12s %-14s %14llu %14llu %10.2fx\n", operation, perfEventName(event),
+               static_cast<unsigned long long>(def[event]),
+               static_cast<unsigned long long>(opt[event]),
+               opt[event] ? static_cast<double>(def[event]) / static_cast<double>(opt[event]) : 0.0);
+    }
+}
+
 static void printComparison(const char* label, const BenchmarkResult& def,
                             const BenchmarkResult& opt) {
     printf("\n=== %s ===\n", label);
@@ -109,6 +141,18 @@ static void printComparison(const char* label, const BenchmarkResult& def,
     double defTotal = def.insertMs + def.queryMs + def.updateMs + def.removeMs;
     double optTotal = opt.insertMs + opt.queryMs + opt.updateMs + opt.removeMs;
     printf("%-12s %12.2f %12.2f %12.2fx\n", "TOTAL", defTotal, optTotal, defTotal / optTotal);
+
+    if (def.insertCounters.empty()) {
+        static bool noted = false;
+        if (!noted) printf("(hardware counters unavailable: %s)\n", PerfCounters().getError().c_str());
+        noted = true;
+        return;
+    }
+    printf("%-12s %-14s %14s %14s %11s\n", "Operation", "Counter", "Default", "Optimized", "Ratio");
+    printCounters("Insert", def.insertCounters, opt.insertCounters);
+    printCounters("Query", def.queryCounters, opt.queryCounters);
+    printCounters("Update", def.updateCounters, opt.updateCounters);
+    printCounters("Remove", def.removeCounters, opt.removeCounters);
 }
 
 // Small scale: 200 objects, typical organism awareness range
@@ -211,3 +255,232 @@ TEST(SpatialIndexBenchmark, SimulateFrame_1000objects) {
     printf("Optimized: %.2f ms\n", optMs);
     printf("Speedup:   %.2fx\n", defMs / optMs);
 }
+
+// ── Scenario workloads ──────────────────────────────────────────────────
+//
+// Uniform positions flatter the quadtree: every leaf holds a few objects and
+// every query touches a few leaves. Real worlds have dense oases, crowds
+// converging on one food patch, objects clamped against the boundary, and
+// food added and removed every generation. Each scenario below replays the
+// same frames (move everything, query around everything, churn) on every
+// backend, so the matrix compares them on identical work.
+
+enum class Scenario { UNIFORM, CLUSTERED, CONVERGING, BOUNDARY, CHURN };
+
+static const Scenario SCENARIOS[] = {Scenario::UNIFORM, Scenario::CLUSTERED, Scenario::CONVERGING,
+                                     Scenario::BOUNDARY, Scenario::CHURN};
+
+static const char* scenarioName(Scenario scenario) {
+    switch (scenario) {
+        case Scenario::UNIFORM: return "uniform";
+        case Scenario::CLUSTERED: return "clustered";
+        case Scenario::CONVERGING: return "converging";
+        case Scenario::BOUNDARY: return "boundary";
+        case Scenario::CHURN: return "churn";
+    }
+    return "unknown";
+}
+
+using Index = ISpatialIndex<uuids::uuid>;
+
+struct Backend {
+    const char* name;
+    std::function<std::unique_ptr<Index>()> make;
+};
+
+// Every index implementation; add new backends here to include them in the matrix
+static std::vector<Backend> allBackends() {
+    return {
+        {"Default", []() { return std::make_unique<DefaultSpatialIndex<uuids::uuid>>(); }},
+        {"Optimized",
+         []() { return std::make_unique<OptimizedSpatialIndex<uuids::uuid>>(WORLD_SIZE); }},
+    };
+}
+
+static float clampToWorld(float v) { return std::max(0.0f, std::min(WORLD_SIZE - 1.0f, v)); }
+
+// Gaussian blobs like oases: most objects within a few query ranges of a centre
+static std::vector<ObjectEntry> generateClustered(int n, std::mt19937& rng) {
+    const int BLOBS = 8;
+    std::uniform_real_distribution<float> centre(0.1f * WORLD_SIZE, 0.9f * WORLD_SIZE);
+    std::vector<std::pair<float, float>> centres;
+    for (int b = 0; b < BLOBS; b++) centres.emplace_back(centre(rng), centre(rng));
+    std::normal_distribution<float> spread(0.0f, WORLD_SIZE / 40.0f);
+    uuids::random_generator gen;
+    std::vector<ObjectEntry> objects;
+    objects.reserve(n);
+    for (int i = 0; i < n; i++) {
+        auto [cx, cy] = centres[i % BLOBS];
+        objects.push_back({gen(), clampToWorld(cx + spread(rng)), clampToWorld(cy + spread(rng))});
+    }
+    return objects;
+}
+
+// Objects within a few units of an edge, a quarter exactly on it, as
+// updatePositionsInSpatialIndex leaves organisms that walk into a wall
+static std::vector<ObjectEntry> generateBoundary(int n, std::mt19937& rng) {
+    std::uniform_real_distribution<float> along(0.0f, WORLD_SIZE - 1.0f);
+    std::uniform_real_distribution<float> depth(0.0f, 20.0f);
+    uuids::random_generator gen;
+    std::vector<ObjectEntry> objects;
+    objects.reserve(n);
+    for (int i = 0; i < n; i++) {
+        float inset = i % 4 == 0 ? 0.0f : depth(rng);
+        float a = along(rng);
+        switch (i % 4) {
+            case 0: objects.push_back({gen(), a, i % 8 == 0 ? 0.0f : WORLD_SIZE - 1.0f}); break;
+            case 1: objects.push_back({gen(), inset, a}); break;
+            case 2: objects.push_back({gen(), WORLD_SIZE - 1.0f - inset, a}); break;
+            default: objects.push_back({gen(), a, inset}); break;
+        }
+    }
+    return objects;
+}
+
+static std::vector<ObjectEntry> generateScenario(Scenario scenario, int n, std::mt19937& rng) {
+    switch (scenario) {
+        case Scenario::CLUSTERED: return generateClustered(n, rng);
+        case Scenario::BOUNDARY: return generateBoundary(n, rng);
+        default: return generateObjects(n, rng);
+    }
+}
+
+// One frame of movement: a small jitter, except that converging objects
+// cover a quarter of their remaining distance to a single food patch, so the
+// crowd there grows denser every frame, and boundary objects are pushed
+// outwards and clamped back onto the edge
+static void moveObject(Scenario scenario, ObjectEntry& obj, std::mt19937& rng) {
+    std::uniform_real_distribution<float> jitter(-5.0f, 5.0f);
+    float x = obj.x + jitter(rng), y = obj.y + jitter(rng);
+    if (scenario == Scenario::CONVERGING) {
+        const float target = WORLD_SIZE * 0.6f;
+        float dx = target - obj.x, dy = target - obj.y;
+        if (dx * dx + dy * dy > 1.0f) {
+            x = obj.x + dx * 0.25f + jitter(rng) * 0.2f;
+            y = obj.y + dy * 0.25f + jitter(rng) * 0.2f;
+        }
+    } else if (scenario == Scenario::BOUNDARY) {
+        x += obj.x < WORLD_SIZE / 2 ? -3.0f : 3.0f;
+        y += obj.y < WORLD_SIZE / 2 ? -3.0f : 3.0f;
+    }
+    obj.x = clampToWorld(x);
+    obj.y = clampToWorld(y);
+}
+
+struct ScenarioResult {
+    double insertMs = 0;
+    double updateMs = 0;
+    double queryMs = 0;
+    double churnMs = 0;         // Removing and adding a tenth of the objects per frame
+    std::size_t neighbours = 0;  // Total query results, identical across correct backends
+    std::size_t queries = 0;
+    std::size_t firstFrameNeighbours = 0;
+    std::size_t lastFrameNeighbours = 0;
+    PerfReading counters;        // Whole run; empty when the system provides none
+
+    double totalMs() const { return insertMs + updateMs + queryMs + churnMs; }
+};
+
+static double millisBetween(std::chrono::steady_clock::time_point a,
+                            std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double, std::milli>(b - a).count();
+}
+
+static ScenarioResult runScenario(const Backend& backend, Scenario scenario,
+                                  const std::vector<ObjectEntry>& initial, int frames,
+                                  float range) {
+    ScenarioResult result;
+    auto objects = initial;
+    auto index = backend.make();
+    std::mt19937 rng(123);  // Same frames for every backend
+    uuids::random_generator gen;
+    std::uniform_real_distribution<float> posDist(0.0f, WORLD_SIZE - 1.0f);
+    PerfCounters counters;
+    PerfReading start = counters.read();
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (const auto& obj : objects) index->insert(obj.id, obj.x, obj.y);
+    auto t1 = std::chrono::steady_clock::now();
+    result.insertMs = millisBetween(t0, t1);
+
+    for (int frame = 0; frame < frames; frame++) {
+        t0 = std::chrono::steady_clock::now();
+        for (auto& obj : objects) {
+            moveObject(scenario, obj, rng);
+            index->update(obj.id, obj.x, obj.y);
+        }
+        t1 = std::chrono::steady_clock::now();
+        result.updateMs += millisBetween(t0, t1);
+
+        std::size_t found = 0;
+        t0 = std::chrono::steady_clock::now();
+        for (const auto& obj : objects) found += index->query(obj.x, obj.y, range).size();
+        t1 = std::chrono::steady_clock::now();
+        result.queryMs += millisBetween(t0, t1);
+        result.queries += objects.size();
+        result.neighbours += found;
+        if (frame == 0) result.firstFrameNeighbours = found;
+        result.lastFrameNeighbours = found;
+
+        if (scenario == Scenario::CHURN) {
+            t0 = std::chrono::steady_clock::now();
+            for (std::size_t i = frame % 10; i < objects.size(); i += 10) {
+                index->remove(objects[i].id);
+                objects[i] = {gen(), posDist(rng), posDist(rng)};
+                index->insert(objects[i].id, objects[i].x, objects[i].y);
+            }
+            t1 = std::chrono::steady_clock::now();
+            result.churnMs += millisBetween(t0, t1);
+        }
+    }
+    result.counters = counters.read() - start;
+    return result;
+}
+
+// Run every scenario on every backend and print the comparison matrix
+static void runScenarioMatrix(int n, int frames, float range) {
+    auto backends = allBackends();
+    printf("\n=== Scenario matrix: %d objects, %d frames, range=%.0f ===\n", n, frames, range);
+    printf("%-11s %-10s %9s %9s %9s %9s %10s %8s %12s %12s\n", "Scenario", "Backend",
+           "Insert", "Update", "Query", "Churn", "Total(ms)", "Nbrs/q", "L1dMisses", "LLCMisses");
+
+    std::vector<std::vector<double>> totals;
+    for (Scenario scenario : SCENARIOS) {
+        std::mt19937 rng(42);
+        auto initial = generateScenario(scenario, n, rng);
+        totals.emplace_back();
+        std::size_t expectedNeighbours = 0;
+        for (std::size_t b = 0; b < backends.size(); b++) {
+            ScenarioResult r = runScenario(backends[b], scenario, initial, frames, range);
+            auto counter = [&](PerfEvent event) {
+                return r.counters.has(event) ? std::to_string(r.counters[event]) : "n/a";
+            };
+            printf("%-11s %-10s %9.2f %9.2f %9.2f %9.2f %10.2f %8.1f %12s %12s\n",
+                   scenarioName(scenario), backends[b].name, r.insertMs, r.updateMs, r.queryMs,
+                   r.churnMs, r.totalMs(), static_cast<double>(r.neighbours) / r.queries,
+                   counter(PerfEvent::L1D_MISSES).c_str(), counter(PerfEvent::LLC_MISSES).c_str());
+            totals.back().push_back(r.totalMs());
+
+            // Backends must agree on what every query found
+            if (b == 0) expectedNeighbours = r.neighbours;
+            EXPECT_EQ(expectedNeighbours, r.neighbours)
+                << backends[b].name << " disagrees on " << scenarioName(scenario);
+            // The crowd must really form, or the scenario measures nothing new
+            if (scenario == Scenario::CONVERGING) {
+                EXPECT_GT(r.lastFrameNeighbours, 20 * r.firstFrameNeighbours);
+            }
+        }
+    }
+
+    // Speedup of every backend over the first, per scenario
+    printf("\n%-11s", "Speedup");
+    for (const auto& backend : backends) printf(" %10s", backend.name);
+    printf("\n");
+    for (std::size_t s = 0; s < totals.size(); s++) {
+        printf("%-11s", scenarioName(SCENARIOS[s]));
+        for (double total : totals[s]) printf(" %9.2fx", totals[s][0] / total);
+        printf("\n");
+    }
+}
+
+TEST(SpatialIndexBenchmark, ScenarioMatrix_2000objects) { runScenarioMatrix(2000, 10, 50.0f); }
@@ -0,0 +1,134 @@
+#include <core/Environment.hpp>
+#include <core/TrajectoryRecorder.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+// Minimal decoder for the per-frame columns of every chunk
+struct DecodedFile {
+    TrajectoryRecorder::FileHeader header;
+    std::vector<std::uint64_t> ticks;
+    std::vector<std::uint32_t> organisms, introduced, foodAdded, foodRemoved, births, deaths,
+        eaten;
+    std::vector<float> firstFrameXs;
+    std::size_t chunks = 0;
+};
+
+template <typename T>
+void readColumn(const char*& cursor, std::size_t count, std::vector<T>& out) {
+    const T* begin = reinterpret_cast<const T*>(cursor);
+    out.insert(out.end(), begin, begin + count);
+    cursor += count * sizeof(T);
+}
+
+DecodedFile decode(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    DecodedFile file;
+    std::memcpy(&file.header, bytes.data(), sizeof(file.header));
+    std::size_t offset = sizeof(file.header);
+    while (offset < bytes.size()) {
+        TrajectoryRecorder::ChunkHeader chunk;
+        std::memcpy(&chunk, bytes.data() + offset, sizeof(chunk));
+        EXPECT_EQ(0, std::memcmp(chunk.magic, "CHNK", 4));
+        const char* cursor = bytes.data() + offset + sizeof(chunk);
+        readColumn(cursor, chunk.frames, file.ticks);
+        for (auto* column : {&file.organisms, &file.introduced, &file.foodAdded,
+                             &file.foodRemoved, &file.births, &file.deaths, &file.eaten}) {
+            readColumn(cursor, chunk.frames, *column);
+        }
+        if (file.chunks == 0) {
+            cursor += chunk.organismRows * sizeof(std::uint32_t);
+            readColumn(cursor, file.organisms.front(), file.firstFrameXs);
+        }
+        offset += sizeof(chunk) + chunk.payloadBytes;
+        file.chunks++;
+    }
+    EXPECT_EQ(bytes.size(), offset);
+    return file;
+}
+
+}  // namespace
+
+TEST(TrajectoryRecorderTest, RecordsSampledFramesWithDeltaEncodedStaticData) {
+    const std::string path = ::testing::TempDir() + "simevo_trajectory.bin";
+    Environment env(1000, 1000);
+    auto hungry = std::make_shared<Organism>(Genes("\x04\x28\x04\x00"));
+    env.add(hungry, 100.0f, 100.0f);
+    env.add(std::make_shared<Organism>(Genes("\x04\x28\x04\x00")), 900.0f, 900.0f);
+    env.add(std::make_shared<Food>(), 105.0f, 100.0f);
+    env.add(std::make_shared<Food>(), 500.0f, 500.0f);
+
+    auto recorder = std::make_shared<TrajectoryRecorder>(path, 1000.0f, 1000.0f, 2, 3, 1);
+    env.setRecorder(recorder);
+    env.simulateIteration(10);
+    env.add(std::make_shared<Organism>(), 300.0f, 300.0f);
+    env.simulateIteration(4);
+    recorder->close();
+    EXPECT_THROW(recorder->capture(env, 16), std::runtime_error);
+
+    auto file = decode(path);
+    std::remove(path.c_str());
+    EXPECT_EQ(2u, file.header.interval);
+    EXPECT_EQ(3u, file.header.chunkFrames);
+    ASSERT_EQ(7u, file.ticks.size());
+    EXPECT_EQ(3u, file.chunks);
+    EXPECT_EQ(2u, file.ticks.front());
+    EXPECT_EQ(14u, file.ticks.back());
+    EXPECT_EQ(7u, recorder->getFrameCount());
+
+    // The nearby food is eaten in the first tick; the other stays put
+    EXPECT_EQ(1u, file.foodAdded[0]);
+    EXPECT_EQ(0u, file.foodAdded[1]);
+    EXPECT_EQ(2u, file.introduced[0]);
+    EXPECT_EQ(0u, file.introduced[1]);
+    // Keyframes re-introduce everything so each chunk decodes on its own
+    EXPECT_EQ(2u, file.introduced[3]);
+    EXPECT_EQ(1u, file.foodAdded[3]);
+    // The organism added between runs is a birth
+    EXPECT_EQ(1u, file.births[5]);
+    EXPECT_EQ(3u, file.organisms[5]);
+    EXPECT_EQ(1u, file.introduced[5]);
+    ASSERT_EQ(2u, file.firstFrameXs.size());
+}
+
+TEST(TrajectoryRecorderTest, ReportsEatenAndRemovedFood) {
+    const std::string path = ::testing::TempDir() + "simevo_trajectory_food.bin";
+    Environment env(1000, 1000);
+    env.add(std::make_shared<Organism>(Genes("\x04\x28\x04\x00")), 100.0f, 100.0f);
+    auto eaten = std::make_shared<Food>();
+    auto removed = std::make_shared<Food>();
+    env.add(eaten, 500.0f, 500.0f);
+    env.add(removed, 600.0f, 600.0f);
+    auto recorder = std::make_shared<TrajectoryRecorder>(path, 1000.0f, 1000.0f);
+    env.setRecorder(recorder);
+    env.simulateIteration(1);
+    eaten->eaten();
+    env.remove(removed);
+    env.simulateIteration(1);
+    env.setRecorder(nullptr);
+    recorder->close();
+
+    auto file = decode(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(2u, file.ticks.size());
+    EXPECT_EQ(2u, file.foodAdded[0]);
+    EXPECT_EQ(0u, file.foodAdded[1]);
+    EXPECT_EQ(2u, file.foodRemoved[1]);
+    EXPECT_EQ(1u, file.eaten[1]);
+    EXPECT_EQ(0u, file.deaths[1]);
+}
+
+TEST(TrajectoryRecorderTest, RejectsInvalidConfiguration) {
+    EXPECT_THROW(TrajectoryRecorder(::testing::TempDir() + "x.bin", 1, 1, 0), std::invalid_argument);
+    EXPECT_THROW(TrajectoryRecorder("/nonexistent/dir/x.bin", 1, 1), std::runtime_error);
+}
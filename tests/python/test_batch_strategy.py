@@ -0,0 +1,48 @@
+import numpy as np
+import pytest
+from simevopy import Environment, Genes, Organism, Policy
+
+def no_life_cost(organism):
+    return 0
+
+class MoveRight:
+    def __init__(self):
+        self.calls = 0
+        self.sizes = []
+
+    def __call__(self, batch):
+        self.calls += 1
+        self.sizes.append(len(batch["positions"]))
+        assert batch["neighbour_offsets"].shape == (len(batch["positions"]) + 1,)
+        return np.tile(np.array([[1.0, 0.0]], dtype=np.float32), (len(batch["positions"]), 1))
+
+@pytest.fixture
+def setup_environment():
+    env = Environment(1000, 1000)
+    strategy = MoveRight()
+    policy = Policy(life_consumption=no_life_cost, batch_reaction=strategy)
+    dna = chr(40) * 4
+    for i in range(10):
+        env.add_organism(Organism(Genes(dna), policy), 100, 100 + i * 50)
+    return env, strategy
+
+def test_batch_strategy_called_once_per_tick(setup_environment):
+    env, strategy = setup_environment
+    env.simulate_iteration(5)
+    assert strategy.calls == 5, "Batch strategy should run once per tick per species"
+    assert strategy.sizes == [10] * 5
+
+def test_batch_strategy_moves_organisms(setup_environment):
+    env, _ = setup_environment
+    env.simulate_iteration(5)
+    for org in env.get_all_organisms():
+        assert org.get_position()[0] > 100, "Organisms should have moved right"
+
+def test_batch_strategy_rejects_wrong_shape():
+    env = Environment(1000, 1000)
+    policy = Policy(life_consumption=no_life_cost,
+                    batch_reaction=lambda batch: np.zeros((1, 3), dtype=np.float32))
+    env.add_organism(Organism(Genes(chr(40) * 4), policy), 100, 100)
+    env.add_organism(Organism(Genes(chr(40) * 4), policy), 200, 100)
+    with pytest.raises(RuntimeError):
+        env.simulate_iteration(1)
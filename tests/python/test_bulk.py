@@ -0,0 +1,42 @@
+import numpy as np
+import pytest
+from simevopy import Environment, ObjectKind, Policy
+
+def test_add_foods_from_numpy():
+    env = Environment(1000, 1000)
+    xs = np.linspace(10, 990, 400, dtype=np.float32)
+    ys = np.full(400, 500, dtype=np.float32)
+    env.add_foods(xs, ys, energies=np.arange(400, dtype=np.int32))
+    foods = env.get_all_foods()
+    assert len(foods) == 400
+    assert sum(f.get_energy() for f in foods) == sum(range(400))
+
+def test_add_foods_rejects_out_of_bounds_atomically():
+    env = Environment(100, 100)
+    with pytest.raises(RuntimeError):
+        env.add_foods(np.array([10.0, 500.0]), np.array([10.0, 10.0]))
+    assert len(env.get_all_foods()) == 0
+
+def test_add_organisms_from_dna_rows():
+    env = Environment(1000, 1000)
+    dna = np.array([[40, 40, 40, 0], [80, 20, 60, 0]], dtype=np.uint8)
+    policy = Policy(life_consumption=lambda organism: 0)
+    env.add_organisms(dna, np.array([100, 200]), np.array([100, 200]), policy=policy)
+    speeds = sorted(org.get_speed() for org in env.get_all_organisms())
+    assert speeds == [10.0, 20.0]
+    assert env.get_species_count() == 2
+
+def test_remove_all_foods_and_remove_where():
+    env = Environment(1000, 1000)
+    env.add_foods(np.array([10.0, 20.0, 30.0]), np.array([10.0, 20.0, 30.0]))
+    env.add_organisms(np.full((3, 4), 40, dtype=np.uint8),
+                      np.array([100.0, 500.0, 900.0]), np.array([500.0, 500.0, 500.0]))
+
+    env.remove_all_foods()
+    assert len(env.get_all_foods()) == 0
+
+    removed = env.remove_where(kind=ObjectKind.ORGANISM,
+                               predicate=lambda obj: obj.get_position()[0] > 400)
+    assert removed == 2
+    assert len(env.get_all_organisms()) == 1
+    assert env.remove_where(kind=ObjectKind.ORGANISM) == 1
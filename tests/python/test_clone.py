@@ -0,0 +1,29 @@
+import copy
+
+from simevopy import Environment, Food, Organism
+
+def build_env():
+    env = Environment(500, 500, "optimized")
+    for i in range(10):
+        env.add_organism(Organism(), 20 + i * 40, 20 + i * 30)
+    for i in range(40):
+        env.add_food(Food(), 10 + i * 11, 10 + i * 12)
+    env.simulate_iteration(5)
+    return env
+
+def test_clone_matches_then_diverges():
+    env = build_env()
+    fork = env.clone()
+    assert sorted(o.get_position() for o in fork.get_all_organisms()) == \
+        sorted(o.get_position() for o in env.get_all_organisms())
+    assert fork.get_tick_count() == env.get_tick_count()
+
+    fork.simulate_iteration(20)
+    assert fork.get_tick_count() == env.get_tick_count() + 20
+    assert len(env.get_all_organisms()) == 10
+
+def test_deepcopy_uses_clone():
+    env = build_env()
+    fork = copy.deepcopy(env)
+    fork.remove_all_foods()
+    assert len(env.get_all_foods()) > 0
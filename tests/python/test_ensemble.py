@@ -0,0 +1,33 @@
+from simevopy import EnsembleRunner, Environment, Food, Genes, Organism
+
+def make_scenario(organisms, foods):
+    env = Environment(500, 500)
+    for i in range(organisms):
+        env.add_organism(Organism(Genes(chr(20) * 4)), 10 + (i * 37) % 480, 10 + (i * 91) % 480)
+    for i in range(foods):
+        env.add_food(Food(), 10 + (i * 53) % 480, 10 + (i * 17) % 480)
+    return env
+
+def test_ensemble_runs_all_environments():
+    runner = EnsembleRunner(threads=2)
+    for replicate in range(4):
+        assert runner.add(make_scenario(20, 50)) == replicate
+    assert len(runner) == 4
+
+    summaries = runner.run(30)
+    assert len(summaries) == 4
+    for index, summary in enumerate(summaries):
+        env = runner.get(index)
+        assert summary.organisms == len(env.get_all_organisms())
+        assert summary.organisms + summary.dead_organisms == 20
+        assert summary.food_consumption == env.get_food_consumption_in_iteration()
+        assert summary.elapsed_ms >= 0
+
+def test_ensemble_accepts_python_strategies():
+    env = make_scenario(5, 5)
+    for org in env.get_all_organisms():
+        org.set_reaction_strategy(lambda organism, nearby: (1.0, 0.0))
+    runner = EnsembleRunner(threads=2)
+    runner.add(env)
+    runner.add(make_scenario(5, 5))
+    assert len(runner.run(5)) == 2
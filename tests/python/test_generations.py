@@ -0,0 +1,24 @@
+from simevopy import Environment, FoodRegion, Genes, GenerationPolicy, Organism
+
+def test_simulate_generations_spawns_and_resets_food():
+    env = Environment(1000, 1000)
+    env.set_seed(7)
+    for i in range(10):
+        env.add_organism(Organism(Genes(chr(40) * 4)), 100 + i * 80, 500)
+
+    policy = GenerationPolicy(food_regions=[FoodRegion(0, 0, 1000, 1000, 100)])
+    seen = []
+    env.simulate_generations(3, 20, policy,
+                             on_each_generation=lambda e, gen: seen.append(gen))
+
+    assert seen == [0, 1, 2]
+    assert len(env.get_all_foods()) == 0
+
+def test_distribute_food_in_region():
+    env = Environment(1000, 1000)
+    env.distribute_food(FoodRegion(100, 100, 200, 200, 25))
+    foods = env.get_all_foods()
+    assert len(foods) == 25
+    for food in foods:
+        x, y = food.get_position()
+        assert 100 <= x < 200 and 100 <= y < 200
@@ -0,0 +1,38 @@
+import threading
+
+from simevopy import Environment, Food, Genes, Organism
+
+def populate(env, count=500):
+    for i in range(count):
+        env.add_organism(Organism(Genes(chr(40) * 4)), (i * 37) % 1000, (i * 91) % 1000)
+        env.add_food(Food(), (i * 53) % 1000, (i * 17) % 1000)
+
+def test_default_environment_releases_gil():
+    env = Environment(1000, 1000)
+    populate(env)
+    assert not env.requires_gil()
+
+    ticks = []
+    env.simulate_iteration(5, lambda e: ticks.append(len(e.get_all_organisms())))
+    assert len(ticks) == 5
+
+def test_python_strategy_keeps_gil():
+    env = Environment(1000, 1000)
+    org = Organism(Genes(chr(40) * 4))
+    org.set_reaction_strategy(lambda organism, nearby: (1.0, 0.0))
+    env.add_organism(org, 500, 500)
+    assert env.requires_gil()
+    env.simulate_iteration(3)
+
+def test_environments_run_concurrently():
+    envs = [Environment(1000, 1000) for _ in range(4)]
+    for env in envs:
+        populate(env)
+
+    threads = [threading.Thread(target=env.simulate_iteration, args=(20,)) for env in envs]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    assert all(env.get_food_consumption_in_iteration() > 0 for env in envs)
@@ -0,0 +1,33 @@
+import os
+import sys
+
+from simevopy import Environment, Food, LiveFeed, Organism
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "..", "examples"))
+from utils.live_feed import LiveFeedReader  # noqa: E402
+
+def test_reader_samples_latest_publication():
+    env = Environment(500, 500)
+    for i in range(5):
+        env.add_organism(Organism(), 50 + i * 80, 100)
+    for i in range(3):
+        env.add_food(Food(), 450, 100 + i * 100)
+
+    feed = LiveFeed(f"simevo_pytest_{os.getpid()}", organism_capacity=4, food_capacity=8,
+                    interval=2)
+    env.set_live_feed(feed)
+    with LiveFeedReader(feed.get_name()) as reader:
+        assert reader.sample() is None
+        env.simulate_iteration(5)
+        assert reader.published == feed.get_published_count() == 2
+
+        sample = reader.sample()
+        assert sample["tick"] == 4
+        assert sample["organisms"] == 5
+        assert len(sample["x"]) == 4  # Truncated to the capacity
+        assert len(sample["food_x"]) == sample["foods"]
+        assert sample["width"] == 500
+
+        env.simulate_iteration(2)
+        assert reader.sample()["tick"] == 6
+    env.set_live_feed(None)
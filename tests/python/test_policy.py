@@ -0,0 +1,46 @@
+import pytest
+from simevopy import Environment, Genes, Organism, Policy
+
+def no_life_cost(organism):
+    return 0
+
+def flee_right(organism, nearby_objects):
+    return (1.0, 0.0)
+
+@pytest.fixture
+def setup_environment():
+    env = Environment(1000, 1000)
+    policy = Policy(life_consumption=no_life_cost, reaction=flee_right)
+    dna = chr(40) * 4
+    for i in range(5):
+        env.add_organism(Organism(Genes(dna), policy), 100 + i * 10, 500)
+    return env
+
+def test_shared_policy_is_one_species(setup_environment):
+    env = setup_environment
+    # The default policy always occupies one slot
+    assert env.get_species_count() == 2, "Organisms sharing a Policy should form one species"
+
+    species_ids = {org.get_species_id() for org in env.get_all_organisms()}
+    assert len(species_ids) == 1
+
+def test_offspring_inherit_policy(setup_environment):
+    env = setup_environment
+    parent = env.get_all_organisms()[0]
+    child = parent.reproduce()
+    assert child.has_custom_strategy()
+    assert child.get_species_id() == parent.get_species_id()
+
+    env.add_organism(child, 700, 700)
+    assert env.get_species_count() == 2
+
+    env.simulate_iteration(10)
+    assert all(org.is_alive() for org in env.get_all_organisms())
+
+def test_one_life_consumption_callable_is_one_species():
+    env = Environment(1000, 1000)
+    for i in range(5):
+        env.add_organism(Organism(Genes(chr(40) * 4), no_life_cost), 100 + i * 10, 500)
+    assert env.get_species_count() == 2
+    species_ids = {org.get_species_id() for org in env.get_all_organisms()}
+    assert len(species_ids) == 1
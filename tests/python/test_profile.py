@@ -0,0 +1,65 @@
+from simevopy import Environment, Food, Organism
+
+
+def test_profile_accumulates_across_calls_until_reset():
+    env = Environment(500, 500, threads=2)
+    for i in range(10):
+        env.add_organism(Organism(), 10 + i * 20, 250)
+    env.add_food(Food(), 250, 100)
+
+    env.simulate_iteration(3)
+    env.simulate_iteration(2, on_each_iteration=lambda e: None)
+    profile = env.get_profile()
+    assert profile["ticks"] == 5
+    assert profile["organisms_reacted"] == 50
+    assert profile["queries"] == profile["organisms_interacted"] + profile["organisms_reacted"]
+    assert profile["neighbours_per_query"].sum() == profile["queries"]
+
+    tick = profile["zones"]["tick"]
+    assert tick["count"] == 5
+    assert tick["p50_ms"] <= tick["p95_ms"] <= tick["p99_ms"] <= tick["max_ms"]
+    assert profile["zones"]["onEachIteration"]["count"] == 2
+
+    env.reset_profile()
+    profile = env.get_profile()
+    assert profile["ticks"] == 0
+    assert profile["zones"] == {}
+
+
+def test_profile_attributes_cost_to_each_strategy():
+    env = Environment(500, 500)
+    calls = []
+
+    def chase(organism, neighbours):
+        calls.append(len(neighbours))
+        return (1.0, 0.0)
+
+    for i in range(4):
+        env.add_organism(Organism(), 200 + 3 * i, 250)
+        custom = Organism()
+        custom.set_reaction_strategy(chase)
+        env.add_organism(custom, 200 + 3 * i, 253)
+    env.simulate_iteration(2)
+
+    # One callable set on four organisms is one species and one profile entry
+    reactions = [s for s in env.get_profile()["strategies"] if s["call"] == "reaction"]
+    assert [s["species"] for s in reactions if s["implementation"] == "default"] == [0]
+    python = [s for s in reactions if s["implementation"] == "callback"]
+    assert len(python) == 1
+    assert python[0]["species"] == custom.get_species_id() != 0
+    assert python[0]["calls"] == len(calls)
+    assert python[0]["neighbours"] == sum(calls)
+    assert python[0]["total_ms"] > 0
+
+
+def test_hardware_counters_are_optional():
+    env = Environment(500, 500)
+    for i in range(10):
+        env.add_organism(Organism(), 10 + i * 20, 250)
+    available = env.set_hardware_counters(True)
+    env.simulate_iteration(2)
+    zones = env.get_profile()["zones"]
+    assert ("counters" in zones["handleReactions"]) == available
+    if available:
+        assert set(zones["handleReactions"]["counters"]) <= {
+            "cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses"}
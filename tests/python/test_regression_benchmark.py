@@ -0,0 +1,50 @@
+import importlib.util
+import json
+import pathlib
+
+import pytest
+
+SCRIPT = pathlib.Path(__file__).resolve().parents[2] / "examples" / "regression_benchmark.py"
+spec = importlib.util.spec_from_file_location("regression_benchmark", SCRIPT)
+regression_benchmark = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(regression_benchmark)
+
+
+def test_significant_drop_is_a_regression():
+    result = regression_benchmark.compare_samples([100, 102, 98, 101, 99], [80, 81, 79, 82, 78],
+                                                  threshold=0.05)
+    assert result["verdict"] == "regression"
+    assert result["change"] == pytest.approx(-0.2)
+    assert result["ci_low"] < result["change"] < result["ci_high"] < 0
+
+
+def test_noise_does_not_fail():
+    # A 10% lower mean whose interval still spans zero
+    result = regression_benchmark.compare_samples([100, 140, 60, 120, 80], [90, 130, 50, 110, 70],
+                                                  threshold=0.05)
+    assert result["verdict"] == "noisy"
+    assert result["ci_low"] < 0 < result["ci_high"]
+
+    within = regression_benchmark.compare_samples([100, 101, 99], [98, 99, 97], threshold=0.05)
+    assert within["verdict"] == "unchanged"
+
+    faster = regression_benchmark.compare_samples([100, 101, 99], [120, 121, 119], threshold=0.05)
+    assert faster["verdict"] == "improvement"
+
+
+def test_compare_exits_nonzero_on_regression(tmp_path, capsys):
+    def results(scale):
+        return {"cpp_args": regression_benchmark.CPP_ARGS, "machine": {"host": "test"},
+                "scenarios": {"cpp/a": {"unit": "x", "samples": [scale * s for s in (10, 11, 9)]},
+                              "cpp/b": {"unit": "x", "samples": [10, 11, 9]}}}
+
+    baseline, current = tmp_path / "baseline.json", tmp_path / "current.json"
+    baseline.write_text(json.dumps(results(1.0)))
+    current.write_text(json.dumps(results(0.5)))
+
+    assert regression_benchmark.main(["compare", str(baseline), "--results", str(current)]) == 1
+    output = capsys.readouterr().out
+    assert "cpp/a" in output and "regression" in output
+
+    current.write_text(json.dumps(results(1.0)))
+    assert regression_benchmark.main(["compare", str(baseline), "--results", str(current)]) == 0
@@ -0,0 +1,35 @@
+import numpy as np
+import pytest
+
+from simevopy import Environment, Food, Organism, RenderLayer
+
+def build_env():
+    env = Environment(400, 400)
+    env.add_organism(Organism(), 200, 200)
+    env.add_food(Food(), 40, 360)
+    env.add_food(Food(), 44, 364)
+    return env
+
+def test_render_returns_float_planes():
+    env = build_env()
+    image = env.render(40, 20, [RenderLayer.ORGANISMS, RenderLayer.FOOD, RenderLayer.AWARENESS])
+    assert image.shape == (3, 20, 40)
+    assert image.dtype == np.float32
+    assert image[0].sum() == 1 and image[0, 10, 20] == 1
+    assert image[1, 18, 4] == 2
+    assert image[2].sum() > 1
+
+def test_render_rgba_and_threads():
+    env = build_env()
+    layers = [RenderLayer.ORGANISMS, RenderLayer.FOOD, RenderLayer.SIZE]
+    assert np.array_equal(env.render(64, 64, layers), env.render(64, 64, layers, threads=0))
+    rgba = env.render(64, 64, layers, rgba=True)
+    assert rgba.shape == (64, 64, 4) and rgba.dtype == np.uint8
+    assert rgba[..., 3].max() == 255
+
+def test_render_rejects_bad_arguments():
+    env = build_env()
+    with pytest.raises(ValueError):
+        env.render(0, 10)
+    with pytest.raises(ValueError):
+        env.render(10, 10, [])
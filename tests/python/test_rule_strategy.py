@@ -0,0 +1,24 @@
+import pytest
+from simevopy import Environment, Food, Genes, ObjectKind, Organism, Policy, Rule, RuleBasedStrategy
+
+def seek_food():
+    return RuleBasedStrategy([Rule(target=ObjectKind.FOOD, weight=1, consume=True)])
+
+def test_rules_do_not_require_gil():
+    org = Organism(Genes(chr(40) * 4))
+    org.set_rule_based_strategy(seek_food())
+    assert org.has_custom_strategy()
+    assert not org.requires_gil()
+
+def test_rule_organism_eats_food():
+    env = Environment(1000, 1000, threads=2)
+    policy = Policy(rules=seek_food())
+    env.add_organism(Organism(Genes(chr(40) * 4), policy), 500, 500)
+    env.add_food(Food(), 520, 500)
+
+    env.simulate_iteration(10)
+    assert env.get_food_consumption_in_iteration() == 1
+
+def test_invalid_rule_rejected():
+    with pytest.raises(ValueError):
+        RuleBasedStrategy([Rule(min_size_ratio=2, max_size_ratio=1)])
@@ -0,0 +1,61 @@
+import multiprocessing
+import pickle
+
+import pytest
+from simevopy import Environment, Food, Genes, Organism, Policy
+
+def build_env():
+    env = Environment(300, 200, "optimized")
+    env.set_seed(3)
+    for i in range(10):
+        env.add_organism(Organism(), 10 + i * 20, 10 + i * 15)
+    for i in range(30):
+        env.add_food(Food(250), 5 + i * 9, 5 + i * 6)
+    env.simulate_iteration(10)
+    return env
+
+def summary(env):
+    organisms = sorted((o.get_position(), o.get_life_span()) for o in env.get_all_organisms())
+    foods = sorted(f.get_position() for f in env.get_all_foods())
+    return organisms, foods, env.get_food_consumption_in_iteration()
+
+def count_organisms(env):
+    return len(env.get_all_organisms())
+
+def test_pickle_round_trip():
+    env = build_env()
+    restored = pickle.loads(pickle.dumps(env))
+    assert restored.get_width() == 300
+    assert summary(restored) == summary(env)
+    assert restored.get_tick_count() == env.get_tick_count()
+
+def test_pickle_refuses_behaviour_it_cannot_restore():
+    env = build_env()
+    env.add_organism(Organism(Genes(chr(40) * 4), Policy(life_consumption=lambda o: 0)), 50, 50)
+    with pytest.raises(TypeError):
+        pickle.dumps(env)
+
+def test_environments_travel_to_worker_processes():
+    envs = [build_env() for _ in range(2)]
+    with multiprocessing.get_context("spawn").Pool(2) as pool:
+        assert pool.map(count_organisms, envs) == [count_organisms(e) for e in envs]
+
+def test_snapshot_file_reattaches_policies(tmp_path):
+    env = Environment(100, 100)
+    policy = Policy(life_consumption=lambda organism: 0)
+    organism = Organism(Genes(chr(40) * 4), policy)
+    env.add_organism(organism, 50, 50)
+    path = str(tmp_path / "run.snapshot")
+    env.save_snapshot(path)
+
+    restored = Environment(1, 1)
+    restored.load_snapshot(path, policies=[None, policy])
+    restored.simulate_iteration(5)
+    assert restored.get_all_organisms()[0].get_life_span() == 500
+
+def test_invalid_snapshot_raises(tmp_path):
+    path = tmp_path / "bad.snapshot"
+    path.write_bytes(b"not a snapshot")
+    env = Environment(10, 10)
+    with pytest.raises(RuntimeError):
+        env.load_snapshot(str(path))
@@ -0,0 +1,35 @@
+import numpy as np
+import pytest
+from simevopy import Environment, Food, Genes, ObjectKind, Organism
+
+@pytest.fixture
+def env():
+    env = Environment(1000, 1000)
+    env.add_organism(Organism(Genes(chr(40) + chr(80) + chr(200) + chr(0))), 100, 200)
+    env.add_organism(Organism(Genes(chr(40) * 4)), 300, 400)
+    env.add_food(Food(250), 10, 20)
+    return env
+
+def test_state_columns(env):
+    state = env.state()
+    assert state["organism_count"] == 2
+    assert state["food_count"] == 1
+    n = state["organism_count"]
+    assert np.all(state["kind"][:n] == int(ObjectKind.ORGANISM))
+    assert sorted(state["size"][:n]) == [10.0, 20.0]
+    assert state["energy"][n] == 250
+    assert state["positions"].shape == (3, 2)
+    np.testing.assert_array_equal(state["traits"][:, 1], state["size"])
+
+def test_state_is_read_only_and_cached(env):
+    state = env.state()
+    with pytest.raises(ValueError):
+        state["life_span"][0] = 1
+    assert env.state()["version"] == state["version"]
+
+def test_state_views_survive_mutation(env):
+    positions = env.state()["positions"]
+    before = positions.copy()
+    env.simulate_iteration(5)
+    del env
+    np.testing.assert_array_equal(positions, before)
@@ -0,0 +1,38 @@
+import numpy as np
+import pytest
+from simevopy import Environment, Food, Genes, Organism
+
+@pytest.fixture
+def env():
+    env = Environment(1000, 1000)
+    env.add_organism(Organism(Genes(chr(40) + chr(80) + chr(200) + chr(0))), 100, 200)
+    env.add_organism(Organism(Genes(chr(120) + chr(40) + chr(40) + chr(0))), 800, 800)
+    env.add_food(Food(250), 400, 400)
+    return env
+
+def test_stats_track_population(env):
+    stats = env.stats()
+    assert stats["organisms"] == 2
+    assert stats["foods"] == 1
+    assert stats["mean"]["speed"] == pytest.approx(20.0)
+    assert stats["variance"]["speed"] == pytest.approx(100.0)
+    assert stats["histograms"].shape == (3, 32)
+    assert stats["histograms"].sum(axis=1).tolist() == [2, 2, 2]
+    assert len(stats["bin_edges"]) == 33
+
+def test_stats_follow_removal(env):
+    env.remove_organism(env.get_all_organisms()[0])
+    stats = env.stats()
+    assert stats["organisms"] == 1
+    assert stats["variance"]["size"] == 0.0
+
+def test_history_records_each_tick(env):
+    env.set_history_capacity(5)
+    env.simulate_iteration(8)
+    history = env.history()
+    np.testing.assert_array_equal(history["tick"], [4, 5, 6, 7, 8])
+    assert history["organisms"][0] == 2
+    assert history["mean_speed"][0] == pytest.approx(20.0)
+    assert env.get_tick_count() == 8
+    with pytest.raises(ValueError):
+        env.set_history_capacity(0)
@@ -0,0 +1,29 @@
+import json
+
+import pytest
+from simevopy import Environment, Food, Organism
+
+def test_dump_trace_writes_chrome_trace_events(tmp_path):
+    env = Environment(500, 500, threads=2)
+    for i in range(20):
+        env.add_organism(Organism(), 10 + i * 20, 250)
+    env.add_food(Food(), 250, 100)
+    with pytest.raises(RuntimeError):
+        env.dump_trace(str(tmp_path / "off.json"))
+
+    env.set_tracing(4096)
+    assert env.is_tracing()
+    env.simulate_iteration(3, on_each_iteration=lambda e: None)
+    path = tmp_path / "trace.json"
+    env.dump_trace(str(path))
+
+    events = json.loads(path.read_text())["traceEvents"]
+    spans = [e for e in events if e["ph"] == "X"]
+    names = {e["name"] for e in spans}
+    assert {"tick", "handleInteractions", "handleReactions", "postIteration",
+            "onEachIteration", "gilWait"} <= names
+    assert sum(e["name"] == "tick" for e in spans) == 3
+    assert all(e["dur"] >= 0 for e in spans)
+
+    env.set_tracing(0)
+    assert not env.is_tracing()
@@ -0,0 +1,41 @@
+import os
+import sys
+
+import numpy as np
+import pytest
+from simevopy import Environment, FoodRegion, Organism, TrajectoryRecorder
+
+sys.path.insert(0, os.path.join(os.path.dirname(__file__), "..", "..", "examples"))
+from utils.trajectory import TrajectoryReader  # noqa: E402
+
+def test_recording_round_trip(tmp_path):
+    path = str(tmp_path / "run.trajectory")
+    env = Environment(500, 500)
+    env.set_seed(1)
+    for i in range(20):
+        env.add_organism(Organism(), 10 + i * 20, 15 + i * 20)
+    env.distribute_food(FoodRegion(0, 0, 500, 500, 100))
+
+    with TrajectoryRecorder(path, 500, 500, interval=3, chunk_frames=4) as recorder:
+        env.set_recorder(recorder)
+        env.simulate_iteration(30)
+        env.set_recorder(None)
+    assert recorder.get_frame_count() == 10
+
+    reader = TrajectoryReader(path)
+    assert len(reader) == 10
+    np.testing.assert_array_equal(reader.ticks, np.arange(3, 31, 3))
+    last = reader.frame(9)
+    assert len(last["ids"]) == len([o for o in env.get_all_organisms() if o.is_alive()])
+    assert len(last["food_positions"]) == len([f for f in env.get_all_foods() if f.can_be_eaten()])
+    assert np.all(last["speed"] == 5.0)
+    assert [f["tick"] for f in reader] == list(range(3, 31, 3))
+
+def test_closed_recorder_rejects_frames(tmp_path):
+    env = Environment(100, 100)
+    env.add_organism(Organism(), 50, 50)
+    recorder = TrajectoryRecorder(str(tmp_path / "x.trajectory"), 100, 100)
+    env.set_recorder(recorder)
+    recorder.close()
+    with pytest.raises(RuntimeError):
+        env.simulate_iteration(1)